@@ -369,7 +369,9 @@ syn keyword luaFunc storepush_video_context
 syn keyword luaFunc accept_target
 syn keyword luaFunc random_surface
 syn keyword luaFunc rendertarget_noclear
+syn keyword luaFunc rendertarget_statesort
 syn keyword luaFunc switch_default_texfilter
+syn keyword luaFunc switch_default_atlas
 syn keyword luaFunc copy_surface_properties
 syn keyword luaFunc copy_image_transform
 syn keyword luaFunc video_synchronization
@@ -552,6 +554,8 @@ syn keyword luaFunc color_surface
 syn keyword luaFunc reset_target
 syn keyword luaFunc build_3dplane
 syn keyword luaFunc benchmark_timestamp
+syn keyword luaFunc benchmark_trace
+syn keyword luaFunc benchmark_trace_export
 syn keyword luaFunc target_flags
 syn keyword luaFunc play_audio
 syn keyword luaFunc system_load
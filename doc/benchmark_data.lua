@@ -1,7 +1,14 @@
 -- benchmark_data
 -- @short: Retrieve gathered benchmarking values.
--- @outargs: nticks, tickcosttbl, framecount, frametimetbl, costcount, framecosttbl
+-- @outargs: nticks, tickcosttbl, framecount, frametimetbl, costcount, framecosttbl, gctbl
+-- @longdescr: The *gctbl* table describes the incremental garbage collection
+-- that the engine performs in idle periods, e.g. while waiting for the
+-- display. It has the fields: steps (number of stepping passes), cycles
+-- (completed collection cycles), forced (passes that had to run outside
+-- of idle periods because the heap grew too fast), last, max and total
+-- (time spent collecting, in microseconds) and heap (current Lua heap
+-- size, in kilobytes). Apart from heap, the values are reset by
+-- ref:benchmark_enable.
 -- @group: system
 -- @cfunction: getbenchvals
 -- @related: benchmark_enable, benchmark_timestamp
-
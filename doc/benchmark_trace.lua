@@ -0,0 +1,30 @@
+-- benchmark_trace
+-- @short: Start or stop recording the frame timing trace.
+-- @inargs: *nentries*
+-- @outargs: bool
+-- @longdescr: The frame timing trace records the time spent in each stage
+-- of the main loop (preframe waiting, event drain, Lua callbacks, scene
+-- refresh, display synch, client buffer uploads and transfers, client
+-- wakeup and garbage collection) with microsecond resolution, tagged with the frame number and
+-- the active synchronization strategy. The records go into a ring buffer
+-- of *nentries* (default 4096) entries; the oldest entries are overwritten
+-- once it is full. Calling the function again resets the buffer. Setting
+-- *nentries* to 0 or false stops recording and drops the buffer.
+-- The return value is false if the buffer could not be allocated.
+-- @note: Tracing can also be enabled from the start by setting the
+-- ARCAN_CONDUCTOR_TRACE environment variable to a file name. The trace
+-- is written there when the engine shuts down, as CSV if the name ends
+-- with .csv, otherwise in the chrome tracing JSON format.
+-- @group: system
+-- @cfunction: benchtrace
+-- @related: benchmark_trace_export, benchmark_data
+function main()
+#ifdef MAIN
+	benchmark_trace(8192);
+	timer_add_periodic("dump", 500, true, function()
+		zap_resource("trace.json");
+		benchmark_trace_export("trace.json", "chrome");
+		benchmark_trace(false);
+	end);
+#endif
+end
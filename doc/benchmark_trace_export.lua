@@ -0,0 +1,31 @@
+-- benchmark_trace_export
+-- @short: Write the frame timing trace to a file.
+-- @inargs: outres, *format*
+-- @outargs: bool
+-- @longdescr: Writes the current contents of the frame timing trace
+-- (see ref:benchmark_trace) to *outres* in the appl temp namespace.
+-- *format* can be "chrome" (default), which writes JSON that can be
+-- loaded in chrome://tracing or similar viewers, or "csv", which writes
+-- one line per record with the columns frame, stage, ident, start_us,
+-- duration_us and synch. The ident column holds the video object of the
+-- client for transfer records and the number of frames for upload
+-- records; it is -1 otherwise.
+-- @note: refuses to overwrite outres if it exists.
+-- @note: returns false if no trace is being recorded or the file
+-- could not be opened.
+-- @group: system
+-- @cfunction: benchtraceexport
+-- @related: benchmark_trace
+function main()
+#ifdef MAIN
+	benchmark_trace();
+	timer_add_periodic("dump", 200, true, function()
+		zap_resource("trace.csv");
+		benchmark_trace_export("trace.csv", "csv");
+	end);
+#endif
+
+#ifdef ERROR1
+	benchmark_trace_export("trace.bin", "binary");
+#endif
+end
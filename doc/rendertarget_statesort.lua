@@ -0,0 +1,36 @@
+-- rendertarget_statesort
+-- @short: Group same-order objects by render state when attaching.
+-- @inargs: vid
+-- @inargs: vid, sort
+-- @outargs: success
+-- @longdescr: Objects with the same order value are normally drawn in the
+-- order they were attached to a rendertarget. With state sorting enabled,
+-- objects that are attached or reordered later will instead be placed next
+-- to an object with the same order value that uses the same storage and
+-- shader. This lets the engine submit them with fewer state changes and as
+-- longer batches, at the cost of the attachment order no longer working as
+-- a tie-breaker between overlapping objects. The *sort* argument defaults
+-- to true.
+-- @note: Setting WORLDID as vid will change the behavior for the standard
+-- output rendertarget.
+-- @note: Objects that are already attached keep their position until they
+-- are reordered or reattached.
+-- @group: targetcontrol
+-- @cfunction: renderstatesort
+function main()
+#ifdef MAIN
+	rendertarget_statesort(WORLDID, true);
+	local icon = fill_surface(32, 32, 255, 0, 0);
+	for i=1,100 do
+		local a = null_surface(32, 32);
+		image_sharestorage(icon, a);
+		order_image(a, 2);
+		move_image(a, math.random(VRESW - 32), math.random(VRESH - 32));
+		show_image(a);
+	end
+#endif
+
+#ifdef ERROR
+	rendertarget_statesort(BADID);
+#endif
+end
@@ -0,0 +1,29 @@
+-- switch_default_atlas
+-- @short: Pack small static images into shared texture pages.
+-- @inargs: *enable*
+-- @longdescr: When enabled (default off), newly created images from
+-- ref:load_image, ref:fill_surface, ref:raw_surface and new ref:render_text
+-- objects that are small (up to 256x256), use clamped texture coordinates,
+-- no or linear filtering and the default shader will have their contents
+-- packed into a shared texture page instead of getting a texture of their own.
+-- This reduces the number of texture switches and lets the renderer merge
+-- draw calls for icons, labels and other decorations.
+-- The packing is transparent: any operation that needs exclusive control of
+-- the store, e.g. changing texture coordinates, filtering, shader, readback
+-- or using the object as a rendertarget or frame, moves the object back
+-- into a store of its own first.
+-- @note: Asynchronously loaded images are never packed.
+-- @note: The setting does not affect already existing objects.
+-- @group: vidsys
+-- @cfunction: setdefatlas
+function main()
+#ifdef MAIN
+	switch_default_atlas(true);
+	for i=1,16 do
+		local a = fill_surface(32, 32, i * 16, 0, 0);
+		move_image(a, i * 34, 0);
+		show_image(a);
+	end
+	switch_default_atlas(false);
+#endif
+end
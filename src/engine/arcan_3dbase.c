@@ -349,7 +349,7 @@ static arcan_vobject_litem* process_scene_infinite(
 		max = rtgt->max_order;
 	}
 
-	while (current){
+	while (current->elem){
 		arcan_vobject* cvo = current->elem;
 
 		arcan_3dmodel* obj3d = cvo->feed.state.ptr;
@@ -359,7 +359,7 @@ static arcan_vobject_litem* process_scene_infinite(
 
 		ssize_t abs_o = cvo->order * -1;
 		if (abs_o < min){
-			current = current->next;
+			current++;
 			continue;
 		}
 
@@ -372,7 +372,7 @@ static arcan_vobject_litem* process_scene_infinite(
 		rendermodel(cvo, obj3d, cvo->program,
 				dprops, modelview, flags | MESH_FACING_NODEPTH);
 
-		current = current->next;
+		current++;
 	}
 
 	return current;
@@ -389,7 +389,7 @@ static void process_scene_normal(arcan_vobject_litem* cell,
 		max = rtgt->max_order;
 	}
 
-	while (current){
+	while (current->elem){
 		arcan_vobject* cvo = current->elem;
 
 /* non-negative => 2D part of the pipeline, there's nothing
@@ -399,7 +399,7 @@ static void process_scene_normal(arcan_vobject_litem* cell,
 
 		ssize_t abs_o = cvo->order * -1;
 		if (abs_o < min){
-			current = current->next;
+			current++;
 			continue;
 		}
 
@@ -409,12 +409,12 @@ static void process_scene_normal(arcan_vobject_litem* cell,
 		surface_properties dprops;
 		arcan_3dmodel* model = cvo->feed.state.ptr;
 		if (model->vrref)
-			dprops = cvo->current;
+			dprops = cvo->hot->current;
 		else
 			arcan_resolve_vidprop(cvo, lerp, &dprops);
 		rendermodel(cvo, model, cvo->program, dprops, modelview, flags);
 
-		current = current->next;
+		current++;
 	}
 }
 
@@ -479,7 +479,7 @@ bool arcan_3d_obj_bb_intersect(arcan_vobj_id cam,
 	float d1, d2;
 
 	return ray_sphere(&ray_pos, &ray_dir,
-		&model->current.position, rad, &d1, &d2);
+		&model->hot->current.position, rad, &d1, &d2);
 }
 
 /* Chained to the video-pass in arcan_video, stop at the
@@ -505,7 +505,7 @@ arcan_vobject_litem* arcan_3d_refresh(arcan_vobj_id camtag,
 	surface_properties dprop;
 	arcan_resolve_vidprop(camobj, fract, &dprop);
 	if (camera->vrref){
-		dprop.rotation = camobj->current.rotation;
+		dprop.rotation = camobj->hot->current.rotation;
 	}
 
 	agp_shader_activate(agp_default_shader(BASIC_3D));
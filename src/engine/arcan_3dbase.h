@@ -14,7 +14,8 @@ struct arcan_vobject_litem;
 
 /*
  * Process the scene according to the perspective defined in [camtag],
- * starting at [cell] with the interpolation factor of [frag](EPSILON..1.0)
+ * starting at [cell] with the interpolation factor of [frag](EPSILON..1.0),
+ * [cell] points into a rendertarget pipeline (terminated by a NULL elem)
  */
 struct arcan_vobject_litem* arcan_3d_refresh(
 	arcan_vobj_id camtag, struct arcan_vobject_litem* cell, float frag);
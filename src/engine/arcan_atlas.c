@@ -0,0 +1,479 @@
+/*
+ * Copyright 2026, arcan contributors
+ * License: 3-Clause BSD, see COPYING file in arcan source repository.
+ * Reference: http://arcan-fe.com
+ */
+
+/*
+ * Texture atlas for small, static images. Instead of each icon or label
+ * getting its own texture, the pixels are packed into shared pages and the
+ * object samples its region through its texture coordinates. This keeps the
+ * number of textures (and the state changes between them) down and lets the
+ * 2D batching in process_rendertarget merge otherwise unrelated objects.
+ *
+ * Packing uses shelves: rows with a fixed height that are filled left to
+ * right. Released regions are counted per shelf and a shelf that runs empty
+ * is reused from the start, trailing empty shelves are returned to the page
+ * and a page without any regions left is dropped.
+ *
+ * Objects that need exclusive control over their store (resize, readback,
+ * custom mapping, frameserver feeds, ...) are moved back out of the atlas
+ * through arcan_vint_atlas_release before the operation is performed.
+ */
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <stddef.h>
+
+#include "arcan_math.h"
+#include "arcan_general.h"
+#include "arcan_video.h"
+#include "arcan_videoint.h"
+
+#ifndef ATLAS_PAGE_SIZE
+#define ATLAS_PAGE_SIZE 1024
+#endif
+
+#ifndef ATLAS_PAGE_LIMIT
+#define ATLAS_PAGE_LIMIT 32
+#endif
+
+/* larger than this and the texture switch is amortized anyway */
+#ifndef ATLAS_SLOT_LIMIT
+#define ATLAS_SLOT_LIMIT 256
+#endif
+
+#define ATLAS_SHELF_LIMIT (ATLAS_PAGE_SIZE / 4)
+
+/* border of repeated edge pixels so linear filtering won't bleed */
+#define ATLAS_PAD 1
+
+struct atlas_shelf {
+	size_t y, h, x;
+	size_t used;
+};
+
+struct atlas_page {
+	struct agp_vstore* store;
+	unsigned context;
+
+/* [dirty] needs the full page (first use, context restore), otherwise only
+ * the region covered by inserts since the last flush goes up */
+	bool dirty;
+	bool damaged;
+	size_t dx1, dy1, dx2, dy2;
+
+	size_t n_slots;
+	size_t n_shelves;
+	struct atlas_shelf shelves[ATLAS_SHELF_LIMIT];
+};
+
+struct arcan_atlas_slot {
+	struct atlas_page* page;
+	size_t shelf;
+
+/* the object store as it was before being packed, contents dropped but
+ * kept for its metadata (source, density, modes) until released */
+	struct agp_vstore* orig;
+
+	size_t x, y, w, h;
+	size_t refc;
+};
+
+static struct atlas_page* pages[ATLAS_PAGE_LIMIT];
+
+static struct atlas_page* new_page(enum arcan_vfilter_mode filter, unsigned ctx)
+{
+	size_t ind = 0;
+	for (; ind < ATLAS_PAGE_LIMIT && pages[ind]; ind++){}
+
+	if (ind == ATLAS_PAGE_LIMIT)
+		return NULL;
+
+	struct atlas_page* page = arcan_alloc_mem(sizeof(struct atlas_page),
+		ARCAN_MEM_VSTRUCT, ARCAN_MEM_BZERO | ARCAN_MEM_NONFATAL,
+		ARCAN_MEMALIGN_NATURAL);
+	if (!page)
+		return NULL;
+
+	struct agp_vstore* store = arcan_alloc_mem(sizeof(struct agp_vstore),
+		ARCAN_MEM_VSTRUCT, ARCAN_MEM_BZERO | ARCAN_MEM_NONFATAL,
+		ARCAN_MEMALIGN_NATURAL);
+
+	size_t sz = ATLAS_PAGE_SIZE * ATLAS_PAGE_SIZE * sizeof(av_pixel);
+	av_pixel* raw = arcan_alloc_mem(sz, ARCAN_MEM_VBUFFER,
+		ARCAN_MEM_BZERO | ARCAN_MEM_NONFATAL, ARCAN_MEMALIGN_PAGE);
+
+	if (!store || !raw){
+		arcan_mem_free(page);
+		arcan_mem_free(store);
+		arcan_mem_free(raw);
+		return NULL;
+	}
+
+	store->refcount = 1;
+	store->txmapped = TXSTATE_TEX2D;
+	store->w = ATLAS_PAGE_SIZE;
+	store->h = ATLAS_PAGE_SIZE;
+	store->bpp = sizeof(av_pixel);
+	store->txu = ARCAN_VTEX_CLAMP;
+	store->txv = ARCAN_VTEX_CLAMP;
+	store->scale = ARCAN_VIMAGE_NOPOW2;
+	store->filtermode = filter;
+	store->vinf.text.raw = raw;
+	store->vinf.text.s_raw = sz;
+
+	page->store = store;
+	page->context = ctx;
+	page->dirty = true;
+	pages[ind] = page;
+
+	return page;
+}
+
+static void drop_page(struct atlas_page* page)
+{
+	for (size_t i = 0; i < ATLAS_PAGE_LIMIT; i++)
+		if (pages[i] == page){
+			pages[i] = NULL;
+			break;
+		}
+
+/* objects still referencing the store keep it alive until they are gone */
+	arcan_vint_drop_vstore(page->store);
+	arcan_mem_free(page);
+}
+
+static bool page_alloc(struct atlas_page* page,
+	size_t w, size_t h, size_t* shelf, size_t* x, size_t* y)
+{
+	struct atlas_shelf* best = NULL;
+
+/* tightest fitting shelf with room left, within reason height wise */
+	for (size_t i = 0; i < page->n_shelves; i++){
+		struct atlas_shelf* cur = &page->shelves[i];
+		if (cur->h < h || cur->h > h + (h >> 1) + 4 ||
+			cur->x + w > ATLAS_PAGE_SIZE)
+			continue;
+
+		if (!best || cur->h < best->h)
+			best = cur;
+	}
+
+/* open a new shelf at the end */
+	if (!best && page->n_shelves < ATLAS_SHELF_LIMIT){
+		size_t next = page->n_shelves ?
+			page->shelves[page->n_shelves-1].y +
+			page->shelves[page->n_shelves-1].h : 0;
+
+		if (next + h <= ATLAS_PAGE_SIZE){
+			best = &page->shelves[page->n_shelves++];
+			*best = (struct atlas_shelf){.y = next, .h = h};
+		}
+	}
+
+/* or recycle a drained one that is tall enough */
+	if (!best)
+		for (size_t i = 0; i < page->n_shelves; i++)
+			if (!page->shelves[i].used && page->shelves[i].h >= h){
+				best = &page->shelves[i];
+				best->x = 0;
+				break;
+			}
+
+	if (!best)
+		return false;
+
+	*shelf = best - page->shelves;
+	*x = best->x;
+	*y = best->y;
+	best->x += w;
+	best->used++;
+	page->n_slots++;
+
+	return true;
+}
+
+static void page_free(struct atlas_page* page, size_t shelf)
+{
+	struct atlas_shelf* cur = &page->shelves[shelf];
+	cur->used--;
+	page->n_slots--;
+
+	if (!cur->used)
+		cur->x = 0;
+
+	while (page->n_shelves && !page->shelves[page->n_shelves-1].used)
+		page->n_shelves--;
+}
+
+/* copy [src] into the page with its edges repeated into the padding */
+static void blit_padded(struct atlas_page* page,
+	const av_pixel* src, size_t w, size_t h, size_t x, size_t y)
+{
+	av_pixel* raw = page->store->vinf.text.raw;
+	size_t pw = w + ATLAS_PAD * 2;
+
+	for (size_t row = 0; row < h + ATLAS_PAD * 2; row++){
+		size_t sy = row < ATLAS_PAD ? 0 : row - ATLAS_PAD;
+		sy = sy >= h ? h - 1 : sy;
+		const av_pixel* sr = &src[sy * w];
+		av_pixel* dr = &raw[(y + row) * ATLAS_PAGE_SIZE + x];
+
+		for (size_t i = 0; i < ATLAS_PAD; i++){
+			dr[i] = sr[0];
+			dr[pw - 1 - i] = sr[w - 1];
+		}
+
+		memcpy(&dr[ATLAS_PAD], sr, w * sizeof(av_pixel));
+	}
+
+	size_t x2 = x + pw;
+	size_t y2 = y + h + ATLAS_PAD * 2;
+
+	if (!page->damaged){
+		page->dx1 = x; page->dy1 = y;
+		page->dx2 = x2; page->dy2 = y2;
+		page->damaged = true;
+		return;
+	}
+
+	page->dx1 = x < page->dx1 ? x : page->dx1;
+	page->dy1 = y < page->dy1 ? y : page->dy1;
+	page->dx2 = x2 > page->dx2 ? x2 : page->dx2;
+	page->dy2 = y2 > page->dy2 ? y2 : page->dy2;
+}
+
+static void slot_mapping(struct arcan_atlas_slot* slot, float* dst)
+{
+	float s1 = (float)(slot->x + ATLAS_PAD) / (float) ATLAS_PAGE_SIZE;
+	float t1 = (float)(slot->y + ATLAS_PAD) / (float) ATLAS_PAGE_SIZE;
+	float s2 = (float)(slot->x + ATLAS_PAD + slot->w) / (float) ATLAS_PAGE_SIZE;
+	float t2 = (float)(slot->y + ATLAS_PAD + slot->h) / (float) ATLAS_PAGE_SIZE;
+
+	dst[0] = s1; dst[1] = t1;
+	dst[2] = s2; dst[3] = t1;
+	dst[4] = s2; dst[5] = t2;
+	dst[6] = s1; dst[7] = t2;
+}
+
+/* children that inherit the mapping would sample their own store with it */
+static bool mapping_child(arcan_vobject* vobj)
+{
+	for (size_t i = 0; i < vobj->childslots; i++)
+		if (vobj->children[i] && (vobj->children[i]->mask & MASK_MAPPING))
+			return true;
+
+	return false;
+}
+
+bool arcan_vint_atlas_insert(arcan_vobject* vobj, unsigned context)
+{
+	struct agp_vstore* vs = vobj->vstore;
+
+	if (!arcan_video_display.atlas || arcan_video_display.conservative ||
+		vobj->atlas || vobj->txcos || vobj->frameset || vobj->program ||
+		(vobj->mask & MASK_MAPPING) || mapping_child(vobj) ||
+		FL_TEST(vobj, FL_PRSIST) || FL_TEST(vobj, FL_RTGT) ||
+		!vs || vs->refcount != 1 || vs->txmapped != TXSTATE_TEX2D ||
+		!vs->vinf.text.raw || vs->vinf.text.tag || vs->vinf.text.glid_proxy ||
+		vs->w == 0 || vs->h == 0 ||
+		vs->w > ATLAS_SLOT_LIMIT || vs->h > ATLAS_SLOT_LIMIT ||
+		vs->vinf.text.s_raw != vs->w * vs->h * sizeof(av_pixel) ||
+		vs->txu != ARCAN_VTEX_CLAMP || vs->txv != ARCAN_VTEX_CLAMP ||
+		(vs->filtermode != ARCAN_VFILTER_NONE &&
+		 vs->filtermode != ARCAN_VFILTER_LINEAR))
+		return false;
+
+	struct arcan_atlas_slot* slot = arcan_alloc_mem(
+		sizeof(struct arcan_atlas_slot), ARCAN_MEM_VSTRUCT,
+		ARCAN_MEM_BZERO | ARCAN_MEM_NONFATAL, ARCAN_MEMALIGN_NATURAL);
+	float* txcos = arcan_alloc_mem(8 * sizeof(float),
+		ARCAN_MEM_VSTRUCT, ARCAN_MEM_NONFATAL, ARCAN_MEMALIGN_SIMD);
+
+	if (!slot || !txcos){
+		arcan_mem_free(slot);
+		arcan_mem_free(txcos);
+		return false;
+	}
+
+	size_t pw = vs->w + ATLAS_PAD * 2;
+	size_t ph = vs->h + ATLAS_PAD * 2;
+
+	for (size_t i = 0; i < ATLAS_PAGE_LIMIT && !slot->page; i++){
+		if (!pages[i] || pages[i]->context != context ||
+			pages[i]->store->filtermode != vs->filtermode)
+			continue;
+
+		if (page_alloc(pages[i], pw, ph, &slot->shelf, &slot->x, &slot->y))
+			slot->page = pages[i];
+	}
+
+	if (!slot->page){
+		struct atlas_page* page = new_page(vs->filtermode, context);
+		if (!page || !page_alloc(page, pw, ph, &slot->shelf, &slot->x, &slot->y)){
+			arcan_mem_free(slot);
+			arcan_mem_free(txcos);
+			return false;
+		}
+		slot->page = page;
+	}
+
+	slot->w = vs->w;
+	slot->h = vs->h;
+	slot->refc = 1;
+	blit_padded(slot->page, vs->vinf.text.raw, vs->w, vs->h, slot->x, slot->y);
+
+/* the contents live in the page now, keep the rest for release */
+	agp_null_vstore(vs);
+	arcan_mem_free(vs->vinf.text.raw);
+	vs->vinf.text.raw = NULL;
+	vs->vinf.text.s_raw = 0;
+	slot->orig = vs;
+
+	vobj->atlas = slot;
+	vobj->vstore = slot->page->store;
+	vobj->vstore->refcount++;
+	slot_mapping(slot, txcos);
+	vobj->txcos = txcos;
+
+	FLAG_DIRTY(vobj);
+	return true;
+}
+
+struct agp_vstore* arcan_vint_atlas_source(arcan_vobject* vobj)
+{
+	return vobj->atlas ? vobj->atlas->orig : NULL;
+}
+
+static void drop_orig(struct agp_vstore* vs)
+{
+/* the text was already dropped with the texture so the normal path won't
+ * reach the source descriptions */
+	if (vs->vinf.text.kind == STORAGE_TEXTARRAY && vs->vinf.text.source_arr){
+		for (char** work = vs->vinf.text.source_arr; *work; work++)
+			arcan_mem_free(*work);
+		arcan_mem_free(vs->vinf.text.source_arr);
+	}
+	else
+		arcan_mem_free(vs->vinf.text.source);
+
+	vs->vinf.text.source = NULL;
+	arcan_vint_drop_vstore(vs);
+}
+
+void arcan_vint_atlas_share(arcan_vobject* src, arcan_vobject* dst)
+{
+	dst->atlas = src->atlas;
+	if (dst->atlas)
+		dst->atlas->refc++;
+}
+
+void arcan_vint_atlas_release(arcan_vobject* vobj, bool restore)
+{
+	struct arcan_atlas_slot* slot = vobj->atlas;
+	if (!slot)
+		return;
+
+	vobj->atlas = NULL;
+	struct atlas_page* page = slot->page;
+
+	if (restore){
+		struct agp_vstore* vs = slot->orig;
+
+/* other objects still use the slot, they keep the original metadata */
+		if (slot->refc > 1){
+			vs = arcan_alloc_mem(sizeof(struct agp_vstore),
+				ARCAN_MEM_VSTRUCT, ARCAN_MEM_BZERO, ARCAN_MEMALIGN_NATURAL);
+			vs->refcount = 1;
+			vs->txmapped = TXSTATE_TEX2D;
+			vs->bpp = sizeof(av_pixel);
+			vs->txu = slot->orig->txu;
+			vs->txv = slot->orig->txv;
+			vs->scale = slot->orig->scale;
+			vs->imageproc = slot->orig->imageproc;
+			vs->filtermode = slot->orig->filtermode;
+		}
+
+		vs->w = slot->w;
+		vs->h = slot->h;
+		vs->vinf.text.s_raw = slot->w * slot->h * sizeof(av_pixel);
+		vs->vinf.text.raw = arcan_alloc_mem(vs->vinf.text.s_raw,
+			ARCAN_MEM_VBUFFER, 0, ARCAN_MEMALIGN_PAGE);
+
+		av_pixel* src = page->store->vinf.text.raw;
+		for (size_t row = 0; row < slot->h; row++)
+			memcpy(&vs->vinf.text.raw[row * slot->w],
+				&src[(slot->y + ATLAS_PAD + row) *
+				ATLAS_PAGE_SIZE + slot->x + ATLAS_PAD],
+				slot->w * sizeof(av_pixel)
+			);
+
+		agp_update_vstore(vs, true);
+
+		if (vs == slot->orig)
+			slot->orig = NULL;
+
+		arcan_vint_drop_vstore(vobj->vstore);
+		vobj->vstore = vs;
+
+		if (vobj->txcos)
+			arcan_vint_defaultmapping(vobj->txcos, 1.0, 1.0);
+
+		FLAG_DIRTY(vobj);
+	}
+
+	if (--slot->refc)
+		return;
+
+	if (slot->orig)
+		drop_orig(slot->orig);
+
+	page_free(page, slot->shelf);
+	arcan_mem_free(slot);
+
+	if (!page->n_slots)
+		drop_page(page);
+}
+
+void arcan_vint_atlas_flush()
+{
+	for (size_t i = 0; i < ATLAS_PAGE_LIMIT; i++){
+		struct atlas_page* page = pages[i];
+		if (!page)
+			continue;
+
+		if (page->dirty){
+			agp_update_vstore(page->store, true);
+			page->dirty = false;
+			page->damaged = false;
+			continue;
+		}
+
+		if (!page->damaged)
+			continue;
+
+/* the objects in the region are flagged on insert, the rest of the page is
+ * untouched so this shouldn't invalidate anything else */
+		struct stream_meta stream = {
+			.buf = page->store->vinf.text.raw,
+			.dirty = true,
+			.x1 = page->dx1, .w = page->dx2 - page->dx1,
+			.y1 = page->dy1, .h = page->dy2 - page->dy1
+		};
+		stream = agp_stream_prepare(page->store,
+			stream, STREAM_RAW_DIRECT_SYNCHRONOUS);
+		agp_stream_commit(page->store, stream);
+		page->damaged = false;
+	}
+}
+
+void arcan_vint_atlas_restore(unsigned context)
+{
+	for (size_t i = 0; i < ATLAS_PAGE_LIMIT; i++)
+		if (pages[i] && pages[i]->context == context)
+			pages[i]->dirty = true;
+}
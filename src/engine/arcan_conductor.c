@@ -10,10 +10,16 @@
  */
 #include <stdint.h>
 #include <stdlib.h>
+#include <string.h>
 #include <inttypes.h>
 #include <stdbool.h>
 #include <stdio.h>
 #include <unistd.h>
+#include <poll.h>
+#include <math.h>
+#include <signal.h>
+#include <pthread.h>
+#include <stdatomic.h>
 
 #include "arcan_math.h"
 #include "arcan_general.h"
@@ -29,18 +35,23 @@
 
 #include "../platform/platform.h"
 #include "../platform/video_platform.h"
+#include "../platform/event_platform.h"
 
 /*
  * checklist:
- *  [ ] actual setup to realtime- plot the different timings and stages
+ *  [x] actual setup to realtime- plot the different timings and stages
  *      so it is easier (possible) to debug and evaluate the different strategies,
  *      for sake of comparison, pq has format+plotter for weston already, so use
  *      that.
+ *      [x] trace ring buffer, csv / chrome-trace export
+ *      [ ] live plotting
  *
- *  [ ] parallelize PBO uploads
+ *  [x] parallelize PBO uploads
  *      (thought: test the systemic effects of not doing shm->gpu in process but
  *      rather have an 'uploader proxy' (like we'd do with wayland) and pass the
  *      descriptors around instead.
+ *      [x] shm->mapped store copy in worker pool, commit on render thread
+ *      [ ] subregion and local_copy transfers still go through the serial path
  *
  *  [x] perform resize- ack during synch period
  *      [ ] multi-thread resize-ack/evproc.
@@ -53,8 +64,10 @@
  *      or drop the semaphores entirely (yes please) and switch to futexes, alas
  *      then we still have the problem of those not being a multiplexable primitives
  *      and needing a separate path for OSX.
+ *      [x] futexes on vready/aready when negotiated (linux)
+ *      [ ] resize-ack and event queue
  *
- *  [ ] defer GCs to low-load / embarassing pause in thread during synch etc.
+ *  [x] defer GCs to low-load / embarassing pause in thread during synch etc.
  *      since we now 'know' when we are waiting for the GPU to unlock, this is a
  *      good spot to manually step the Lua GCing.
  *
@@ -70,11 +83,80 @@ static struct {
 	double render_cost;
 	double transfer_cost;
 	uint8_t timestep;
+	uint8_t idle_cap;
+	uint8_t gc_cap;
+	uint8_t background_step;
+	uint64_t background_poll;
+	uint64_t background_wake;
+	int tick_left;
 	bool in_frame;
 } conductor = {
 	.render_cost = 4,
 	.transfer_cost = 1,
-	.timestep = 2
+	.timestep = 2,
+	.idle_cap = 16,
+	.gc_cap = 4,
+	.background_step = 32
+};
+
+/*
+ * Descriptors that the conductor can sleep on rather than stepping in
+ * [timestep] increments: frameserver event sockets (descriptor passing and
+ * hangup) and input devices.
+ *
+ * Frame delivery over shared memory does not have a pollable primitive, so
+ * that is checked before sleeping, and the sleep period is allowed to grow
+ * from [timestep] to [idle_cap] while nothing happens.
+ *
+ * Signalled entries are consumed by the main loop rather than here, so they
+ * are disarmed (negated, which poll ignores) to not spin on a level trigger
+ * and re-armed by rearm_pollset once the event pump or the herd has had a
+ * go at them.
+ */
+#define INPUT_FD_LIMIT 64
+
+static struct {
+	struct pollfd* set;
+	size_t used, limit;
+	int idle_step;
+	bool input_step;
+	bool pending_seen;
+	bool dirty;
+} pollset = {
+	.idle_step = 2,
+	.dirty = true
+};
+
+/*
+ * Worker pool for the shm-to-store copies. The render thread stages every
+ * frameserver with a frame ready (validation, resize checks and mapping the
+ * store happens there), the copies are split between the workers and the
+ * render thread, and the commit is left to the normal FFUNC_RENDER pass in
+ * pollfeed. Worker count can be set with ARCAN_CONDUCTOR_UPLOADERS (0 turns
+ * the pool off).
+ */
+#define UPLOAD_WORKER_LIMIT 8
+#define UPLOAD_WORKER_DEFAULT 4
+
+static struct {
+	pthread_t workers[UPLOAD_WORKER_LIMIT];
+	size_t n_workers;
+	bool initialized;
+
+	pthread_mutex_t lock;
+	pthread_cond_t wake;
+	pthread_cond_t done;
+	uint64_t generation;
+	size_t pending;
+	size_t active;
+
+	struct arcan_frameserver** jobs;
+	size_t n_jobs, job_limit;
+	atomic_size_t next;
+} uploader = {
+	.lock = PTHREAD_MUTEX_INITIALIZER,
+	.wake = PTHREAD_COND_INITIALIZER,
+	.done = PTHREAD_COND_INITIALIZER
 };
 
 static ssize_t find_frameserver(struct arcan_frameserver* fsrv);
@@ -94,6 +176,7 @@ static char* synchopts[] = {
 	"powersave", "synch to clock tick (~25Hz)",
 	"adaptive", "defer composition",
 	"tight", "defer composition, delay client-wake",
+	"focus", "defer composition, prioritize focus, batch the rest",
 	NULL
 };
 
@@ -116,29 +199,499 @@ enum synchopts {
 /* defer composition, wake clients after vsynch */
 	SYNCH_ADAPTIVE,
 /* defer composition, wake clients after half-time */
-	SYNCH_TIGHT
+	SYNCH_TIGHT,
+/* defer composition, wake focus on buffer ack, others at a lower rate */
+	SYNCH_FOCUS
 };
 
 static int synchopt = SYNCH_ADAPTIVE;
 
+/*
+ * Frame timing trace, fixed size records in a ring buffer so that recording
+ * is just a store, formatting is deferred until export. [epoch] is the time
+ * tracing was enabled, and record timestamps are relative to that.
+ */
+struct trace_entry {
+	uint64_t start;
+	uint64_t frame;
+	int64_t ident;
+	uint32_t duration;
+	uint16_t stage;
+	uint16_t synch;
+};
+
+static struct {
+	struct trace_entry* buf;
+	size_t limit, ofs, count;
+	uint64_t epoch;
+	uint64_t frame;
+	char* dump;
+	enum conductor_trace_format dump_fmt;
+} trace;
+
+static const char* trace_stages[] = {
+	"preframe_wait",
+	"event_drain",
+	"lua",
+	"refresh",
+	"video_synch",
+	"transfer",
+	"upload",
+	"client_wake",
+	"lua_gc"
+};
+
+uint64_t arcan_conductor_trace_begin()
+{
+	return trace.buf ? arcan_timemicros() : 0;
+}
+
+void arcan_conductor_trace(
+	enum conductor_trace_stage stage, uint64_t start, int64_t ident)
+{
+	if (!start || !trace.buf)
+		return;
+
+	uint64_t now = arcan_timemicros();
+	trace.buf[trace.ofs] = (struct trace_entry){
+		.start = start > trace.epoch ? start - trace.epoch : 0,
+		.frame = trace.frame,
+		.ident = ident,
+		.duration = now > start ? now - start : 0,
+		.stage = stage,
+		.synch = synchopt
+	};
+
+	trace.ofs = (trace.ofs + 1) % trace.limit;
+	if (trace.count < trace.limit)
+		trace.count++;
+}
+
+bool arcan_conductor_trace_enable(size_t n_entries)
+{
+	arcan_mem_free(trace.buf);
+	trace.buf = NULL;
+	trace.limit = trace.ofs = trace.count = 0;
+
+	if (!n_entries)
+		return true;
+
+	trace.buf = arcan_alloc_mem(sizeof(struct trace_entry) * n_entries,
+		ARCAN_MEM_VBUFFER, ARCAN_MEM_NONFATAL, ARCAN_MEMALIGN_NATURAL);
+	if (!trace.buf)
+		return false;
+
+	trace.limit = n_entries;
+	trace.epoch = arcan_timemicros();
+	trace.frame = 0;
+	return true;
+}
+
+bool arcan_conductor_trace_export(FILE* dst, enum conductor_trace_format fmt)
+{
+	if (!dst || !trace.buf)
+		return false;
+
+	size_t pos = (trace.ofs + trace.limit - trace.count) % trace.limit;
+
+	if (fmt == CONDUCTOR_TRACE_CSV)
+		fprintf(dst, "frame,stage,ident,start_us,duration_us,synch\n");
+	else
+		fprintf(dst, "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n");
+
+	for (size_t i = 0; i < trace.count; i++){
+		struct trace_entry* ent = &trace.buf[pos];
+		pos = (pos + 1) % trace.limit;
+
+		if (fmt == CONDUCTOR_TRACE_CSV){
+			fprintf(dst, "%"PRIu64",%s,%"PRId64",%"PRIu64",%"PRIu32",%s\n",
+				ent->frame, trace_stages[ent->stage], ent->ident,
+				ent->start, ent->duration, synchopts[ent->synch * 2]);
+			continue;
+		}
+
+		fprintf(dst, "%s{\"name\":\"%s\",\"cat\":\"conductor\",\"ph\":\"X\","
+			"\"pid\":1,\"tid\":1,\"ts\":%"PRIu64",\"dur\":%"PRIu32","
+			"\"args\":{\"frame\":%"PRIu64",\"ident\":%"PRId64",\"synch\":\"%s\"}}\n",
+			i > 0 ? "," : "", trace_stages[ent->stage], ent->start, ent->duration,
+			ent->frame, ent->ident, synchopts[ent->synch * 2]
+		);
+	}
+
+	if (fmt == CONDUCTOR_TRACE_CHROME)
+		fprintf(dst, "]}\n");
+
+	return true;
+}
+
+/* ARCAN_CONDUCTOR_TRACE=file, format picked on the .csv suffix */
+static void trace_env()
+{
+	const char* dst = getenv("ARCAN_CONDUCTOR_TRACE");
+	if (!dst || !dst[0] || trace.dump)
+		return;
+
+	size_t len = strlen(dst);
+	trace.dump_fmt = (len > 4 && strcmp(&dst[len - 4], ".csv") == 0) ?
+		CONDUCTOR_TRACE_CSV : CONDUCTOR_TRACE_CHROME;
+
+	if (!arcan_conductor_trace_enable(65536)){
+		arcan_warning("conductor: couldn't allocate trace buffer\n");
+		return;
+	}
+
+	trace.dump = strdup(dst);
+}
+
+static void trace_dump()
+{
+	if (!trace.dump)
+		return;
+
+	FILE* fout = fopen(trace.dump, "w");
+	if (!fout || !arcan_conductor_trace_export(fout, trace.dump_fmt))
+		arcan_warning("conductor: couldn't write trace to %s\n", trace.dump);
+
+	if (fout)
+		fclose(fout);
+
+	free(trace.dump);
+	trace.dump = NULL;
+}
+
+/*
+ * Displays as registered by the platform, each with its own refresh rate
+ * and time of last scanout so that deadlines are set by the display that
+ * needs a frame first rather than by the slowest one. [pending] is set while
+ * there is a frame queued for the display which hasn't been scanned out.
+ *
+ * Rendertargets that only feed pending displays are held back from refresh
+ * and clients attached to them are only released when that display synchs.
+ */
+#define DISPLAY_LIMIT 16
+
+static struct {
+	bool used;
+	bool pending;
+	size_t gpu_id, disp_id;
+	enum synch_method method;
+	float rate;
+	arcan_vobj_id obj;
+	uint64_t last_synch;
+} displays[DISPLAY_LIMIT];
+
+static ssize_t find_display(size_t gpu_id, size_t disp_id)
+{
+	for (size_t i = 0; i < DISPLAY_LIMIT; i++)
+		if (displays[i].used &&
+			displays[i].gpu_id == gpu_id && displays[i].disp_id == disp_id)
+			return i;
+
+	return -1;
+}
+
+bool arcan_conductor_display_held(arcan_vobj_id obj)
+{
+	if (obj == ARCAN_EID)
+		return false;
+
+	bool mapped = false;
+	for (size_t i = 0; i < DISPLAY_LIMIT; i++){
+		if (!displays[i].used || displays[i].obj != obj)
+			continue;
+
+		if (!displays[i].pending)
+			return false;
+
+		mapped = true;
+	}
+
+	return mapped;
+}
+
+/*
+ * Absolute time (ms) of the next expected vblank on a display that can take
+ * a new frame, or on any display if all of them are pending. 0 if unknown.
+ */
+static uint64_t display_deadline()
+{
+	uint64_t now = arcan_timemillis();
+	uint64_t best = 0, best_pending = 0;
+
+	for (size_t i = 0; i < DISPLAY_LIMIT; i++){
+		if (!displays[i].used || !displays[i].last_synch ||
+			displays[i].method == SYNCH_NONE)
+			continue;
+
+		double period = 1000.0 / displays[i].rate;
+		uint64_t next = displays[i].last_synch + period;
+		if (next <= now)
+			next = now + period - fmod((double)(now - displays[i].last_synch), period);
+
+		uint64_t* dst = displays[i].pending ? &best_pending : &best;
+		if (!*dst || next < *dst)
+			*dst = next;
+	}
+
+	return best ? best : best_pending;
+}
+
+static bool fsrv_held(struct arcan_frameserver* fsrv)
+{
+	return arcan_conductor_display_held(
+		arcan_vint_rtid(arcan_video_getobject(fsrv->vid)));
+}
+
 /*
  * difference between step/unlock is that step performs a polling step
  * where transfers might occur, unlock simply awakes clients that did
- * contribute a frame last pass but has been locked since
+ * contribute a frame last pass but has been locked since, with the exception
+ * of those mapped to a display that hasn't synched yet.
  */
 static void unlock_herd()
 {
+	uint64_t ts = arcan_conductor_trace_begin();
+
 	for (size_t i = 0; i < frameservers.count; i++)
-		if (frameservers.ref[i]){
+		if (frameservers.ref[i] && !fsrv_held(frameservers.ref[i])){
 			arcan_frameserver_releaselock(frameservers.ref[i]);
 		}
+
+	arcan_conductor_trace(CONDUCTOR_TRACE_CLIENT_WAKE, ts, -1);
+}
+
+static void unlock_display(size_t ind)
+{
+	uint64_t ts = arcan_conductor_trace_begin();
+
+	for (size_t i = 0; i < frameservers.count; i++){
+		struct arcan_frameserver* fsrv = frameservers.ref[i];
+		if (fsrv && arcan_vint_rtid(
+			arcan_video_getobject(fsrv->vid)) == displays[ind].obj)
+			arcan_frameserver_releaselock(fsrv);
+	}
+
+	arcan_conductor_trace(CONDUCTOR_TRACE_CLIENT_WAKE, ts, displays[ind].obj);
+}
+
+/*
+ * With the focus strategy, the focus target is released as soon as its buffer
+ * has been consumed, while the others are only released (and polled when we
+ * are in a yield) every [background_step] ms.
+ */
+static bool background_due(uint64_t* last)
+{
+	uint64_t now = arcan_timemillis();
+	if (now - *last < conductor.background_step)
+		return false;
+
+	*last = now;
+	return true;
+}
+
+static void unlock_focus()
+{
+	if (synchopt != SYNCH_FOCUS || !frameservers.focus)
+		return;
+
+	uint64_t ts = arcan_conductor_trace_begin();
+	arcan_frameserver_releaselock(frameservers.focus);
+	arcan_conductor_trace(
+		CONDUCTOR_TRACE_CLIENT_WAKE, ts, frameservers.focus->vid);
+}
+
+static size_t run_upload_jobs()
+{
+	size_t count = 0, ind;
+
+	while ((ind = atomic_fetch_add(&uploader.next, 1)) < uploader.n_jobs){
+		arcan_frameserver_copy_upload(uploader.jobs[ind]);
+		count++;
+	}
+
+	return count;
+}
+
+static void* upload_worker(void* arg)
+{
+/* only the synchronous fault signals should be able to land here */
+	sigset_t mask;
+	sigfillset(&mask);
+	sigdelset(&mask, SIGBUS);
+	sigdelset(&mask, SIGSEGV);
+	pthread_sigmask(SIG_BLOCK, &mask, NULL);
+
+	uint64_t generation = 0;
+	pthread_mutex_lock(&uploader.lock);
+
+	for(;;){
+		while (uploader.generation == generation)
+			pthread_cond_wait(&uploader.wake, &uploader.lock);
+
+		generation = uploader.generation;
+		uploader.active++;
+		pthread_mutex_unlock(&uploader.lock);
+
+		size_t count = run_upload_jobs();
+
+		pthread_mutex_lock(&uploader.lock);
+		uploader.pending -= count;
+		uploader.active--;
+		if (!uploader.pending && !uploader.active)
+			pthread_cond_signal(&uploader.done);
+	}
+
+	return NULL;
+}
+
+static void setup_uploader()
+{
+	if (uploader.initialized)
+		return;
+	uploader.initialized = true;
+
+	long ncpu = sysconf(_SC_NPROCESSORS_ONLN);
+	long count = ncpu > 1 ? ncpu - 1 : 0;
+	if (count > UPLOAD_WORKER_DEFAULT)
+		count = UPLOAD_WORKER_DEFAULT;
+
+	const char* env = getenv("ARCAN_CONDUCTOR_UPLOADERS");
+	if (env)
+		count = strtol(env, NULL, 10);
+
+	if (count < 0)
+		count = 0;
+	else if (count > UPLOAD_WORKER_LIMIT)
+		count = UPLOAD_WORKER_LIMIT;
+
+	for (long i = 0; i < count; i++){
+		if (0 != pthread_create(
+			&uploader.workers[uploader.n_workers], NULL, upload_worker, NULL)){
+			arcan_warning("conductor: couldn't spawn upload worker\n");
+			break;
+		}
+		pthread_detach(uploader.workers[uploader.n_workers]);
+		uploader.n_workers++;
+	}
+}
+
+static bool grow_jobs(size_t need)
+{
+	if (need <= uploader.job_limit)
+		return true;
+
+	struct arcan_frameserver** jobs = arcan_alloc_mem(
+		sizeof(struct arcan_frameserver*) * need, ARCAN_MEM_VSTRUCT,
+		ARCAN_MEM_BZERO | ARCAN_MEM_NONFATAL, ARCAN_MEMALIGN_NATURAL
+	);
+	if (!jobs)
+		return false;
+
+	arcan_mem_free(uploader.jobs);
+	uploader.jobs = jobs;
+	uploader.job_limit = need;
+	return true;
+}
+
+/*
+ * A copy that faulted (truncated shm) only flagged the job, the teardown of
+ * the shared resources happens here on the render thread, and the pollset
+ * has to be rebuilt as that closes the event descriptor.
+ */
+static void collect_failed(size_t n_jobs)
+{
+	for (size_t i = 0; i < n_jobs; i++){
+		if (uploader.jobs[i]->upload.state != FSRV_UPLOAD_FAILED)
+			continue;
+
+		arcan_frameserver_drop_upload(uploader.jobs[i]);
+		pollset.dirty = true;
+	}
+}
+
+/*
+ * Stage and copy all pending shm frames ahead of pollfeed, the FFUNC_RENDER
+ * for each frameserver will then only need to commit.
+ */
+static void upload_herd()
+{
+	setup_uploader();
+	if (!frameservers.used || !grow_jobs(frameservers.count))
+		return;
+
+	uint64_t ts = arcan_conductor_trace_begin();
+
+	size_t n_jobs = 0;
+	for (size_t i = 0, j = frameservers.used; i < frameservers.count && j > 0; i++){
+		struct arcan_frameserver* fsrv = frameservers.ref[i];
+		if (!fsrv)
+			continue;
+		j--;
+
+		if (arcan_frameserver_stage_upload(fsrv))
+			uploader.jobs[n_jobs++] = fsrv;
+	}
+
+	if (!n_jobs)
+		return;
+
+/* not worth the wakeup */
+	if (n_jobs == 1 || !uploader.n_workers){
+		for (size_t i = 0; i < n_jobs; i++)
+			arcan_frameserver_copy_upload(uploader.jobs[i]);
+		collect_failed(n_jobs);
+		arcan_conductor_trace(CONDUCTOR_TRACE_UPLOAD, ts, n_jobs);
+		return;
+	}
+
+	pthread_mutex_lock(&uploader.lock);
+		uploader.n_jobs = n_jobs;
+		atomic_store(&uploader.next, 0);
+		uploader.pending = n_jobs;
+		uploader.generation++;
+		pthread_cond_broadcast(&uploader.wake);
+	pthread_mutex_unlock(&uploader.lock);
+
+	size_t count = run_upload_jobs();
+
+	pthread_mutex_lock(&uploader.lock);
+		uploader.pending -= count;
+		while (uploader.pending || uploader.active)
+			pthread_cond_wait(&uploader.done, &uploader.lock);
+		uploader.n_jobs = 0;
+	pthread_mutex_unlock(&uploader.lock);
+
+	collect_failed(n_jobs);
+	arcan_conductor_trace(CONDUCTOR_TRACE_UPLOAD, ts, n_jobs);
+}
+
+/*
+ * Anything staged that pollfeed didn't reach (not attached to a rendertarget,
+ * locked, ...) gets released so the mapping doesn't outlive the frame.
+ */
+static void upload_herd_done()
+{
+	for (size_t i = 0, j = frameservers.used; i < frameservers.count && j > 0; i++){
+		if (frameservers.ref[i]){
+			arcan_frameserver_drop_upload(frameservers.ref[i]);
+			j--;
+		}
+	}
+}
+
+static void pollfeed_herd()
+{
+	upload_herd();
+	arcan_video_pollfeed();
+	upload_herd_done();
+	unlock_focus();
 }
 
 static void step_herd(int mode)
 {
 	uint64_t start = arcan_timemillis();
 	arcan_frameserver_lock_buffers(0);
-	arcan_video_pollfeed();
+	pollfeed_herd();
 	arcan_frameserver_lock_buffers(mode);
 	uint64_t stop = arcan_timemillis();
 
@@ -147,9 +700,244 @@ static void step_herd(int mode)
 		0.2 * conductor.transfer_cost;
 }
 
-static void internal_yield()
+static bool grow_pollset(size_t need)
+{
+	if (need <= pollset.limit)
+		return true;
+
+	size_t new_lim = need + 16;
+	struct pollfd* set = arcan_alloc_mem(sizeof(struct pollfd) * new_lim,
+		ARCAN_MEM_VSTRUCT, ARCAN_MEM_BZERO | ARCAN_MEM_NONFATAL,
+		ARCAN_MEMALIGN_NATURAL
+	);
+	if (!set)
+		return false;
+
+	if (pollset.set){
+		memcpy(set, pollset.set, sizeof(struct pollfd) * pollset.used);
+		arcan_mem_free(pollset.set);
+	}
+
+	pollset.set = set;
+	pollset.limit = new_lim;
+	return true;
+}
+
+static void build_pollset()
+{
+	if (!pollset.dirty)
+		return;
+
+	pollset.used = 0;
+	if (!grow_pollset(frameservers.used + INPUT_FD_LIMIT))
+		return;
+
+	for (size_t i = 0, j = frameservers.used; i < frameservers.count && j > 0; i++){
+		struct arcan_frameserver* fsrv = frameservers.ref[i];
+		if (!fsrv)
+			continue;
+		j--;
+
+		if (BADFD == fsrv->dpipe)
+			continue;
+
+		pollset.set[pollset.used++] = (struct pollfd){
+			.fd = fsrv->dpipe,
+			.events = POLLIN | POLLERR | POLLHUP
+		};
+	}
+
+/* platforms that can't provide descriptors still need regular stepping */
+	int fds[INPUT_FD_LIMIT];
+	ssize_t nfd = platform_event_pollset(fds, INPUT_FD_LIMIT);
+	pollset.input_step = nfd == -1;
+
+	for (ssize_t i = 0; i < nfd; i++){
+		pollset.set[pollset.used++] = (struct pollfd){
+			.fd = fds[i],
+			.events = POLLIN | POLLERR | POLLHUP
+		};
+	}
+
+	pollset.dirty = false;
+}
+
+/*
+ * Check the shared memory state of all frameservers for anything that
+ * the next pollfeed would act upon, mirrors FFUNC_POLL in the frameserver
+ */
+static bool herd_pending()
+{
+	for (size_t i = 0, j = frameservers.used; i < frameservers.count && j > 0; i++){
+		struct arcan_frameserver* fsrv = frameservers.ref[i];
+		if (!fsrv)
+			continue;
+		j--;
+
+		struct arcan_shmif_page* page = fsrv->shm.ptr;
+		if (!page)
+			continue;
+
+		if (page->resized ||
+			(atomic_load(&page->aready) > 0 && atomic_load(&page->apending) > 0))
+			return true;
+
+		if (fsrv->playstate == ARCAN_PLAYING && atomic_load(&page->vready) &&
+			!fsrv->flags.release_pending && !fsrv->flags.locked)
+			return true;
+
+		if (*fsrv->inqueue.front != *fsrv->inqueue.back)
+			return true;
+	}
+
+	return false;
+}
+
+static void rearm_pollset()
+{
+	for (size_t i = 0; i < pollset.used; i++)
+		if (pollset.set[i].fd < 0)
+			pollset.set[i].fd = ~pollset.set[i].fd;
+}
+
+/*
+ * Sleep for at most [timeout] ms, or until one of the descriptors in the
+ * pollset or in [disps] gets signalled. Returns true if it was one of the
+ * [disps] that woke us up.
+ */
+static bool conductor_wait(int timeout,
+	struct conductor_display* disps, size_t n_disps)
+{
+	build_pollset();
+
+/* something is already waiting, return immediately - unless the last pass
+ * also found pending state that the caller didn't consume */
+	if (herd_pending()){
+		pollset.idle_step = conductor.timestep;
+		if (!pollset.pending_seen){
+			pollset.pending_seen = true;
+			return false;
+		}
+		if (timeout > conductor.timestep)
+			timeout = conductor.timestep;
+	}
+	else
+		pollset.pending_seen = false;
+
+	if (timeout > pollset.idle_step)
+		timeout = pollset.idle_step;
+
+	if (pollset.input_step && timeout > conductor.timestep)
+		timeout = conductor.timestep;
+
+	size_t base = pollset.used;
+	if (!grow_pollset(base + n_disps)){
+		arcan_timesleep(timeout);
+		return false;
+	}
+
+	for (size_t i = 0; i < n_disps; i++){
+		pollset.set[base + i] = (struct pollfd){
+			.fd = disps[i].fd,
+			.events = POLLIN | POLLERR | POLLHUP
+		};
+	}
+
+	int rv = poll(pollset.set, base + n_disps, timeout < 0 ? 0 : timeout);
+	if (rv <= 0){
+		pollset.idle_step *= 2;
+		if (pollset.idle_step > conductor.idle_cap)
+			pollset.idle_step = conductor.idle_cap;
+		return false;
+	}
+
+	pollset.idle_step = conductor.timestep;
+
+	for (size_t i = 0; i < base; i++){
+		if (pollset.set[i].revents && pollset.set[i].fd >= 0)
+			pollset.set[i].fd = ~pollset.set[i].fd;
+	}
+
+	bool disp = false;
+	for (size_t i = 0; i < n_disps; i++)
+		disp |= pollset.set[base + i].revents != 0;
+
+	return disp;
+}
+
+/*
+ * Run incremental Lua collector steps for up to [budget] microseconds (0:
+ * only if the heap is far behind) and trace the ones that did any work.
+ */
+extern struct arcan_luactx* main_lua_context;
+static void gc_step(unsigned budget)
+{
+	if (!main_lua_context)
+		return;
+
+	arcan_benchdata* stats = arcan_bench_data();
+	unsigned steps = stats->gc_steps;
+	uint64_t ts = arcan_conductor_trace_begin();
+
+	arcan_lua_gcstep(main_lua_context, budget);
+
+/* only trace the calls that actually did something */
+	if (steps != stats->gc_steps)
+		arcan_conductor_trace(CONDUCTOR_TRACE_LUA_GC, ts, -1);
+}
+
+/*
+ * Spend the windows where we would otherwise just wait on collector steps.
+ * [left] is the number of ms until we need to be back, 1ms of which is kept
+ * as margin. Returns the number of ms that remain.
+ */
+static int gc_yield(int left)
+{
+	if (left <= 1)
+		return left;
+
+	int budget = left - 1;
+	if (budget > conductor.gc_cap)
+		budget = conductor.gc_cap;
+
+	unsigned long long start = arcan_timemillis();
+	gc_step(budget * 1000);
+	return left - (int)(arcan_timemillis() - start);
+}
+
+static void internal_yield(int left)
 {
-	arcan_timesleep(conductor.timestep);
+	if (left > conductor.tick_left)
+		left = conductor.tick_left;
+
+	left = gc_yield(left);
+
+	uint64_t ts = arcan_conductor_trace_begin();
+	conductor_wait(left > 0 ? left : 0, NULL, 0);
+	arcan_conductor_trace(CONDUCTOR_TRACE_PREFRAME_WAIT, ts, -1);
+}
+
+static void poll_herd()
+{
+	if (synchopt == SYNCH_FOCUS && frameservers.focus){
+		arcan_vint_pollfeed(frameservers.focus->vid, false);
+		unlock_focus();
+
+		if (!background_due(&conductor.background_poll)){
+			rearm_pollset();
+			return;
+		}
+	}
+
+	for (size_t i=0, j=frameservers.used; i < frameservers.count && j > 0; i++){
+		if (frameservers.ref[i]){
+			if (frameservers.ref[i] != frameservers.focus || synchopt != SYNCH_FOCUS)
+				arcan_vint_pollfeed(frameservers.ref[i]->vid, false);
+			j--;
+		}
+	}
+
+	rearm_pollset();
 }
 
 static void alloc_frameserver_struct()
@@ -182,16 +970,62 @@ void arcan_conductor_release_gpu(size_t gpu_id)
 void arcan_conductor_register_display(size_t gpu_id,
 		size_t disp_id, enum synch_method method, float rate, arcan_vobj_id obj)
 {
-/* need to know which display and which vobj is needed to be updated in order
- * to fulfill the requirement of the display synch so that we can schedule it
- * accordingly, later the full DAG- would also be calculated here to resolve
- * which agp- stores are involved and if they have an affinity on a locked
- * GPU or not so that we can MT GPU updates */
+/* re-registering is used to update the mapping or mode, keep synch state */
+	ssize_t ind = find_display(gpu_id, disp_id);
+	if (-1 == ind){
+		for (size_t i = 0; i < DISPLAY_LIMIT; i++)
+			if (!displays[i].used){
+				ind = i;
+				break;
+			}
+
+		if (-1 == ind){
+			arcan_warning("conductor: display limit reached, "
+				"%zu:%zu won't be scheduled\n", gpu_id, disp_id);
+			return;
+		}
+
+		displays[ind].used = true;
+		displays[ind].pending = false;
+		displays[ind].last_synch = 0;
+		displays[ind].gpu_id = gpu_id;
+		displays[ind].disp_id = disp_id;
+	}
+
+	displays[ind].method = method;
+	displays[ind].rate = rate > 0 ? rate : 60.0;
+	displays[ind].obj = obj;
+
+/* later the full DAG- would also be calculated here to resolve which agp-
+ * stores are involved and if they have an affinity on a locked GPU or not
+ * so that we can MT GPU updates */
 }
 
 void arcan_conductor_release_display(size_t gpu_id, size_t disp_id)
 {
-/* remove from set of known displays so its rate doesn't come into account */
+/* remove from set of known displays so its rate doesn't come into account,
+ * and let anything that waited on it go */
+	ssize_t ind = find_display(gpu_id, disp_id);
+	if (-1 == ind)
+		return;
+
+	displays[ind].pending = false;
+	unlock_display(ind);
+	displays[ind].used = false;
+}
+
+void arcan_conductor_display_pending(size_t gpu_id, size_t disp_id, bool pending)
+{
+	ssize_t ind = find_display(gpu_id, disp_id);
+	if (-1 == ind)
+		return;
+
+	displays[ind].pending = pending;
+	if (pending)
+		return;
+
+	displays[ind].last_synch = arcan_timemillis();
+	unlock_display(ind);
 }
 
 void arcan_conductor_register_frameserver(struct arcan_frameserver* fsrv)
@@ -234,6 +1068,7 @@ void arcan_conductor_register_frameserver(struct arcan_frameserver* fsrv)
 	}
 	frameservers.used++;
 	frameservers.ref[dst_i] = fsrv;
+	pollset.dirty = true;
 
 /*
  * other approach is to run a monitor thread here that futexes on the flags
@@ -254,14 +1089,17 @@ int arcan_conductor_yield(struct conductor_display* disps, size_t pset_count)
 	if (synchopt == SYNCH_PROCESSING)
 		return -1;
 
-	for (size_t i=0, j=frameservers.used; i < frameservers.count && j > 0; i++){
-		if (frameservers.ref[i]){
-			arcan_vint_pollfeed(frameservers.ref[i]->vid, false);
-			j--;
-		}
+/* the platform provided the display descriptors, so we can sleep on them
+ * together with the rest and let the platform check them immediately */
+	if (disps && pset_count){
+		gc_yield(conductor.timestep);
+		conductor_wait(conductor.idle_cap, disps, pset_count);
+		poll_herd();
+		return 0;
 	}
 
-/* same as other timesleep calls, should be replaced with poll and pollset */
+	gc_yield(conductor.timestep);
+	poll_herd();
 	return conductor.timestep;
 }
 
@@ -307,6 +1145,10 @@ void arcan_conductor_setsynch(const char* arg)
 	case SYNCH_TIGHT:
 		arcan_frameserver_lock_buffers(2);
 	break;
+	case SYNCH_FOCUS:
+		arcan_frameserver_lock_buffers(2);
+		unlock_focus();
+	break;
 	case SYNCH_IMMEDIATE:
 	case SYNCH_PROCESSING:
 		arcan_frameserver_lock_buffers(0);
@@ -317,17 +1159,22 @@ void arcan_conductor_setsynch(const char* arg)
 
 void arcan_conductor_focus(struct arcan_frameserver* fsrv)
 {
+	ssize_t dst_i = fsrv ? find_frameserver(fsrv) : -1;
+	if (-1 == dst_i)
+		return;
+
 /* Focus- based strategies might need to do special flag modification both
- * on set and remove. This table takes care of 'unset' */
+ * on set and remove. This table takes care of 'unset' - the old focus would
+ * otherwise be held until the next background batch */
 	switch (synchopt){
+	case SYNCH_FOCUS:
+		if (frameservers.focus && frameservers.focus != fsrv)
+			arcan_frameserver_releaselock(frameservers.focus);
+	break;
 	default:
 	break;
 	}
 
-	ssize_t dst_i = fsrv ? find_frameserver(fsrv) : -1;
-	if (-1 == dst_i)
-		return;
-
 	if (frameservers.focus){
 		frameservers.focus->flags.locked = false;
 	}
@@ -335,6 +1182,9 @@ void arcan_conductor_focus(struct arcan_frameserver* fsrv)
 /* And this is for 'set' */
 	frameservers.focus = fsrv;
 	switch(synchopt){
+	case SYNCH_FOCUS:
+		unlock_focus();
+	break;
 	default:
 	break;
 	}
@@ -350,6 +1200,7 @@ void arcan_conductor_deregister_frameserver(struct arcan_frameserver* fsrv)
 	}
 	frameservers.ref[dst_i] = NULL;
 	frameservers.used--;
+	pollset.dirty = true;
 
 	if (fsrv == frameservers.focus){
 		frameservers.focus = NULL;
@@ -358,7 +1209,6 @@ void arcan_conductor_deregister_frameserver(struct arcan_frameserver* fsrv)
 /* the real work here comes when we do multithreaded processing */
 }
 
-extern struct arcan_luactx* main_lua_context;
 static void process_event(arcan_event* ev, int drain)
 {
 /* [ mutex ]
@@ -374,9 +1224,10 @@ static int estimate_frame_cost()
 static bool preframe_synch(int next, int elapsed)
 {
 	switch(synchopt){
-	case SYNCH_ADAPTIVE:{
+	case SYNCH_ADAPTIVE:
+	case SYNCH_FOCUS:{
 		if (elapsed < next - estimate_frame_cost()){
-			internal_yield();
+			internal_yield(next - estimate_frame_cost() - elapsed);
 			return false;
 		}
 		return true;
@@ -386,17 +1237,15 @@ static bool preframe_synch(int next, int elapsed)
  * then we release the herd and wait until the last safe moment and go with that */
 	case SYNCH_TIGHT:{
 		if (elapsed < (next >> 1) - estimate_frame_cost()){
-			internal_yield();
+			internal_yield((next >> 1) - estimate_frame_cost() - elapsed);
 			return false;
 		}
 		else if (elapsed < next - estimate_frame_cost()){
 			if (!conductor.in_frame){
 				conductor.in_frame = true;
 				unlock_herd();
-				internal_yield();
-				return false;
 			}
-			internal_yield();
+			internal_yield(next - estimate_frame_cost() - elapsed);
 			return false;
 		}
 		return true;
@@ -418,6 +1267,11 @@ static uint64_t postframe_synch(uint64_t next)
 	case SYNCH_POWERSAVE:
 		unlock_herd();
 	break;
+	case SYNCH_FOCUS:
+		unlock_focus();
+		if (background_due(&conductor.background_wake))
+			unlock_herd();
+	break;
 	case SYNCH_PROCESSING:
 	case SYNCH_IMMEDIATE:
 	break;
@@ -430,9 +1284,22 @@ static int trigger_video_synch(float frag)
 {
 	conductor.set_deadline = -1;
 
+	uint64_t ts = arcan_conductor_trace_begin();
 	arcan_lua_callvoidfun(main_lua_context, "preframe_pulse", false, NULL);
+	arcan_conductor_trace(CONDUCTOR_TRACE_LUA, ts, -1);
+
+	ts = arcan_conductor_trace_begin();
 		platform_video_synch(conductor.tick_count, frag, NULL, NULL);
+	arcan_conductor_trace(CONDUCTOR_TRACE_VIDEO_SYNCH, ts, -1);
+
+	ts = arcan_conductor_trace_begin();
 	arcan_lua_callvoidfun(main_lua_context, "postframe_pulse", false, NULL);
+	arcan_conductor_trace(CONDUCTOR_TRACE_LUA, ts, -1);
+	trace.frame++;
+
+/* input devices can come and go without the conductor knowing, so rebuild
+ * the set once per frame to pick those up */
+	pollset.dirty = true;
 
 	arcan_bench_register_frame();
 	arcan_benchdata* stats = arcan_bench_data();
@@ -442,7 +1309,12 @@ static int trigger_video_synch(float frag)
 		0.8 * (double)stats->framecost[(uint8_t)stats->costofs] +
 		0.2 * conductor.render_cost;
 
-/* if the platform wants us to wait, it'll provide a new deadline at synch */
+/* with per-display timing, the next deadline is the display that can take
+ * a new frame the soonest, otherwise the platform can provide one at synch */
+	uint64_t next = display_deadline();
+	if (next)
+		return next;
+
 	return conductor.set_deadline > 0 ? conductor.set_deadline : 0;
 }
 
@@ -458,6 +1330,7 @@ int arcan_conductor_run(arcan_tick_cb tick)
 	uint64_t last_synch = arcan_timemillis();
 	uint64_t next_synch = 0;
 	int sstate = -1;
+	trace_env();
 
 	for(;;){
 /*
@@ -465,20 +1338,27 @@ int arcan_conductor_run(arcan_tick_cb tick)
  * and then actually dispatch / process these twice so that their old buffers
  * might get to be updated before we synch to display.
  */
-		arcan_video_pollfeed();
+		pollfeed_herd();
+		arcan_vint_pollasynch();
 		arcan_audio_refresh();
 		last_tickcount = conductor.tick_count;
 		float frag = arcan_event_process(evctx, conductor_cycle);
 		uint64_t elapsed = arcan_timemillis() - last_synch;
+		conductor.tick_left = (1.0 - frag) * (float) ARCAN_TIMER_TICK;
 
 /* This fails when the event recipient has queued a SHUTDOWN event */
+		uint64_t ts = arcan_conductor_trace_begin();
 		if (!arcan_event_feed(evctx, process_event, &exit_code))
 			break;
+		arcan_conductor_trace(CONDUCTOR_TRACE_EVENT_DRAIN, ts, -1);
+
+/* the herd and the input platform have been serviced, listen again */
+		rearm_pollset();
 
-/* Chunk the time left until the next batch and yield in small steps. This
- * puts us about 25fps, could probably go a little lower than that, say 12 */
+/* Sleep until the next batch or until something arrives. This puts us about
+ * 25fps, could probably go a little lower than that, say 12 */
 		if (synchopt == SYNCH_POWERSAVE && last_tickcount == conductor.tick_count){
-			internal_yield();
+			internal_yield(conductor.tick_left);
 			continue;
 		}
 
@@ -495,20 +1375,33 @@ int arcan_conductor_run(arcan_tick_cb tick)
 
 			next_synch = postframe_synch( trigger_video_synch(frag) );
 			last_synch = arcan_timemillis();
+
+/* if the idle windows haven't been enough to keep up with the garbage, this
+ * is the least bad time to catch up: right after composition */
+			gc_step(0);
 		}
 	}
 
+	trace_dump();
 	outcb = NULL;
 	return exit_code;
 }
 
 void arcan_conductor_fakesynch(uint8_t left)
 {
-	int real_left = left;
-	int step;
-	while ((step = arcan_conductor_yield(NULL, 0)) != -1 && left > step){
-		arcan_timesleep(step);
-		left -= step;
+	arcan_audio_refresh();
+	if (synchopt == SYNCH_PROCESSING)
+		return;
+
+	uint64_t deadline = arcan_timemillis() + left;
+	int rem = left;
+
+	while (rem > 0){
+		rem = gc_yield(rem);
+		conductor_wait(rem > 0 ? rem : 0, NULL, 0);
+		arcan_audio_refresh();
+		poll_herd();
+		rem = (int64_t) deadline - (int64_t) arcan_timemillis();
 	}
 }
 
@@ -534,7 +1427,9 @@ static void conductor_cycle(int nticks)
  *
  * and tag transforms handlers being one tick off
  */
+	uint64_t ts = arcan_conductor_trace_begin();
 	arcan_lua_tick(main_lua_context, nticks, conductor.tick_count);
+	arcan_conductor_trace(CONDUCTOR_TRACE_LUA, ts, -1);
 	outcb(nticks);
 
 	while(nticks--)
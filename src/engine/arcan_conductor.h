@@ -29,6 +29,21 @@ void arcan_conductor_register_display(size_t gpu_id,
  * Release a previously registered display and gpu pairing */
 void arcan_conductor_release_display(size_t gpu_id, size_t disp_id);
 
+/* [ called from platform ]
+ * Mark that a frame has been queued (pending) on a registered display, or
+ * that the display has synched (!pending: vblank / flip completed). This
+ * provides the per-display deadlines, releases clients that are mapped to
+ * the display and lets the rendertargets feeding it be updated again.
+ */
+void arcan_conductor_display_pending(size_t gpu_id, size_t disp_id, bool pending);
+
+/*
+ * Check if the rendertarget with vid [obj] (ARCAN_VIDEO_WORLDID for the
+ * default output) is only mapped to displays that have a frame pending,
+ * meaning that there is nothing to gain from updating it this pass.
+ */
+bool arcan_conductor_display_held(arcan_vobj_id obj);
+
 /* [ called from platform ]
  * mark GPU as locked and add [fence] to pollset, when there's data on fence,
  * invoke the lockhandler callback which [may] release the gpu
@@ -64,7 +79,9 @@ const char** arcan_conductor_synchopts();
  * waiting.
  *
  * Otherwise it returns the number of ms that the platform could wait
- * before yielding again (if, for instance, the pollset wasn't considered)
+ * before yielding again (if, for instance, the pollset wasn't considered).
+ * When [disps] is provided, the conductor will sleep on those descriptors
+ * along with its own and return 0 when any of them are signalled.
  */
 struct conductor_display {
 	ssize_t refresh;
@@ -100,7 +117,52 @@ void arcan_conductor_setsynch(const char* arg);
  */
 void arcan_conductor_fakesynch(uint8_t left_ms);
 
+/*
+ * Frame timing trace, each stage is recorded with start time and duration
+ * (microseconds), current frame number and an optional identifier (vid for
+ * frameserver transfers, number of frames for uploads, -1 otherwise).
+ *
+ * Use: uint64_t ts = arcan_conductor_trace_begin();
+ *      ... stage ...
+ *      arcan_conductor_trace(CONDUCTOR_TRACE_LUA, ts, -1);
+ *
+ * _begin returns 0 when tracing is disabled, and _trace ignores a zero
+ * timestamp, so the cost when not tracing is a branch. Only call from the
+ * main thread.
+ */
+enum conductor_trace_stage {
+	CONDUCTOR_TRACE_PREFRAME_WAIT = 0,
+	CONDUCTOR_TRACE_EVENT_DRAIN,
+	CONDUCTOR_TRACE_LUA,
+	CONDUCTOR_TRACE_REFRESH,
+	CONDUCTOR_TRACE_VIDEO_SYNCH,
+	CONDUCTOR_TRACE_TRANSFER,
+	CONDUCTOR_TRACE_UPLOAD,
+	CONDUCTOR_TRACE_CLIENT_WAKE,
+	CONDUCTOR_TRACE_LUA_GC
+};
+uint64_t arcan_conductor_trace_begin();
+void arcan_conductor_trace(
+	enum conductor_trace_stage stage, uint64_t start, int64_t ident);
+
 #ifndef VIDEO_PLATFORM_IMPL
+/*
+ * Start recording the frame timing trace into a ring buffer of [n_entries]
+ * records, dropping anything previously recorded. 0 disables tracing.
+ * Returns false if the buffer couldn't be allocated.
+ */
+bool arcan_conductor_trace_enable(size_t n_entries);
+
+/*
+ * Write the current contents of the trace ring buffer (oldest first) to
+ * [dst], either as CSV or as chrome://tracing compatible JSON.
+ */
+enum conductor_trace_format {
+	CONDUCTOR_TRACE_CSV = 0,
+	CONDUCTOR_TRACE_CHROME
+};
+bool arcan_conductor_trace_export(FILE* dst, enum conductor_trace_format fmt);
+
 /* Update the priority target to match the specified frameserver. This
  * means that heuristics driving synchronization will be biased towards
  * letting the specific fsrv align synchronization - if the synchronization
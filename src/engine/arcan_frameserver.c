@@ -91,6 +91,7 @@ arcan_errc arcan_frameserver_free(arcan_frameserver* src)
 		return ARCAN_ERRC_NO_SUCH_OBJECT;
 
 	arcan_conductor_deregister_frameserver(src);
+	arcan_frameserver_drop_upload(src);
 
 	arcan_aobj_id aid = src->aid;
 	uintptr_t tag = src->tag;
@@ -181,6 +182,106 @@ bool arcan_frameserver_control_chld(arcan_frameserver* src){
 	return true;
 }
 
+static inline bool resize_pending(
+	arcan_frameserver* src, struct agp_vstore* store)
+{
+	return src->desc.width != store->w || src->desc.height != store->h ||
+		src->desc.hints != src->desc.pending_hints || src->desc.rz_flag;
+}
+
+/* commit or release a mapping from _stage_upload, render thread only */
+static void finish_upload(arcan_frameserver* src, bool commit)
+{
+	agp_stream_commit(src->upload.store, (struct stream_meta){
+		.buf = src->upload.dst,
+		.type = STREAM_RAW_DIRECT_MAPPED,
+		.state = commit
+	});
+	src->upload.state = FSRV_UPLOAD_NONE;
+	src->upload.store = NULL;
+}
+
+bool arcan_frameserver_stage_upload(arcan_frameserver* src)
+{
+	struct arcan_shmif_page* shmpage = src->shm.ptr;
+
+	if (!shmpage || src->upload.state != FSRV_UPLOAD_NONE ||
+		g_buffers_locked == 1 || src->flags.locked ||
+		src->flags.release_pending || src->flags.explicit ||
+		src->flags.local_copy || -1 != src->vstream.handle ||
+		src->playstate != ARCAN_PLAYING || src->segid == SEGID_UNKNOWN)
+		return false;
+
+/* framesets might rotate the store before the render stage */
+	arcan_vobject* vobj = arcan_video_getobject(src->vid);
+	if (!vobj || vobj->frameset ||
+		vobj->feed.ffunc != FFUNC_VFRAME || !vobj->vstore ||
+		vobj->vstore->txmapped != TXSTATE_TEX2D)
+		return false;
+
+	struct agp_vstore* store = vobj->vstore;
+	TRAMP_GUARD(false, src);
+
+/* resizes, subregions (cheaper to just upload) and resize-ack all stay on
+ * the regular path as they need the event queue or the video layer */
+	if (shmpage->resized || !atomic_load(&shmpage->vready) ||
+		(shmpage->hints & SHMIF_RHINT_SUBREGION) || resize_pending(src, store)){
+		platform_fsrv_leave();
+		return false;
+	}
+
+	int vready = atomic_load_explicit(&shmpage->vready, memory_order_consume);
+	vready = (vready <= 0 || vready > src->vbuf_cnt) ? 0 : vready - 1;
+	platform_fsrv_leave();
+
+	struct stream_meta stream = agp_stream_prepare(
+		store, (struct stream_meta){.buf = NULL}, STREAM_RAW_DIRECT_MAPPED);
+	if (!stream.state)
+		return false;
+
+	src->upload.store = store;
+	src->upload.src = src->vbufs[vready];
+	src->upload.dst = stream.buf;
+	src->upload.n = store->w * store->h;
+	src->upload.state = FSRV_UPLOAD_STAGED;
+
+	return true;
+}
+
+void arcan_frameserver_copy_upload(arcan_frameserver* src)
+{
+	if (src->upload.state != FSRV_UPLOAD_STAGED)
+		return;
+
+/* this can run on a worker while the render thread still uses the shared
+ * resources, so a truncated page only marks the job and _drop_upload tears
+ * the connection down when the conductor collects it */
+	jmp_buf tramp;
+	if (0 != setjmp(tramp)){
+		src->upload.state = FSRV_UPLOAD_FAILED;
+		return;
+	}
+	platform_fsrv_enter_deferred(src, tramp);
+
+	memcpy(src->upload.dst, src->upload.src, src->upload.n * sizeof(av_pixel));
+
+	platform_fsrv_leave();
+	src->upload.state = FSRV_UPLOAD_READY;
+}
+
+void arcan_frameserver_drop_upload(arcan_frameserver* src)
+{
+	if (src->upload.state == FSRV_UPLOAD_NONE)
+		return;
+
+	bool failed = src->upload.state == FSRV_UPLOAD_FAILED;
+	finish_upload(src, false);
+
+/* same outcome as a fault inside TRAMP_GUARD on the render thread */
+	if (failed)
+		platform_fsrv_dropshared(src);
+}
+
 static bool push_buffer(arcan_frameserver* src,
 	struct agp_vstore* store, struct arcan_shmif_region* dirty)
 {
@@ -194,10 +295,20 @@ static bool push_buffer(arcan_frameserver* src,
 	vready = (vready <= 0 || vready > src->vbuf_cnt) ? 0 : vready - 1;
 	shmif_pixel* buf = src->vbufs[vready];
 
+/* the conductor might already have copied the frame into a mapped store,
+ * then all that is left is the commit, anything else means it is stale */
+	if (src->upload.state != FSRV_UPLOAD_NONE){
+		if (src->upload.state == FSRV_UPLOAD_READY && src->upload.store == store &&
+			src->upload.src == buf && !explicit && !resize_pending(src, store)){
+			finish_upload(src, true);
+			goto commit_mask;
+		}
+		finish_upload(src, false);
+	}
+
 /* Need to do this check here as-well as in the regular frameserver tick
  * control because the backing store might have changed somehwere else. */
-	if (src->desc.width != store->w || src->desc.height != store->h ||
-		src->desc.hints != src->desc.pending_hints || src->desc.rz_flag){
+	if (resize_pending(src, store)){
 		src->desc.hints = src->desc.pending_hints;
 		arcan_event rezev = {
 			.category = EVENT_FSRV,
@@ -484,8 +595,7 @@ int arcan_frameserver_releaselock(struct arcan_frameserver* tgt)
 	tgt->flags.release_pending = false;
 	TRAMP_GUARD(0, tgt);
 
-	atomic_store_explicit(&tgt->shm.ptr->vready, 0, memory_order_release);
-	arcan_sem_post( tgt->vsync );
+	platform_fsrv_release_video(tgt);
 		if (tgt->desc.hints & SHMIF_RHINT_VSIGNAL_EV){
 			platform_fsrv_pushevent(tgt, &(struct arcan_event){
 				.category = EVENT_TARGET,
@@ -580,10 +690,14 @@ enum arcan_ffunc_rv arcan_frameserver_vdirect FFUNC_HEAD
  * to be repeat until it succeeds - this mechanism could/should(?) also
  * be used with the vpts- below, simply defer until the deadline has
  * passed */
-		if (g_buffers_locked == 1 || tgt->flags.locked || !push_buffer(tgt,
-				dst_store, shmpage->hints & SHMIF_RHINT_SUBREGION ? &dirty : NULL)){
+		if (g_buffers_locked == 1 || tgt->flags.locked)
 			goto no_out;
-		}
+
+		uint64_t ts = arcan_conductor_trace_begin();
+		if (!push_buffer(tgt,
+			dst_store, shmpage->hints & SHMIF_RHINT_SUBREGION ? &dirty : NULL))
+			goto no_out;
+		arcan_conductor_trace(CONDUCTOR_TRACE_TRANSFER, ts, tgt->vid);
 
 /* for tighter latency management, here is where the estimated next
  * synch deadline for any output it is used on could/should be set,
@@ -598,9 +712,7 @@ enum arcan_ffunc_rv arcan_frameserver_vdirect FFUNC_HEAD
 /* interactive frameserver blocks on vsemaphore only,
  * so set monitor flags and wake up */
 		if (g_buffers_locked != 2){
-			atomic_store_explicit(&shmpage->vready, 0, memory_order_release);
-
-			arcan_sem_post( tgt->vsync );
+			platform_fsrv_release_video(tgt);
 			if (tgt->desc.hints & SHMIF_RHINT_VSIGNAL_EV){
 				platform_fsrv_pushevent(tgt, &(struct arcan_event){
 					.category = EVENT_TARGET,
@@ -1080,9 +1192,8 @@ arcan_errc arcan_frameserver_audioframe_direct(arcan_aobj* aobj,
 	}
 
 	if (0 == amask || ((1<<ind)&amask) == 0){
-		atomic_store_explicit(&src->shm.ptr->aready, 0, memory_order_release);
+		platform_fsrv_release_audio(src);
 		platform_fsrv_leave(src);
-		arcan_sem_post(src->async);
 		return ARCAN_ERRC_NOTREADY;
 	}
 
@@ -1106,9 +1217,8 @@ arcan_errc arcan_frameserver_audioframe_direct(arcan_aobj* aobj,
 
 /* check for cont and > 1, wait for signal.. else release */
 	if (!cont){
-		atomic_store_explicit(&src->shm.ptr->aready, 0, memory_order_release);
+		platform_fsrv_release_audio(src);
 		platform_fsrv_leave(src);
-		arcan_sem_post(src->async);
 	}
 
 	return ARCAN_OK;
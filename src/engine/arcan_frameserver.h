@@ -176,6 +176,16 @@ struct arcan_frameserver {
 		int format;
 	} vstream;
 
+/* shm-to-store copy staged by the conductor (see _stage_upload), the store
+ * is kept mapped until the next FFUNC_RENDER commits or drops it */
+	struct {
+		int state;
+		struct agp_vstore* store;
+		shmif_pixel* src;
+		av_pixel* dst;
+		size_t n;
+	} upload;
+
 /* temporary buffer for aligning queue/dequeue events in audio, can/should
  * be scrapped after the 0.6 audio refactor */
 	size_t sz_audb;
@@ -426,6 +436,34 @@ void arcan_frameserver_lock_buffers(int state);
  */
 int arcan_frameserver_releaselock(struct arcan_frameserver* tgt);
 
+/*
+ * Split version of the buffer transfer performed on FFUNC_RENDER, used by the
+ * conductor to move the copy from shared memory out of the render thread.
+ *
+ * _stage_upload (render thread) checks if there is a frame that can be
+ * transferred without a resize, explicit synch, local copy or handle passing
+ * and maps the destination store. Returns true if the frame was staged.
+ *
+ * _copy_upload performs the actual copy and can be called from any thread,
+ * though only from one thread per frameserver at a time. A fault during the
+ * copy marks the upload as failed, the shared resources are then dropped by
+ * the next _drop_upload.
+ *
+ * The commit is performed on the next FFUNC_RENDER, and anything that was
+ * staged but not consumed by then should be released with _drop_upload
+ * (render thread).
+ */
+enum fsrv_upload_state {
+	FSRV_UPLOAD_NONE = 0,
+	FSRV_UPLOAD_STAGED,
+	FSRV_UPLOAD_READY,
+	FSRV_UPLOAD_FAILED
+};
+
+bool arcan_frameserver_stage_upload(struct arcan_frameserver* tgt);
+void arcan_frameserver_copy_upload(struct arcan_frameserver* tgt);
+void arcan_frameserver_drop_upload(struct arcan_frameserver* tgt);
+
 /*
  * helper functions that tie together the platform/.../frameserver.c
  * with allocation, member matching, presets etc.
@@ -113,6 +113,11 @@ typedef struct {
 
 	unsigned framecost[64], costcount;
 	char costofs;
+
+/* Lua GC stepping performed by the conductor, costs in microseconds */
+	unsigned gc_steps, gc_cycles, gc_forced;
+	unsigned gc_lastcost, gc_maxcost;
+	unsigned long long gc_totalcost;
 } arcan_benchdata;
 
 /*
@@ -12,6 +12,16 @@
 #include <inttypes.h>
 #include <stdbool.h>
 #include <string.h>
+#include <pthread.h>
+#include <fcntl.h>
+#include <errno.h>
+#include <sys/types.h>
+#include <sys/stat.h>
+#include <dirent.h>
+
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
 
 #include "arcan_math.h"
 #include "arcan_general.h"
@@ -22,7 +32,21 @@
 	ARCAN_MEM_NONFATAL, ARCAN_MEMALIGN_PAGE))
 
 #define STBI_FREE(ptr) (arcan_mem_free(ptr))
-#define STBI_REALLOC(p,sz) realloc(p,sz)
+#define STBI_REALLOC_SIZED(p,oldsz,newsz) (stbi_arcan_realloc(p,oldsz,newsz))
+
+/* the blocks may come from a pool that libc realloc doesn't know about */
+static void* stbi_arcan_realloc(void* ptr, size_t oldsz, size_t newsz)
+{
+	void* rv = arcan_alloc_mem(newsz,
+		ARCAN_MEM_VBUFFER, ARCAN_MEM_NONFATAL, ARCAN_MEMALIGN_PAGE);
+
+	if (rv && ptr){
+		memcpy(rv, ptr, oldsz < newsz ? oldsz : newsz);
+		arcan_mem_free(ptr);
+	}
+
+	return rv;
+}
 
 #define STBI_ONLY_PNG
 #define STBI_ONLY_JPEG
@@ -104,10 +128,85 @@ arcan_errc arcan_img_outpng(FILE* dst,
 	return ARCAN_OK;
 }
 
+/* decoders all produce R, G, B, A in memory order */
+static inline uint32_t to_native(uint32_t v)
+{
+	return RGBA(
+		((v & 0x000000ff) >> 0),
+		((v & 0x0000ff00) >> 8),
+		((v & 0x00ff0000) >> 16),
+		((v & 0xff000000) >> 24)
+	);
+}
+
+#define NATIVE_IS_RGBA (RGBA(0x00, 0x00, 0xff, 0x00) == 0x00ff0000)
+#define NATIVE_IS_BGRA (RGBA(0xff, 0x00, 0x00, 0x00) == 0x00ff0000 &&\
+	RGBA(0x00, 0x00, 0x00, 0xff) == 0xff000000)
+
+/*
+ * convert the [n] pixels of [a] and [b] to the native format and swap them,
+ * [a] == [b] converts in place. Only 32-bit av_pixel packings come here.
+ */
+static void native_rows(uint32_t* a, uint32_t* b, size_t n)
+{
+	size_t i = 0;
+
+#ifdef __SSE2__
+	if (NATIVE_IS_RGBA || NATIVE_IS_BGRA){
+		const __m128i ga = _mm_set1_epi32((int) 0xff00ff00);
+		const __m128i lo = _mm_set1_epi32(0x000000ff);
+
+		for (; i + 4 <= n; i += 4){
+			__m128i va = _mm_loadu_si128((__m128i*) &a[i]);
+			__m128i vb = _mm_loadu_si128((__m128i*) &b[i]);
+
+/* keep G and A, swap R and B */
+			if (NATIVE_IS_BGRA){
+				va = _mm_or_si128(_mm_and_si128(va, ga), _mm_or_si128(
+					_mm_and_si128(_mm_srli_epi32(va, 16), lo),
+					_mm_slli_epi32(_mm_and_si128(va, lo), 16)));
+				vb = _mm_or_si128(_mm_and_si128(vb, ga), _mm_or_si128(
+					_mm_and_si128(_mm_srli_epi32(vb, 16), lo),
+					_mm_slli_epi32(_mm_and_si128(vb, lo), 16)));
+			}
+
+			_mm_storeu_si128((__m128i*) &a[i], vb);
+			_mm_storeu_si128((__m128i*) &b[i], va);
+		}
+	}
+#endif
+
+	for (; i < n; i++){
+		uint32_t va = a[i];
+		a[i] = to_native(b[i]);
+		b[i] = to_native(va);
+	}
+}
+
+/* in-place conversion, rows are swapped at the same time if [vflip] */
+static void native_inplace(uint32_t* buf, size_t w, size_t h, bool vflip)
+{
+	if (!h || (NATIVE_IS_RGBA && !vflip))
+		return;
+
+	if (!vflip){
+		native_rows(buf, buf, w * h);
+		return;
+	}
+
+	for (size_t y = 0; y < h >> 1; y++)
+		native_rows(&buf[y * w], &buf[(h - 1 - y) * w], w);
+
+	if (h & 1)
+		native_rows(&buf[(h >> 1) * w], &buf[(h >> 1) * w], w);
+}
+
 av_pixel* arcan_img_repack(uint32_t* inbuf, size_t inw, size_t inh)
 {
-	if (sizeof(av_pixel) == 4 && RGBA(0x00, 0x00, 0xff, 0x00) == 0x00ff0000)
+	if (sizeof(av_pixel) == 4){
+		native_inplace(inbuf, inw, inh, false);
 		return (av_pixel*) inbuf;
+	}
 
 	av_pixel* imgbuf = arcan_alloc_mem(sizeof(av_pixel) * inw * inh,
 		ARCAN_MEM_VBUFFER | ARCAN_MEM_NONFATAL, 0, ARCAN_MEMALIGN_PAGE);
@@ -117,15 +216,8 @@ av_pixel* arcan_img_repack(uint32_t* inbuf, size_t inw, size_t inh)
 
 	uint32_t* in_work = inbuf;
 	av_pixel* work = imgbuf;
-	for (size_t count = inw * inh; count > 0; count--){
-		uint32_t val = *in_work++;
-		*work++ = RGBA(
- 			((val & 0x000000ff) >> 0),
-			((val & 0x0000ff00) >> 8),
-			((val & 0x00ff0000) >> 16),
-			((val & 0xff000000) >> 24)
-		);
-	}
+	for (size_t count = inw * inh; count > 0; count--)
+		*work++ = to_native(*in_work++);
 
 done:
 	arcan_mem_free(inbuf);
@@ -202,12 +294,548 @@ arcan_errc arcan_dds_raw(const uint8_t* inbuf, size_t inbuf_sz,
 #endif
 }
 
+/*
+ * Decoded image cache, entries live both in a hash chain for lookup and in
+ * a doubly linked list in use order (head is most recent) for eviction.
+ */
+#define IMG_CACHE_BUCKETS 256
+
+struct img_centry {
+	char* path;
+	uint64_t dev, ino;
+	int64_t mtime, size;
+	size_t req_w, req_h;
+	int mode;
+	bool vflip;
+
+	size_t srcw, srch;
+	size_t w, h, origw, origh;
+	av_pixel* buf;
+	size_t buf_sz;
+
+	struct img_centry* hnext;
+	struct img_centry* prev, (* next);
+};
+
+static struct {
+	pthread_mutex_t lock;
+	struct img_centry* buckets[IMG_CACHE_BUCKETS];
+	struct img_centry* head, (* tail);
+	size_t used, budget;
+} img_cache = {
+	.lock = PTHREAD_MUTEX_INITIALIZER,
+	.budget = ARCAN_IMG_CACHE_DEFAULT
+};
+
+static size_t cache_bucket(const char* path)
+{
+	uint32_t hash = 5381;
+	while (*path)
+		hash = ((hash << 5) + hash) + (uint8_t) *path++;
+	return hash % IMG_CACHE_BUCKETS;
+}
+
+static void cache_unlink(struct img_centry* ent)
+{
+	if (ent->prev)
+		ent->prev->next = ent->next;
+	else
+		img_cache.head = ent->next;
+
+	if (ent->next)
+		ent->next->prev = ent->prev;
+	else
+		img_cache.tail = ent->prev;
+
+	ent->prev = ent->next = NULL;
+}
+
+static void cache_front(struct img_centry* ent)
+{
+	ent->next = img_cache.head;
+	if (img_cache.head)
+		img_cache.head->prev = ent;
+	img_cache.head = ent;
+	if (!img_cache.tail)
+		img_cache.tail = ent;
+}
+
+static void cache_drop(struct img_centry* ent)
+{
+	struct img_centry** cur = &img_cache.buckets[cache_bucket(ent->path)];
+	while (*cur != ent)
+		cur = &(*cur)->hnext;
+	*cur = ent->hnext;
+
+	cache_unlink(ent);
+	img_cache.used -= ent->buf_sz;
+	arcan_mem_free(ent->buf);
+	arcan_mem_free(ent->path);
+	arcan_mem_free(ent);
+}
+
+static bool cache_match(const struct img_centry* ent,
+	const struct arcan_img_ckey* key)
+{
+	if (ent->mtime != key->mtime || ent->size != key->size ||
+		ent->dev != key->dev || ent->ino != key->ino || ent->mode != key->mode || ent->vflip != key->vflip ||
+		strcmp(ent->path, key->path) != 0)
+		return false;
+
+/* asking for the source dimensions produces the same buffer as asking for
+ * nothing, this is what a conservative context pop does - except for vflip
+ * where the scaling pass flips a second time */
+	if (ent->req_w == key->w && ent->req_h == key->h)
+		return true;
+
+	return !key->vflip && ent->req_w == 0 && ent->req_h == 0 &&
+		key->w == ent->srcw && key->h == ent->srch;
+}
+
+bool arcan_img_cache_get(const struct arcan_img_ckey* key, av_pixel** out,
+	size_t* w, size_t* h, size_t* origw, size_t* origh)
+{
+	if (!img_cache.budget)
+		return false;
+
+	pthread_mutex_lock(&img_cache.lock);
+	struct img_centry* ent = img_cache.buckets[cache_bucket(key->path)];
+	while (ent && !cache_match(ent, key))
+		ent = ent->hnext;
+
+	if (!ent){
+		pthread_mutex_unlock(&img_cache.lock);
+		return false;
+	}
+
+	av_pixel* buf = arcan_alloc_mem(ent->buf_sz,
+		ARCAN_MEM_VBUFFER, ARCAN_MEM_NONFATAL, ARCAN_MEMALIGN_PAGE);
+	if (!buf){
+		pthread_mutex_unlock(&img_cache.lock);
+		return false;
+	}
+
+	memcpy(buf, ent->buf, ent->buf_sz);
+	*out = buf;
+	*w = ent->w;
+	*h = ent->h;
+	*origw = ent->origw;
+	*origh = ent->origh;
+
+	cache_unlink(ent);
+	cache_front(ent);
+	pthread_mutex_unlock(&img_cache.lock);
+	return true;
+}
+
+void arcan_img_cache_put(const struct arcan_img_ckey* key, const av_pixel* buf,
+	size_t w, size_t h, size_t origw, size_t origh, size_t srcw, size_t srch)
+{
+	size_t buf_sz = w * h * sizeof(av_pixel);
+
+/* a single image that would evict most of the cache is not worth keeping */
+	if (!img_cache.budget || buf_sz > img_cache.budget / 4)
+		return;
+
+	struct img_centry* ent = arcan_alloc_mem(sizeof(struct img_centry),
+		ARCAN_MEM_VSTRUCT, ARCAN_MEM_BZERO | ARCAN_MEM_NONFATAL,
+		ARCAN_MEMALIGN_NATURAL);
+	if (!ent)
+		return;
+
+	ent->buf = arcan_alloc_mem(buf_sz,
+		ARCAN_MEM_VBUFFER, ARCAN_MEM_NONFATAL, ARCAN_MEMALIGN_PAGE);
+	if (!ent->buf){
+		arcan_mem_free(ent);
+		return;
+	}
+
+	memcpy(ent->buf, buf, buf_sz);
+	ent->path = strdup(key->path);
+	ent->dev = key->dev;
+	ent->ino = key->ino;
+	ent->mtime = key->mtime;
+	ent->size = key->size;
+	ent->mode = key->mode;
+	ent->vflip = key->vflip;
+	bool plain = !key->vflip && key->w == srcw && key->h == srch;
+	ent->req_w = plain ? 0 : key->w;
+	ent->req_h = plain ? 0 : key->h;
+	ent->srcw = srcw;
+	ent->srch = srch;
+	ent->w = w;
+	ent->h = h;
+	ent->origw = origw;
+	ent->origh = origh;
+	ent->buf_sz = buf_sz;
+
+	pthread_mutex_lock(&img_cache.lock);
+
+/* replace the same request and anything from an older version of the file,
+ * two loaders racing on the same resource will also end up here */
+	size_t ind = cache_bucket(key->path);
+	struct img_centry* cur = img_cache.buckets[ind];
+	while (cur){
+		struct img_centry* next = cur->hnext;
+		if (strcmp(cur->path, ent->path) == 0 && (
+			cur->mtime != ent->mtime || cur->size != ent->size ||
+			cur->dev != ent->dev || cur->ino != ent->ino || (
+			cur->req_w == ent->req_w && cur->req_h == ent->req_h &&
+			cur->mode == ent->mode && cur->vflip == ent->vflip)))
+			cache_drop(cur);
+		cur = next;
+	}
+
+	while (img_cache.tail && img_cache.used + buf_sz > img_cache.budget)
+		cache_drop(img_cache.tail);
+
+	ent->hnext = img_cache.buckets[ind];
+	img_cache.buckets[ind] = ent;
+	cache_front(ent);
+	img_cache.used += buf_sz;
+
+	pthread_mutex_unlock(&img_cache.lock);
+}
+
+void arcan_img_cache_flush()
+{
+	pthread_mutex_lock(&img_cache.lock);
+	while (img_cache.tail)
+		cache_drop(img_cache.tail);
+	pthread_mutex_unlock(&img_cache.lock);
+}
+
+/*
+ * On-disk cache of decoded images, one file per source named after a 128-bit
+ * hash of the source contents and the load options, holding a small header
+ * and the pixels in the native format so that a later load is a read instead
+ * of an inflate. Files are written to a temporary name and renamed in place
+ * so that concurrent loaders never see partial blobs.
+ *
+ * Hits touch the file, and when a store takes the directory over its budget
+ * the least recently used files are removed until it is back below 3/4 of it.
+ */
+#define BLOB_MAGIC 0x41524358
+#define BLOB_VERSION 2
+
+struct blob_hdr {
+	uint32_t magic;
+	uint16_t version;
+	uint8_t pixel_sz;
+	uint8_t vflip;
+	uint32_t format;
+	uint32_t w, h;
+	uint32_t pad;
+	uint64_t src_sz;
+};
+
+struct blob_key {
+	uint64_t h[2];
+	size_t src_sz;
+};
+
+static struct {
+	pthread_mutex_t lock;
+	char* dir;
+	size_t used, budget;
+} blob_cache = {
+	.lock = PTHREAD_MUTEX_INITIALIZER,
+	.budget = ARCAN_IMG_BLOB_BUDGET
+};
+
+static inline uint64_t blob_rotl(uint64_t v, int n)
+{
+	return (v << n) | (v >> (64 - n));
+}
+
+static inline uint64_t blob_fmix(uint64_t v)
+{
+	v ^= v >> 33;
+	v *= 0xff51afd7ed558ccdULL;
+	v ^= v >> 33;
+	v *= 0xc4ceb9fe1a85ec53ULL;
+	v ^= v >> 33;
+	return v;
+}
+
+/*
+ * MurmurHash3 (x64, 128-bit) over the source, the hash only needs to be
+ * stable and cheap compared to the decode it replaces, the length is checked
+ * separately against the header.
+ */
+static struct blob_key blob_hash(const uint8_t* buf, size_t buf_sz)
+{
+	const uint64_t c1 = 0x87c37b91114253d5ULL;
+	const uint64_t c2 = 0x4cf5ad432745937fULL;
+	uint64_t h1 = 0, h2 = 0;
+
+	size_t i = 0;
+	for (; i + 16 <= buf_sz; i += 16){
+		uint64_t k[2];
+		memcpy(k, &buf[i], 16);
+		h1 ^= blob_rotl(k[0] * c1, 31) * c2;
+		h1 = (blob_rotl(h1, 27) + h2) * 5 + 0x52dce729;
+		h2 ^= blob_rotl(k[1] * c2, 33) * c1;
+		h2 = (blob_rotl(h2, 31) + h1) * 5 + 0x38495ab5;
+	}
+
+	if (i < buf_sz){
+		uint64_t k[2] = {0, 0};
+		memcpy(k, &buf[i], buf_sz - i);
+		h1 ^= blob_rotl(k[0] * c1, 31) * c2;
+		h2 ^= blob_rotl(k[1] * c2, 33) * c1;
+	}
+
+	h1 ^= buf_sz;
+	h2 ^= buf_sz;
+	h1 += h2;
+	h2 += h1;
+	h1 = blob_fmix(h1);
+	h2 = blob_fmix(h2);
+	h1 += h2;
+	h2 += h1;
+
+	return (struct blob_key){.h = {h1, h2}, .src_sz = buf_sz};
+}
+
+static char* blob_path(const struct blob_key* key, bool vflip)
+{
+	size_t len = strlen(blob_cache.dir) + 48;
+	char* path = arcan_alloc_mem(len,
+		ARCAN_MEM_STRINGBUF, ARCAN_MEM_TEMPORARY, ARCAN_MEMALIGN_NATURAL);
+	snprintf(path, len, "%s/%016"PRIx64"%016"PRIx64"%s.raw",
+		blob_cache.dir, key->h[0], key->h[1], vflip ? "_f" : "");
+	return path;
+}
+
+static bool blob_read(int fd, void* dst, size_t sz)
+{
+	uint8_t* cur = dst;
+	while (sz){
+		ssize_t nr = read(fd, cur, sz);
+		if (nr == -1 && (errno == EINTR || errno == EAGAIN))
+			continue;
+		if (nr <= 0)
+			return false;
+		cur += nr;
+		sz -= nr;
+	}
+	return true;
+}
+
+static bool blob_write(int fd, const void* src, size_t sz)
+{
+	const uint8_t* cur = src;
+	while (sz){
+		ssize_t nw = write(fd, cur, sz);
+		if (nw == -1 && (errno == EINTR || errno == EAGAIN))
+			continue;
+		if (nw <= 0)
+			return false;
+		cur += nw;
+		sz -= nw;
+	}
+	return true;
+}
+
+static bool blob_load(const struct blob_key* key, bool vflip,
+	av_pixel** out, size_t* outw, size_t* outh)
+{
+	char* path = blob_path(key, vflip);
+	int fd = open(path, O_RDONLY | O_CLOEXEC);
+	arcan_mem_free(path);
+	if (-1 == fd)
+		return false;
+
+	struct blob_hdr hdr;
+	struct stat fs;
+	if (!blob_read(fd, &hdr, sizeof(hdr)) || -1 == fstat(fd, &fs) ||
+		hdr.magic != BLOB_MAGIC || hdr.version != BLOB_VERSION ||
+		hdr.pixel_sz != sizeof(av_pixel) || hdr.format != RGBA(1, 2, 3, 4) ||
+		hdr.vflip != vflip || hdr.src_sz != key->src_sz ||
+		fs.st_size != sizeof(hdr) + (off_t) hdr.w * hdr.h * sizeof(av_pixel)){
+		close(fd);
+		return false;
+	}
+
+	size_t buf_sz = (size_t) hdr.w * hdr.h * sizeof(av_pixel);
+	av_pixel* buf = arcan_alloc_mem(buf_sz,
+		ARCAN_MEM_VBUFFER, ARCAN_MEM_NONFATAL, ARCAN_MEMALIGN_PAGE);
+
+	if (!buf || !blob_read(fd, buf, buf_sz)){
+		arcan_mem_free(buf);
+		close(fd);
+		return false;
+	}
+
+/* bump the modification time so pruning drops the least recently used */
+	futimens(fd, NULL);
+	close(fd);
+	*out = buf;
+	*outw = hdr.w;
+	*outh = hdr.h;
+	return true;
+}
+
+struct blob_ent {
+	char name[48];
+	struct timespec mtime;
+	size_t size;
+};
+
+static int blob_cmp(const void* a, const void* b)
+{
+	const struct blob_ent* ea = a;
+	const struct blob_ent* eb = b;
+	if (ea->mtime.tv_sec != eb->mtime.tv_sec)
+		return ea->mtime.tv_sec < eb->mtime.tv_sec ? -1 : 1;
+	if (ea->mtime.tv_nsec != eb->mtime.tv_nsec)
+		return ea->mtime.tv_nsec < eb->mtime.tv_nsec ? -1 : 1;
+	return 0;
+}
+
+/*
+ * Rescan the directory (other processes may share it) to resynch [used], and
+ * unlink the oldest entries until it is below 3/4 of the budget. Called with
+ * the blob_cache lock held.
+ */
+static void blob_prune()
+{
+	DIR* dir = opendir(blob_cache.dir);
+	if (!dir)
+		return;
+
+	struct blob_ent* ents = NULL;
+	size_t n_ents = 0, cap = 0;
+	size_t used = 0;
+
+	struct dirent* dent;
+	while ((dent = readdir(dir))){
+		size_t len = strlen(dent->d_name);
+		if (dent->d_name[0] == '.' || len < 4 || len >= sizeof(ents->name) ||
+			strcmp(&dent->d_name[len - 4], ".raw") != 0)
+			continue;
+
+		struct stat fs;
+		if (-1 == fstatat(dirfd(dir), dent->d_name, &fs, AT_SYMLINK_NOFOLLOW) ||
+			!S_ISREG(fs.st_mode))
+			continue;
+
+		if (n_ents == cap){
+			size_t ncap = cap ? cap * 2 : 64;
+			struct blob_ent* nents = arcan_alloc_mem(ncap * sizeof(struct blob_ent),
+				ARCAN_MEM_VSTRUCT, ARCAN_MEM_NONFATAL, ARCAN_MEMALIGN_NATURAL);
+			if (!nents)
+				break;
+			if (ents)
+				memcpy(nents, ents, n_ents * sizeof(struct blob_ent));
+			arcan_mem_free(ents);
+			ents = nents;
+			cap = ncap;
+		}
+
+		struct blob_ent* ent = &ents[n_ents++];
+		memcpy(ent->name, dent->d_name, len + 1);
+#ifdef __APPLE__
+		ent->mtime = fs.st_mtimespec;
+#else
+		ent->mtime = fs.st_mtim;
+#endif
+		ent->size = fs.st_size;
+		used += fs.st_size;
+	}
+
+	size_t target = blob_cache.budget / 4 * 3;
+	if (used > target && n_ents){
+		qsort(ents, n_ents, sizeof(struct blob_ent), blob_cmp);
+		for (size_t i = 0; i < n_ents && used > target; i++){
+			if (0 == unlinkat(dirfd(dir), ents[i].name, 0))
+				used -= ents[i].size;
+		}
+	}
+
+	closedir(dir);
+	arcan_mem_free(ents);
+	blob_cache.used = used;
+}
+
+static void blob_store(const struct blob_key* key, bool vflip,
+	const av_pixel* buf, size_t w, size_t h)
+{
+	size_t buf_sz = w * h * sizeof(av_pixel);
+	if (buf_sz > ARCAN_IMG_BLOB_LIMIT || buf_sz > blob_cache.budget)
+		return;
+
+	size_t len = strlen(blob_cache.dir) + 16;
+	char tmp[len];
+	snprintf(tmp, len, "%s/.tmpXXXXXX", blob_cache.dir);
+	int fd = mkstemp(tmp);
+	if (-1 == fd)
+		return;
+
+	struct blob_hdr hdr = {
+		.magic = BLOB_MAGIC,
+		.version = BLOB_VERSION,
+		.pixel_sz = sizeof(av_pixel),
+		.vflip = vflip,
+		.format = RGBA(1, 2, 3, 4),
+		.w = w,
+		.h = h,
+		.src_sz = key->src_sz
+	};
+
+	char* path = blob_path(key, vflip);
+	if (!blob_write(fd, &hdr, sizeof(hdr)) || !blob_write(fd, buf, buf_sz) ||
+		-1 == close(fd) || -1 == rename(tmp, path)){
+		arcan_warning("arcan_img: couldn't write cache entry %s\n", path);
+		unlink(tmp);
+		arcan_mem_free(path);
+		return;
+	}
+	arcan_mem_free(path);
+
+	pthread_mutex_lock(&blob_cache.lock);
+	blob_cache.used += sizeof(hdr) + buf_sz;
+	if (blob_cache.used > blob_cache.budget)
+		blob_prune();
+	pthread_mutex_unlock(&blob_cache.lock);
+}
+
+static bool blob_eligible(const char* hint)
+{
+	size_t len = strlen(hint);
+	return blob_cache.dir && len >= 3 && (
+		strcasecmp(hint + (len - 3), "PNG") == 0 ||
+		strcasecmp(hint + (len - 3), "JPG") == 0 ||
+		(len >= 4 && strcasecmp(hint + (len - 4), "JPEG") == 0));
+}
+
 void arcan_img_init()
 {
 	static bool initialized;
 	if (initialized)
 		return;
 
+	const char* env = getenv("ARCAN_VIDEO_IMGCACHE");
+	if (env)
+		img_cache.budget = (size_t) strtoul(env, NULL, 10) * 1024 * 1024;
+
+	env = getenv("ARCAN_VIDEO_BLOBCACHE_LIMIT");
+	if (env)
+		blob_cache.budget = (size_t) strtoul(env, NULL, 10) * 1024 * 1024;
+
+	env = getenv("ARCAN_VIDEO_BLOBCACHE");
+	if (env && env[0] && blob_cache.budget){
+		if (-1 == mkdir(env, 0700) && errno != EEXIST)
+			arcan_warning("arcan_img: couldn't create blob cache at %s\n", env);
+		else {
+			blob_cache.dir = strdup(env);
+			pthread_mutex_lock(&blob_cache.lock);
+			blob_prune();
+			pthread_mutex_unlock(&blob_cache.lock);
+		}
+	}
+
 	initialized = true;
 }
 
@@ -258,3 +886,45 @@ arcan_errc arcan_img_decode(const char* hint, char* inbuf, size_t inbuf_sz,
 
 	return rv;
 }
+
+arcan_errc arcan_img_decode_native(const char* hint, char* inbuf,
+	size_t inbuf_sz, av_pixel** outbuf, size_t* outw, size_t* outh,
+	struct arcan_img_meta* outm, bool vflip)
+{
+	uint32_t* buf = NULL;
+
+	struct blob_key key = {0};
+	bool blob = blob_eligible(hint);
+	if (blob){
+		key = blob_hash((uint8_t*) inbuf, inbuf_sz);
+		if (blob_load(&key, vflip, outbuf, outw, outh)){
+			*outm = (struct arcan_img_meta){0};
+			return ARCAN_OK;
+		}
+	}
+
+/* let the conversion pass do the flip rather than a separate one in stbi */
+	bool inplace = sizeof(av_pixel) == 4;
+	arcan_errc rv = arcan_img_decode(hint, inbuf, inbuf_sz,
+		&buf, outw, outh, outm, vflip && !inplace);
+
+	if (rv != ARCAN_OK || !buf)
+		return rv == ARCAN_OK ? ARCAN_ERRC_BAD_RESOURCE : rv;
+
+	if (outm->compressed){
+		*outbuf = (av_pixel*) buf;
+		return ARCAN_OK;
+	}
+
+	if (inplace){
+		native_inplace(buf, *outw, *outh, vflip);
+		*outbuf = (av_pixel*) buf;
+	}
+	else if (!(*outbuf = arcan_img_repack(buf, *outw, *outh)))
+		return ARCAN_ERRC_OUT_OF_SPACE;
+
+	if (blob)
+		blob_store(&key, vflip, *outbuf, *outw, *outh);
+
+	return ARCAN_OK;
+}
@@ -41,4 +41,78 @@ arcan_errc arcan_img_outpng(FILE* dst,
  * returns NULL on failure but [inbuf] will always be freed (or re-used)
  */
 av_pixel* arcan_img_repack(uint32_t* inbuf, size_t inw, size_t inh);
+
+/*
+ * Same as arcan_img_decode, but [outbuf] is returned in the native engine
+ * color format with [vflip] applied. The conversion and the flip are done in
+ * place in a single pass over the decoded buffer, which is page aligned and
+ * can be used as a vstore backing store as-is. Natively compressed formats
+ * are returned untouched (see [outm]).
+ *
+ * If the ARCAN_VIDEO_BLOBCACHE environment variable points to a directory,
+ * PNG/JPEG results (up to ARCAN_IMG_BLOB_LIMIT bytes) are also written there
+ * keyed on a hash of [inbuf], and later decodes of the same contents are read
+ * back from that directory instead. The directory is kept within
+ * ARCAN_IMG_BLOB_BUDGET bytes (ARCAN_VIDEO_BLOBCACHE_LIMIT, in MiB, 0
+ * disables it) by removing the least recently used entries.
+ */
+#ifndef ARCAN_IMG_BLOB_LIMIT
+#define ARCAN_IMG_BLOB_LIMIT (4 * 1024 * 1024)
+#endif
+
+#ifndef ARCAN_IMG_BLOB_BUDGET
+#define ARCAN_IMG_BLOB_BUDGET (256 * 1024 * 1024)
+#endif
+
+arcan_errc arcan_img_decode_native(const char* hint, char* inbuf,
+	size_t inbuf_sz, av_pixel** outbuf, size_t* outw, size_t* outh,
+	struct arcan_img_meta* outm, bool vflip);
+
+/*
+ * Cache of decoded (repacked, scaled) images so that repeated loads of the
+ * same resource skip the decode step. An entry is identified by the resolved
+ * path, the device and inode, size and modification time (in nanoseconds) of
+ * the file and the parameters that affect the final buffer ([w, h] requested,
+ * [mode] scale mode, [vflip]).
+ *
+ * The budget (in bytes) defaults to ARCAN_IMG_CACHE_DEFAULT and can be set
+ * with the ARCAN_VIDEO_IMGCACHE environment variable (in MiB), 0 disables it.
+ * Least recently used entries are dropped when it is exceeded.
+ *
+ * All functions are safe to call from the asynchronous loader threads.
+ */
+struct arcan_img_ckey {
+	const char* path;
+	uint64_t dev, ino;
+	int64_t mtime;
+	int64_t size;
+	size_t w, h;
+	int mode;
+	bool vflip;
+};
+
+#ifndef ARCAN_IMG_CACHE_DEFAULT
+#define ARCAN_IMG_CACHE_DEFAULT (64 * 1024 * 1024)
+#endif
+
+/*
+ * On a hit, [out] is set to a newly allocated copy of the cached buffer that
+ * the caller owns, with the stored and original dimensions in [w, h] and
+ * [origw, origh]. A request for [w, h] matching the source dimensions is
+ * treated as unconstrained.
+ */
+bool arcan_img_cache_get(const struct arcan_img_ckey* key, av_pixel** out,
+	size_t* w, size_t* h, size_t* origw, size_t* origh);
+
+/*
+ * Store a copy of [buf] ([w, h], from a source of [srcw, srch] presented as
+ * [origw, origh]), replacing any entry for an older version of the file.
+ */
+void arcan_img_cache_put(const struct arcan_img_ckey* key, const av_pixel* buf,
+	size_t w, size_t h, size_t origw, size_t origh, size_t srcw, size_t srch);
+
+/*
+ * Drop all cached entries.
+ */
+void arcan_img_cache_flush();
 #endif
@@ -55,6 +55,7 @@
 #include <sys/socket.h>
 #include <sys/un.h>
 #include <math.h>
+#include <limits.h>
 
 #include <assert.h>
 
@@ -339,6 +340,13 @@ static struct {
 	char* last_crash_source;
 
 	lua_State* last_ctx;
+
+/* collector state when the conductor is stepping the GC, heap sizes in kb */
+	struct {
+		lua_State* owner;
+		int baseline;
+		bool in_cycle;
+	} gc;
 } luactx = {0};
 
 extern char* _n_strdup(const char* instr, const char* alt);
@@ -867,6 +875,69 @@ void arcan_lua_tick(lua_State* ctx, size_t nticks, size_t global)
 	while (nticks-- > 0);
 }
 
+/* heap growth (in % of the live set after the last cycle) before we start
+ * a cycle in idle windows, and before we catch up outside of them. The
+ * automatic collector is only a safety net, its pause is set well past both
+ * so that cycles are started from here and not by an allocation mid-frame */
+#define GC_IDLE_GROWTH 125
+#define GC_FORCE_GROWTH 200
+#define GC_AUTO_PAUSE 400
+#define GC_FORCE_BUDGET 1000
+
+extern arcan_benchdata benchdata;
+bool arcan_lua_gcstep(lua_State* ctx, unsigned budget)
+{
+	if (luactx.gc.owner != ctx){
+		luactx.gc.owner = ctx;
+		luactx.gc.baseline = lua_gc(ctx, LUA_GCCOUNT, 0);
+		luactx.gc.in_cycle = false;
+		lua_gc(ctx, LUA_GCSETPAUSE, GC_AUTO_PAUSE);
+	}
+
+	int heap = lua_gc(ctx, LUA_GCCOUNT, 0);
+	int base = luactx.gc.baseline > 64 ? luactx.gc.baseline : 64;
+	bool forced = false;
+
+	if (!budget){
+		if (heap * 100 < base * GC_FORCE_GROWTH)
+			return false;
+
+/* way behind, the idle windows aren't enough, take larger (but still
+ * bounded) steps rather than finishing the cycle in one go */
+		budget = heap * 100 >= base * 2 * GC_FORCE_GROWTH ?
+			2 * GC_FORCE_BUDGET : GC_FORCE_BUDGET;
+		forced = true;
+	}
+	else if (!luactx.gc.in_cycle && heap * 100 < base * GC_IDLE_GROWTH)
+		return false;
+
+	uint64_t start = arcan_timemicros();
+	uint64_t now = start;
+	bool done = false;
+	luactx.gc.in_cycle = true;
+
+	while (!done && now - start < budget){
+		done = lua_gc(ctx, LUA_GCSTEP, 0) == 1;
+		now = arcan_timemicros();
+	}
+
+	if (done){
+		luactx.gc.in_cycle = false;
+		luactx.gc.baseline = lua_gc(ctx, LUA_GCCOUNT, 0);
+		benchdata.gc_cycles++;
+	}
+
+	unsigned cost = now - start;
+	benchdata.gc_steps++;
+	benchdata.gc_forced += forced;
+	benchdata.gc_lastcost = cost;
+	benchdata.gc_totalcost += cost;
+	if (cost > benchdata.gc_maxcost)
+		benchdata.gc_maxcost = cost;
+
+	return done;
+}
+
 char* arcan_lua_main(lua_State* ctx, const char* inp, bool file)
 {
 /* since we prefix scriptname to functions that we look-up,
@@ -935,16 +1006,13 @@ void arcan_lua_adopt(struct arcan_luactx* ctx)
 {
 /* works on the idea that the context stack has already been collapsed into
  * 'only-fsrv' related vids left */
-	struct arcan_vobject_litem* first = vcontext_stack[0].stdoutp.first;
-	struct arcan_vobject_litem* current = first;
+	struct rendertarget* base = &vcontext_stack[0].stdoutp;
 
 	size_t n_fsrv = 0;
 /* one: find out how many frameservers are running in the context */
-	while(current){
-		if (current->elem->feed.state.tag == ARCAN_TAG_FRAMESERV)
+	for (size_t i = 0; i < base->n_items; i++)
+		if (base->items[i].elem->feed.state.tag == ARCAN_TAG_FRAMESERV)
 			n_fsrv++;
-		current = current->next;
-	}
 
 	if (n_fsrv == 0)
 		return;
@@ -954,16 +1022,15 @@ void arcan_lua_adopt(struct arcan_luactx* ctx)
  * we get primary segments before secondary ones */
 	arcan_vobj_id ids[n_fsrv];
 	size_t count = 0, lcount = n_fsrv -1;
-	current = first;
-	while(count < n_fsrv && current){
-		if (current->elem->feed.state.tag == ARCAN_TAG_FRAMESERV){
-			arcan_frameserver* fsrv = current->elem->feed.state.ptr;
+	for (size_t i = 0; count < n_fsrv && i < base->n_items; i++){
+		arcan_vobject* elem = base->items[i].elem;
+		if (elem->feed.state.tag == ARCAN_TAG_FRAMESERV){
+			arcan_frameserver* fsrv = elem->feed.state.ptr;
 			if (fsrv->parent.vid != ARCAN_EID)
-				ids[lcount--] = current->elem->cellid;
+				ids[lcount--] = elem->cellid;
 			else
-				ids[count++] = current->elem->cellid;
+				ids[count++] = elem->cellid;
 		}
-		current = current->next;
 	}
 
 	arcan_vobj_id delids[n_fsrv];
@@ -2058,6 +2125,7 @@ static int imageresizestorage(lua_State* ctx)
 
 	vobj->origw = w;
 	vobj->origh = h;
+	arcan_vint_pickdirty();
 
 	struct rendertarget* rtgt = arcan_vint_findrt(vobj);
 	if (rtgt){
@@ -2142,8 +2210,8 @@ static int centerimage(lua_State* ctx)
  * and finally translate to coordinates in src-obj space */
 
 	arcan_video_objectmove(src,
-		sobj->current.position.x + ap_x - cp_sx + xofs,
-		sobj->current.position.y + ap_y - cp_sy + yofs, 1.0, 0
+		sobj->hot->current.position.x + ap_x - cp_sx + xofs,
+		sobj->hot->current.position.y + ap_y - cp_sy + yofs, 1.0, 0
 	);
 
 	LUA_ETRACE("center_image", NULL, 0);
@@ -2545,7 +2613,7 @@ static int matchstorage(lua_State* ctx)
 	arcan_vobject* v1, (* v2);
 	luaL_checkvid(ctx, 1, &v1);
 	luaL_checkvid(ctx, 2, &v2);
-	lua_pushboolean(ctx, v1->vstore == v2->vstore);
+	lua_pushboolean(ctx, v1->vstore == v2->vstore && v1->atlas == v2->atlas);
 
 	LUA_ETRACE("image_matchstorage", NULL, 1);
 }
@@ -5922,6 +5990,7 @@ static int slicestore(lua_State* ctx)
 	luaL_checktype(ctx, 3, LUA_TTABLE);
 	int values = lua_rawlen(ctx, 2);
 
+	arcan_vint_atlas_release(vobj, true);
 	if (vobj->vstore->txmapped != TXSTATE_TEX2D)
 		arcan_fatal("image_storage_slice(), destination store is not textured");
 
@@ -6480,6 +6549,8 @@ static int videomapping(lua_State* ctx)
 			arcan_fatal("map_video_display(), invalid vid "
 				"requested %"PRIxVOBJ" \n", vid);
 
+		arcan_vint_atlas_release(vobj, true);
+
 		if (vobj->vstore->txmapped != TXSTATE_TEX2D){
 			arcan_warning("map_video_display(), associated "
 				"video object has an invalid backing store (font, color, ...)\n");
@@ -7026,6 +7097,8 @@ void arcan_lua_shutdown(lua_State* ctx)
 /* deal with:
  * luactx : rawres, lastsrc, cb_source_kind, db_source_tag, last_segreq,
  * pending_socket_label, pending_socket_descr */
+	if (luactx.gc.owner == ctx)
+		luactx.gc.owner = NULL;
 	lua_close(ctx);
 }
 
@@ -8521,13 +8594,11 @@ static int rendertarget_vids(lua_State* ctx)
  * rendertarget- modifications from callback would be safe */
 	lua_newtable(ctx);
 
-	int i = 1, top = lua_gettop(ctx);
-	arcan_vobject_litem* current = rtgt->first;
-	while(current){
-		lua_pushnumber(ctx, i++);
-		lua_pushvid(ctx, current->elem->cellid);
+	int top = lua_gettop(ctx);
+	for (size_t i = 0; i < rtgt->n_items; i++){
+		lua_pushnumber(ctx, i + 1);
+		lua_pushvid(ctx, rtgt->items[i].elem->cellid);
 		lua_rawset(ctx, top);
-		current = current->next;
 	}
 
 	LUA_ETRACE("rendertarget_vids", NULL, 1);
@@ -8545,6 +8616,18 @@ static int rendernoclear(lua_State* ctx)
 	LUA_ETRACE("rendertarget_noclear", NULL, 1);
 }
 
+static int renderstatesort(lua_State* ctx)
+{
+	LUA_TRACE("rendertarget_statesort");
+	arcan_vobj_id did = luaL_checkvid(ctx, 1, NULL);
+	bool sortfl = luaL_optbnumber(ctx, 2, true);
+
+	lua_pushboolean(ctx,
+		arcan_video_rendertarget_setstatesort(did, sortfl) == ARCAN_OK);
+
+	LUA_ETRACE("rendertarget_statesort", NULL, 1);
+}
+
 static int renderreconf(lua_State* ctx)
 {
 	LUA_TRACE("rendertarget_reconfigure");
@@ -8819,6 +8902,7 @@ static int procimage_histo(lua_State* ctx)
 
 	arcan_vobject* vobj;
 	luaL_checkvid(ctx, 2, &vobj);
+	arcan_vint_atlas_release(vobj, true);
 
 	if (!vobj->vstore || vobj->vstore->txmapped == TXSTATE_OFF ||
 		!vobj->vstore->vinf.text.raw)
@@ -9210,6 +9294,7 @@ static int imagestorage(lua_State* ctx)
 
 	arcan_vobject* vobj;
 	luaL_checkvid(ctx, 1, &vobj);
+	arcan_vint_atlas_release(vobj, true);
 
 	if (vobj->vstore->txmapped != TXSTATE_TEX2D){
 		arcan_warning("image_access_storage(), referenced object "
@@ -9535,6 +9620,8 @@ static int feedtarget(lua_State* ctx)
 	vfunc_state* state = arcan_video_feedstate(did);
 	if (state->tag != ARCAN_TAG_FRAMESERV)
 		arcan_fatal("define_feedtarget() feedtarget (1) " FATAL_MSG_FRAMESERV);
+
+	arcan_vint_atlas_release(sobj, true);
 /*
  * trick here is to set up as a "normal" recordtarget,
  * but where we simply sample one object and use the offline vstore --
@@ -9815,7 +9902,6 @@ static int recordgain(lua_State* ctx)
 	LUA_ETRACE("recordtarget_gain", NULL, 0);
 }
 
-extern arcan_benchdata benchdata;
 static int togglebench(lua_State* ctx)
 {
 	LUA_TRACE("benchmark_enable");
@@ -9835,6 +9921,9 @@ static int togglebench(lua_State* ctx)
 	memset(benchdata.framecost, '\0', sizeof(benchdata.framecost));
 	benchdata.tickofs = benchdata.frameofs = benchdata.costofs = 0;
 	benchdata.framecount = benchdata.tickcount = benchdata.costcount = 0;
+	benchdata.gc_steps = benchdata.gc_cycles = benchdata.gc_forced = 0;
+	benchdata.gc_lastcost = benchdata.gc_maxcost = 0;
+	benchdata.gc_totalcost = 0;
 
 	LUA_ETRACE("benchmark_enable", NULL, 0);
 }
@@ -9885,7 +9974,77 @@ static int getbenchvals(lua_State* ctx)
 		i = (i + 1) % bench_sz;
 	}
 
-	LUA_ETRACE("benchmark_data", NULL, 6);
+	lua_newtable(ctx);
+	top = lua_gettop(ctx);
+	tblnum(ctx, "steps", benchdata.gc_steps, top);
+	tblnum(ctx, "cycles", benchdata.gc_cycles, top);
+	tblnum(ctx, "forced", benchdata.gc_forced, top);
+	tblnum(ctx, "last", benchdata.gc_lastcost, top);
+	tblnum(ctx, "max", benchdata.gc_maxcost, top);
+	tblnum(ctx, "total", benchdata.gc_totalcost, top);
+	tblnum(ctx, "heap", lua_gc(ctx, LUA_GCCOUNT, 0), top);
+
+	LUA_ETRACE("benchmark_data", NULL, 7);
+}
+
+static int benchtrace(lua_State* ctx)
+{
+	LUA_TRACE("benchmark_trace");
+
+	size_t n_entries = 0;
+	if (lua_type(ctx, 1) == LUA_TBOOLEAN)
+		n_entries = lua_toboolean(ctx, 1) ? 4096 : 0;
+	else{
+		ssize_t num = luaL_optnumber(ctx, 1, 4096);
+		if (num < 0)
+			arcan_fatal("benchmark_trace(), invalid number of entries (%zd)\n", num);
+		n_entries = num;
+	}
+
+	lua_pushboolean(ctx, arcan_conductor_trace_enable(n_entries));
+	LUA_ETRACE("benchmark_trace", NULL, 1);
+}
+
+static int benchtraceexport(lua_State* ctx)
+{
+	LUA_TRACE("benchmark_trace_export");
+
+	const char* instr = luaL_checkstring(ctx, 1);
+	const char* fmtstr = luaL_optstring(ctx, 2, "chrome");
+	enum conductor_trace_format fmt;
+
+	if (strcmp(fmtstr, "csv") == 0)
+		fmt = CONDUCTOR_TRACE_CSV;
+	else if (strcmp(fmtstr, "chrome") == 0)
+		fmt = CONDUCTOR_TRACE_CHROME;
+	else
+		arcan_fatal("benchmark_trace_export(), unknown format (%s), "
+			"accepted: csv, chrome\n", fmtstr);
+
+	char* fname = findresource(instr, RESOURCE_APPL_TEMP);
+	if (fname){
+		arcan_warning("benchmark_trace_export(), "
+			"refuses to overwrite existing file (%s)\n", fname);
+		arcan_mem_free(fname);
+		lua_pushboolean(ctx, false);
+		LUA_ETRACE("benchmark_trace_export", "file exists", 1);
+	}
+
+	bool res = false;
+	fname = arcan_expand_resource(instr, RESOURCE_APPL_TEMP);
+	FILE* outf;
+
+	if (fname && (outf = fopen(fname, "w+"))){
+		res = arcan_conductor_trace_export(outf, fmt);
+		fclose(outf);
+	}
+	else
+		arcan_warning("benchmark_trace_export(), "
+			"couldn't open (%s) for writing.\n", instr);
+
+	arcan_mem_free(fname);
+	lua_pushboolean(ctx, res);
+	LUA_ETRACE("benchmark_trace_export", NULL, 1);
 }
 
 static int timestamp(lua_State* ctx)
@@ -10304,6 +10463,15 @@ static int settexfilter(lua_State* ctx)
 	LUA_ETRACE("switch_default_texfilter", NULL, 0);
 }
 
+static int setdefatlas(lua_State* ctx)
+{
+	LUA_TRACE("switch_default_atlas");
+
+	arcan_video_default_atlas(luaL_optbnumber(ctx, 1, true));
+
+	LUA_ETRACE("switch_default_atlas", NULL, 0);
+}
+
 static int changetexfilter(lua_State* ctx)
 {
 	LUA_TRACE("image_texfilter");
@@ -10932,6 +11100,7 @@ static int net_pushcl(lua_State* ctx)
 				"with the network connection as destination");
 		}
 
+		arcan_vint_atlas_release(dvobj, true);
 		if (!dvobj->vstore->txmapped)
 			arcan_fatal("net_pushcl() with an image as source only works for "
 				"texture mapped objects.");
@@ -11314,6 +11483,7 @@ static const luaL_Reg tgtfuns[] = {
 {"rendertarget_detach",        renderdetach             },
 {"rendertarget_attach",        renderattach             },
 {"rendertarget_noclear",       rendernoclear            },
+{"rendertarget_statesort",     renderstatesort          },
 {"rendertarget_reconfigure",   renderreconf             },
 {"rendertarget_id",            rendertargetid           },
 {"rendertarget_range",         rendertargetrange        },
@@ -11492,6 +11662,8 @@ static const luaL_Reg sysfuns[] = {
 {"benchmark_enable",    togglebench      },
 {"benchmark_timestamp", timestamp        },
 {"benchmark_data",      getbenchvals     },
+{"benchmark_trace",     benchtrace       },
+{"benchmark_trace_export", benchtraceexport },
 {"system_identstr",     getidentstr      },
 {"system_defaultfont",  setdefaultfont   },
 #ifdef _DEBUG
@@ -11533,6 +11705,7 @@ static const luaL_Reg vidsysfuns[] = {
 {"switch_default_texmode",           settexmode     },
 {"switch_default_imageproc",         setimageproc   },
 {"switch_default_texfilter",         settexfilter   },
+{"switch_default_atlas",             setdefatlas    },
 {"set_context_attachment",           setdefattach   },
 {"resize_video_canvas",              videocanvasrsz },
 {"video_displaymodes",               videodisplay   },
@@ -12135,7 +12308,7 @@ static void dump_vobject(FILE* dst, arcan_vobject* src)
 (int) src->order,
 (int) src->lifetime,
 (int) src->cellid,
-(int) src->valid_cache,
+(int) src->hot->valid_cache,
 (int) src->rotate_state,
 (int) (src->frameset ? src->frameset->n_frames : -1),
 src->frameset ? lut_framemode(src->frameset->mode) : "",
@@ -12221,7 +12394,7 @@ vobj.glstore_refc = %zu;\n", src->vstore->vinf.text.glid,
 
 	dump_vstate(dst, src);
 	fprintf(dst, "props = {};\n");
-	dump_props(dst, src->current);
+	dump_props(dst, src->hot->current);
 	fprintf(dst, "vobj.props = props;\n");
 
 	free(mask);
@@ -12300,11 +12473,8 @@ ctx.vobjs[vobj.cellid] = vobj;\n", (long int)vid_toluavid(i));
 			fprintf(dst, "\
 local rtgt = {\n\
 	attached = {");
-			struct arcan_vobject_litem* first = rtgt->first;
-			while(first){
-				fprintf(dst, "%" PRIxVOBJ", ", first->elem->cellid);
-				first = first->next;
-			}
+			for (size_t j = 0; j < rtgt->n_items; j++)
+				fprintf(dst, "%" PRIxVOBJ", ", rtgt->items[j].elem->cellid);
 			fprintf(dst, "},\n\
 color_id = %" PRIxVOBJ",\n"
 #ifdef _DEBUG
@@ -33,6 +33,20 @@ void arcan_lua_cbdrop();
 void arcan_lua_shutdown(struct arcan_luactx*);
 void arcan_lua_tick(struct arcan_luactx*, size_t, size_t);
 
+/*
+ * Incremental garbage collection driven by the conductor. The automatic
+ * collector is left running, but with a high pause so that it only acts as
+ * a safety net.
+ *
+ * With a [budget] (microseconds), steps are taken until the budget is spent
+ * or the cycle completes, as long as a cycle is in progress or the heap has
+ * grown enough to warrant starting one. A budget of 0 is used outside of idle
+ * windows and only steps if the heap has grown well past the last cycle, to
+ * catch up after composition. Returns true if a collection cycle was
+ * completed.
+ */
+bool arcan_lua_gcstep(struct arcan_luactx* ctx, unsigned budget);
+
 /* add a set of wrapper functions exposing arcan_video and friends
  * to the Lua state, debugfuncs corresponds to desired debug level / behavior */
 arcan_errc arcan_lua_exposefuncs(struct arcan_luactx* dst,
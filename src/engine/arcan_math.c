@@ -531,6 +531,15 @@ vector interp_3d_sine(vector sv, vector ev, float fract)
 	return res;
 }
 
+#ifndef ARCAN_MATH_SIMD
+void interp_lanes(float* restrict dst, const float* restrict sv,
+	const float* restrict ev, const float* restrict w, size_t n)
+{
+	for (size_t i = 0; i < n * 4; i++)
+		dst[i] = sv[i] + (ev[i] - sv[i]) * w[i >> 2];
+}
+#endif
+
 static inline quat slerp_quatfl(quat a, quat b, float fact, bool r360)
 {
 	float weight_a, weight_b;
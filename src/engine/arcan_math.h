@@ -113,6 +113,13 @@ vector interp_3d_expin(vector startv, vector endv, float fract);
 vector interp_3d_expinout(vector startv, vector endv, float fract);
 vector interp_3d_smoothstep(vector startv, vector endv, float fract);
 
+/* batch form of the interpolators above, [n] lanes of 4-float start/end
+ * pairs (16b aligned) with per-lane weights already shaped by the
+ * interpolation function, i.e. interp_1d_*(0.0, 1.0, fract):
+ * dst[i] = sv[i] + (ev[i] - sv[i]) * w[i] */
+void interp_lanes(float* restrict dst, const float* restrict sv,
+	const float* restrict ev, const float* restrict w, size_t n);
+
 void update_view(orientation* dst, float roll, float pitch, float yaw);
 
 /* camera / view functions */
@@ -150,3 +150,37 @@ void multiply_matrix(float* restrict dst,
 #endif
 }
 
+
+void interp_lanes(float* restrict dst, const float* restrict sv,
+	const float* restrict ev, const float* restrict w, size_t n)
+{
+	assert((uintptr_t)dst % 16 == 0);
+	assert((uintptr_t)sv % 16 == 0);
+	assert((uintptr_t)ev % 16 == 0);
+	size_t i = 0;
+
+/* four lanes per weight load, then broadcast each weight with a shuffle */
+	for (; i + 4 <= n; i += 4){
+		const __m128 wv = _mm_loadu_ps(&w[i]);
+		const __m128 ws[4] = {
+			_mm_shuffle_ps(wv, wv, _MM_SHUFFLE(0, 0, 0, 0)),
+			_mm_shuffle_ps(wv, wv, _MM_SHUFFLE(1, 1, 1, 1)),
+			_mm_shuffle_ps(wv, wv, _MM_SHUFFLE(2, 2, 2, 2)),
+			_mm_shuffle_ps(wv, wv, _MM_SHUFFLE(3, 3, 3, 3))
+		};
+
+		for (size_t j = 0; j < 4; j++){
+			size_t ofs = (i + j) * 4;
+			__m128 s = _mm_load_ps(&sv[ofs]);
+			__m128 d = _mm_sub_ps(_mm_load_ps(&ev[ofs]), s);
+			_mm_store_ps(&dst[ofs], _mm_add_ps(s, _mm_mul_ps(d, ws[j])));
+		}
+	}
+
+	for (; i < n; i++){
+		size_t ofs = i * 4;
+		__m128 s = _mm_load_ps(&sv[ofs]);
+		__m128 d = _mm_sub_ps(_mm_load_ps(&ev[ofs]), s);
+		_mm_store_ps(&dst[ofs], _mm_add_ps(s, _mm_mul_ps(d, _mm_set1_ps(w[i]))));
+	}
+}
@@ -204,6 +204,21 @@ void arcan_mem_unlock(void*);
  */
 void arcan_mem_tick();
 
+/*
+ * implemented in <platform>/mem.c
+ * per-type allocation counters. [dealloc_cnt] and [in_use] (bytes) are
+ * only tracked for blocks that come from a pool, [pooled] is the number of
+ * bytes held by the pools of that type (slabs, buffers kept for reuse).
+ * Returns false if the platform doesn't keep track.
+ */
+struct arcan_memstat {
+	size_t alloc_cnt;
+	size_t dealloc_cnt;
+	size_t in_use;
+	size_t pooled;
+};
+bool arcan_mem_stat(enum arcan_memtypes, struct arcan_memstat*);
+
 /*
  * implemented in <platform>/mem.c
  * aggregates a mem_alloc and a mem_copy from a source buffer.
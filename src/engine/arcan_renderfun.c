@@ -16,11 +16,23 @@
 #include <math.h>
 #include <unistd.h>
 #include <assert.h>
+#include <pthread.h>
+#include <stdatomic.h>
 
 #ifndef ARCAN_FONT_CACHE_LIMIT
 #define ARCAN_FONT_CACHE_LIMIT 8
 #endif
 
+/* output size (in pixels) where stretchblit splits the work into row
+ * bands resampled on separate threads */
+#ifndef ARCAN_STRETCH_PARALLEL_LIMIT
+#define ARCAN_STRETCH_PARALLEL_LIMIT (1024 * 1024)
+#endif
+
+#ifndef ARCAN_STRETCH_BANDS
+#define ARCAN_STRETCH_BANDS 8
+#endif
+
 #define ARCAN_TTF
 
 #include "arcan_math.h"
@@ -398,19 +410,15 @@ static void text_loadimage(struct text_format* dst,
 	}
 
 	struct arcan_img_meta meta = {0};
-	uint32_t* imgbuf; /* set in _decode */
+	av_pixel* imgbuf = NULL; /* set in _decode */
 	size_t inw, inh;
 
-	arcan_errc rv = arcan_img_decode(infn, inmem.ptr,
+	arcan_errc rv = arcan_img_decode_native(infn, inmem.ptr,
 		inmem.sz, &imgbuf, &inw, &inh, &meta, false);
 
 	arcan_release_map(inmem);
 	arcan_release_resource(&inres);
 
-/* repack if the system format doesn't match */
-	if (imgbuf)
-		imgbuf = arcan_img_repack(imgbuf, inw, inh);
-
 	if (!imgbuf || rv != ARCAN_OK)
 		return;
 
@@ -575,6 +583,9 @@ static char* extract_vidref(struct text_format* prev, char* base, bool ext)
 		return NULL;
 	}
 
+/* the pixels are read from the store directly, so move out of any atlas */
+	arcan_vint_atlas_release(vobj, true);
+
 	struct agp_vstore* vs = vobj->vstore;
 	if (vs->txmapped != TXSTATE_TEX2D){
 		arcan_warning(
@@ -1382,30 +1393,123 @@ av_pixel* arcan_renderfun_renderfmtstr(const char* message,
 	return raw;
 }
 
-int arcan_renderfun_stretchblit(char* src, int inw, int inh,
-	uint32_t* dst, size_t dstw, size_t dsth, int flipv)
+struct stretch_band {
+	const char* src;
+	int inw, inh;
+	uint32_t* dst;
+	size_t dstw, dsth;
+	size_t y0, y1;
+	bool flipv;
+	int rc;
+};
+
+/*
+ * Resample the output rows [y0, y1) only. The scale is that of the full
+ * output and the offset places the band, so the filter taps (and the
+ * result) are identical to a single pass over the whole image.
+ */
+static void* stretch_band(void* arg)
 {
-	const int pack_tight = 0;
+	struct stretch_band* band = arg;
 	const int rgba_ch = 4;
 
-	if (1 != stbir_resize_uint8((unsigned char*)src,
-		inw, inh, pack_tight, (unsigned char*)dst, dstw, dsth, pack_tight, rgba_ch))
+/* flip by having the resampler write rows bottom-up instead of swapping
+ * them afterwards */
+	uint32_t* out = &band->dst[band->y0 * band->dstw];
+	int out_stride = band->dstw * rgba_ch;
+	if (band->flipv){
+		out = &band->dst[(band->dsth - 1 - band->y0) * band->dstw];
+		out_stride = -out_stride;
+	}
+
+	band->rc = stbir_resize_subpixel(band->src, band->inw, band->inh, 0,
+		out, band->dstw, band->y1 - band->y0, out_stride,
+		STBIR_TYPE_UINT8, rgba_ch, -1, 0,
+		STBIR_EDGE_CLAMP, STBIR_EDGE_CLAMP,
+		STBIR_FILTER_DEFAULT, STBIR_FILTER_DEFAULT,
+		STBIR_COLORSPACE_LINEAR, NULL,
+		(float) band->dstw / band->inw, (float) band->dsth / band->inh,
+		0, band->y0
+	);
+
+	return NULL;
+}
+
+/*
+ * Helper threads across all concurrent stretchblits (the loader workers call
+ * this in parallel), a call only gets the cores that neither the loaders nor
+ * other calls are using, and runs single-threaded when there are none.
+ */
+static _Atomic size_t stretch_helpers;
+
+static size_t reserve_helpers(size_t want)
+{
+	long ncpu = sysconf(_SC_NPROCESSORS_ONLN);
+	size_t busy = arcan_vint_loaderbusy() + 1;
+	size_t cur = atomic_load(&stretch_helpers);
+	size_t n;
+
+	do {
+		size_t used = busy + cur;
+		n = ncpu > 0 && (size_t) ncpu > used ? ncpu - used : 0;
+		if (n > want)
+			n = want;
+		if (!n)
+			return 0;
+	} while (!atomic_compare_exchange_weak(&stretch_helpers, &cur, cur + n));
+
+	return n;
+}
+
+int arcan_renderfun_stretchblit(char* src, int inw, int inh,
+	uint32_t* dst, size_t dstw, size_t dsth, int flipv)
+{
+	if (!dsth || !dstw || inw <= 0 || inh <= 0)
 		return -1;
 
+	struct stretch_band bands[ARCAN_STRETCH_BANDS];
+	pthread_t threads[ARCAN_STRETCH_BANDS];
 
-	if (!flipv)
-		return 1;
+/* small outputs aren't worth the thread setup */
+	size_t helpers = 0;
+	if (dstw * dsth >= ARCAN_STRETCH_PARALLEL_LIMIT){
+		size_t want = ARCAN_STRETCH_BANDS - 1;
+		if (want > dsth - 1)
+			want = dsth - 1;
+		helpers = reserve_helpers(want);
+	}
+	size_t n_bands = helpers + 1;
 
-	uint32_t row[dstw];
-	size_t stride = dstw * 4;
-	for (size_t y = 0; y < dsth >> 1; y++){
-		if (y == (dsth - 1 - y))
-			continue;
+	for (size_t i = 0; i < n_bands; i++){
+		bands[i] = (struct stretch_band){
+			.src = src, .inw = inw, .inh = inh,
+			.dst = dst, .dstw = dstw, .dsth = dsth,
+			.y0 = dsth * i / n_bands,
+			.y1 = dsth * (i + 1) / n_bands,
+			.flipv = flipv
+		};
+	}
 
-		memcpy(row, &dst[y*dstw], stride);
-		memcpy(&dst[y*dstw], &dst[(dsth-1-y)*dstw], stride);
-		memcpy(&dst[(dsth-1-y)*dstw], row, stride);
+/* the first band runs on the calling thread, and so does any band whose
+ * thread couldn't be created */
+	bool spawned[ARCAN_STRETCH_BANDS] = {false};
+	for (size_t i = 1; i < n_bands; i++)
+		spawned[i] = 0 == pthread_create(&threads[i], NULL, stretch_band, &bands[i]);
+
+	for (size_t i = 0; i < n_bands; i++)
+		if (!spawned[i])
+			stretch_band(&bands[i]);
+
+	int rv = 1;
+	for (size_t i = 0; i < n_bands; i++){
+		if (spawned[i])
+			pthread_join(threads[i], NULL);
+		if (1 != bands[i].rc)
+			rv = -1;
 	}
 
-	return 1;
+	if (helpers)
+		atomic_fetch_sub(&stretch_helpers, helpers);
+
+	return rv;
 }
@@ -126,7 +126,7 @@ void arcan_renderfun_reset_fontcache();
  * RGBA32 only for only, rather unoptimized
  * returns -1 or failure, 0 on success
  * blits src into dst, stretching to dstw, desth, optionally inverting
- * row-order.
+ * row-order. Large outputs are resampled in row bands on several threads.
  */
 int arcan_renderfun_stretchblit(char* src, int inw, int inh,
 	uint32_t* dst, size_t dstw, size_t dsth, int flipv);
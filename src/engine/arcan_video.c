@@ -25,6 +25,7 @@
 
 #include <pthread.h>
 #include <semaphore.h>
+#include <stdatomic.h>
 
 #define CLAMP(x, l, h) (((x) > (h)) ? (h) : (((x) < (l)) ? (l) : (x)))
 
@@ -47,6 +48,7 @@
 #include "arcan_videoint.h"
 #include "arcan_3dbase.h"
 #include "arcan_img.h"
+#include "arcan_conductor.h"
 
 #ifndef offsetof
 #define offsetof(type, member) ((size_t)((char*)&(*(type*)0).member\
@@ -59,7 +61,6 @@
 
 long long ARCAN_VIDEO_WORLDID = -1;
 static surface_properties empty_surface();
-static sem_handle asynchsynch;
 
 /* these match arcan_vinterpolant enum */
 static arcan_interp_3d_function lut_interp_3d[] = {
@@ -82,6 +83,7 @@ static arcan_interp_1d_function lut_interp_1d[] = {
 
 struct arcan_video_display arcan_video_display = {
 	.conservative = false,
+	.resolve_clock = 1,
 	.deftxs = ARCAN_VTEX_CLAMP, ARCAN_VTEX_CLAMP,
 	.scalemode = ARCAN_VIMAGE_NOPOW2,
 	.filtermode = ARCAN_VFILTER_BILINEAR,
@@ -104,6 +106,9 @@ struct arcan_video_context vcontext_stack[CONTEXT_STACK_LIMIT] = {
 		.nalive    = 0,
 		.world = {
 			.tracetag = "(world)",
+			.hot = &vcontext_stack[0].world_hot
+		},
+		.world_hot = {
 			.current  = {
 				.opa = 1.0,
 				.rotation.quaternion.w = 1.0
@@ -117,6 +122,11 @@ unsigned vcontext_ind = 0;
  * additional internal forwards that do not really belong to videoint.h
  */
 static bool detach_fromtarget(struct rendertarget* dst, arcan_vobject* src);
+static void items_free(struct rendertarget* tgt);
+static void ctx_activate(struct arcan_video_context*, arcan_vobject*);
+static void activate_object(arcan_vobject* vobj);
+static void drop_interp_lanes(arcan_vobject* vobj);
+static void active_free(struct arcan_video_context*);
 static void attach_object(struct rendertarget* dst, arcan_vobject* src);
 static arcan_errc update_zv(arcan_vobject* vobj, int newzv);
 static void rebase_transform(struct surface_transform*, int64_t);
@@ -179,6 +189,11 @@ void arcan_video_default_imageprocmode(enum arcan_imageproc_mode mode)
 	arcan_video_display.imageproc = mode;
 }
 
+void arcan_video_default_atlas(bool enable)
+{
+	arcan_video_display.atlas = enable;
+}
+
 struct rendertarget* arcan_vint_findrt_vstore(struct agp_vstore* st)
 {
 	if (!st)
@@ -206,6 +221,227 @@ struct rendertarget* arcan_vint_findrt(arcan_vobject* vobj)
 	return NULL;
 }
 
+static arcan_vobj_id rtid(struct rendertarget* tgt)
+{
+	if (tgt == &current_context->stdoutp)
+		return ARCAN_VIDEO_WORLDID;
+
+	return tgt->color ? tgt->color->cellid : ARCAN_EID;
+}
+
+arcan_vobj_id arcan_vint_rtid(arcan_vobject* vobj)
+{
+	if (!vobj || !vobj->owner)
+		return ARCAN_EID;
+
+	return rtid(vobj->owner);
+}
+
+/*
+ * Rendertarget dependency graph, nodes are the context rendertargets and the
+ * world output, an edge goes from a rendertarget to the ones that sample its
+ * output (an object in their pipeline uses its color store directly or as a
+ * frame) or draw its pipeline (linkrendertarget). This is only rebuilt when
+ * attachments, stores or rendertargets change.
+ */
+static struct rendertarget* rt_at(size_t ind)
+{
+	return ind == RENDERTARGET_LIMIT ?
+		&current_context->stdoutp : &current_context->rtargets[ind];
+}
+
+static size_t rt_index(struct rendertarget* tgt)
+{
+	return tgt == &current_context->stdoutp ?
+		RENDERTARGET_LIMIT : (size_t)(tgt - current_context->rtargets);
+}
+
+static void invalidate_rtgraph()
+{
+	current_context->rtgraph.valid = false;
+}
+
+static void add_rtedge(struct rendertarget* src, size_t dst)
+{
+	if (rt_index(src) == dst)
+		return;
+
+	for (size_t i = 0; i < src->n_consumers; i++)
+		if (src->consumers[i] == dst)
+			return;
+
+	src->consumers[src->n_consumers++] = dst;
+}
+
+static void add_rtshared(struct agp_vstore* store, size_t rt)
+{
+	struct arcan_video_context* ctx = current_context;
+	for (size_t i = 0; i < ctx->rtgraph.n_shared; i++)
+		if (ctx->rtgraph.shared[i].store == store &&
+			ctx->rtgraph.shared[i].rt == rt)
+			return;
+
+	if (ctx->rtgraph.n_shared == RTGRAPH_SHARED_LIMIT){
+		ctx->rtgraph.overflow = true;
+		return;
+	}
+
+	ctx->rtgraph.shared[ctx->rtgraph.n_shared].store = store;
+	ctx->rtgraph.shared[ctx->rtgraph.n_shared].rt = rt;
+	ctx->rtgraph.n_shared++;
+}
+
+static void sample_store(struct agp_vstore* store, arcan_vobject* elem, size_t rt)
+{
+	if (!store)
+		return;
+
+	if (store->refcount > 1)
+		add_rtshared(store, rt);
+
+/* only a shared store or the rendertarget object itself can sample the output */
+	if (store->refcount <= 1 && !FL_TEST(elem, FL_RTGT))
+		return;
+
+	for (size_t i = 0; i < current_context->n_rtargets; i++){
+		struct rendertarget* src = &current_context->rtargets[i];
+		if (src->color && src->color->vstore == store)
+			add_rtedge(src, rt);
+	}
+
+	if (current_context->world.vstore == store)
+		add_rtedge(&current_context->stdoutp, rt);
+}
+
+static void rebuild_rtgraph()
+{
+	struct arcan_video_context* ctx = current_context;
+	ctx->rtgraph.n_shared = 0;
+	ctx->rtgraph.overflow = false;
+
+	for (size_t i = 0; i < ctx->n_rtargets; i++)
+		ctx->rtargets[i].n_consumers = 0;
+	ctx->stdoutp.n_consumers = 0;
+
+	for (size_t i = 0; i <= ctx->n_rtargets; i++){
+		size_t ind = i == ctx->n_rtargets ? RENDERTARGET_LIMIT : i;
+		struct rendertarget* tgt = rt_at(ind);
+		struct rendertarget* base = tgt;
+
+		if (tgt->link){
+			add_rtedge(tgt->link, ind);
+			base = tgt->link;
+		}
+
+		for (size_t i = 0; i < base->n_items; i++){
+			arcan_vobject* elem = base->items[i].elem;
+			sample_store(elem->vstore, elem, ind);
+
+			if (elem->frameset)
+				for (size_t j = 0; j < elem->frameset->n_frames; j++)
+					sample_store(elem->frameset->frames[j].frame, elem, ind);
+		}
+	}
+
+/* topological order of the offscreen rendertargets, the world output is
+ * always drawn last, so anything sampling that will lag a frame behind.
+ * Rendertargets in a cycle are appended in creation order. */
+	uint8_t indeg[RENDERTARGET_LIMIT] = {0};
+	bool done[RENDERTARGET_LIMIT] = {false};
+	size_t n = 0;
+
+	for (size_t i = 0; i < ctx->n_rtargets; i++)
+		for (size_t j = 0; j < ctx->rtargets[i].n_consumers; j++)
+			if (ctx->rtargets[i].consumers[j] != RENDERTARGET_LIMIT)
+				indeg[ctx->rtargets[i].consumers[j]]++;
+
+	for (bool found = true; found;){
+		found = false;
+		for (size_t i = 0; i < ctx->n_rtargets; i++){
+			if (done[i] || indeg[i])
+				continue;
+
+			done[i] = found = true;
+			ctx->rtgraph.order[n++] = i;
+			for (size_t j = 0; j < ctx->rtargets[i].n_consumers; j++)
+				if (ctx->rtargets[i].consumers[j] != RENDERTARGET_LIMIT)
+					indeg[ctx->rtargets[i].consumers[j]]--;
+		}
+	}
+
+	for (size_t i = 0; i < ctx->n_rtargets; i++)
+		if (!done[i])
+			ctx->rtgraph.order[n++] = i;
+
+	ctx->rtgraph.valid = true;
+}
+
+/* mirrors the early-out in process_rendertarget */
+static bool rendertarget_dirty(struct rendertarget* tgt)
+{
+	if (arcan_video_display.ignore_dirty > 0 ||
+		tgt->dirtyc > 0 || tgt->transfc > 0)
+		return true;
+
+	return tgt->link && (tgt->link->dirtyc > 0 || tgt->link->transfc > 0);
+}
+
+/* dirty that can't be narrowed down to objects in the pipeline */
+static void invalidate_rendertarget(struct rendertarget* tgt)
+{
+	tgt->dirtyc++;
+	tgt->full_redraw = true;
+}
+
+/* contents of [tgt] have been updated, forward to its consumers */
+static void rendertarget_drawn(struct rendertarget* tgt)
+{
+	for (size_t i = 0; i < tgt->n_consumers; i++)
+		invalidate_rendertarget(rt_at(tgt->consumers[i]));
+}
+
+void arcan_vint_pickdirty()
+{
+	arcan_video_display.pick_epoch++;
+}
+
+void arcan_vint_flagdirty(arcan_vobject* vobj)
+{
+	struct arcan_video_context* ctx = current_context;
+/* global dirty is mostly content (uploads, shader state), anything that
+ * changes geometry or order bumps the pick epoch on its own */
+	if (!vobj){
+		arcan_video_display.dirty++;
+		return;
+	}
+
+/* the store is used elsewhere, dirty everything that samples it, atlas
+ * pages are shared but the regions are not so those are left alone */
+	if (vobj->vstore && vobj->vstore->refcount > 1 && !vobj->atlas){
+		if (!ctx->rtgraph.valid || ctx->rtgraph.overflow){
+			arcan_video_display.dirty++;
+			return;
+		}
+
+		for (size_t i = 0; i < ctx->rtgraph.n_shared; i++)
+			if (ctx->rtgraph.shared[i].store == vobj->vstore)
+				invalidate_rendertarget(rt_at(ctx->rtgraph.shared[i].rt));
+	}
+
+/* not attached or attached to several rendertargets, we don't know where,
+ * rendertarget objects also count what is attached to them so go by owner */
+	if (!vobj->owner ||
+		(vobj->extrefc.attachments > 1 && !FL_TEST(vobj, FL_RTGT))){
+		if (vobj->owner || !vobj->vstore ||
+			vobj->vstore->refcount <= 1 || vobj->atlas)
+			arcan_video_display.dirty++;
+		return;
+	}
+
+	vobj->damage.changed = true;
+	vobj->owner->dirtyc++;
+}
+
 static void addchild(arcan_vobject* parent, arcan_vobject* child)
 {
 	arcan_vobject** slot = NULL;
@@ -249,11 +485,17 @@ static void addchild(arcan_vobject* parent, arcan_vobject* child)
 static void invalidate_cache(arcan_vobject* vobj)
 {
 	FLAG_DIRTY(vobj);
+	arcan_vint_pickdirty();
 
-	if (!vobj->valid_cache)
+/* descendants compare generations, they don't need to be swept for this,
+ * but nothing resolved before the change can be trusted on this clock */
+	vobj->hot->stamp = 0;
+	arcan_video_display.resolve_clock++;
+
+	if (!vobj->hot->valid_cache)
 		return;
 
-	vobj->valid_cache = false;
+	vobj->hot->valid_cache = false;
 
 	for (size_t i = 0; i < vobj->childslots; i++)
 		if (vobj->children[i])
@@ -306,7 +548,11 @@ static void deallocate_gl_context(
 /* pool is dynamically sized and size is set on layer push */
 	if (del){
 		arcan_mem_free(context->vitems_pool);
+		arcan_mem_free(context->hot_pool);
 		context->vitems_pool = NULL;
+		context->hot_pool = NULL;
+		items_free(&context->stdoutp);
+		active_free(context);
 	}
 }
 
@@ -341,6 +587,9 @@ static void reallocate_gl_context(struct arcan_video_context* context)
 		context->vitems_pool = arcan_alloc_mem(
 			sizeof(struct arcan_vobject) * context->vitem_limit,
 				ARCAN_MEM_VSTRUCT, ARCAN_MEM_BZERO, ARCAN_MEMALIGN_NATURAL);
+		context->hot_pool = arcan_alloc_mem(
+			sizeof(struct vobject_hot) * context->vitem_limit,
+				ARCAN_MEM_VSTRUCT, ARCAN_MEM_BZERO, ARCAN_MEMALIGN_SIMD);
 	}
 	else for (size_t i = 1; i < context->vitem_limit; i++)
 		if (FL_TEST(&(context->vitems_pool[i]), FL_INUSE)){
@@ -369,7 +618,7 @@ static void reallocate_gl_context(struct arcan_video_context* context)
 				arcan_mem_free(fname);
 			}
 			else
-				if (current->vstore->txmapped != TXSTATE_OFF)
+				if (current->vstore->txmapped != TXSTATE_OFF && !current->atlas)
 					agp_update_vstore(current->vstore, true);
 
 			arcan_frameserver* fsrv = current->feed.state.ptr;
@@ -420,9 +669,13 @@ static void push_transfer_persists(
 
 		detach_fromtarget(srcobj->owner, srcobj);
 		memcpy(dstobj, srcobj, sizeof(arcan_vobject));
+		dstobj->hot = &dst->hot_pool[i];
+		*dstobj->hot = *srcobj->hot;
 		dst->nalive++; /* fake allocate */
 		dstobj->parent = &dst->world; /* don't cross- reference worlds */
 		attach_object(&dst->stdoutp, dstobj);
+		FL_CLEAR(dstobj, FL_ACTIVE);
+		ctx_activate(dst, dstobj);
 		trace("vcontext_stack_push() : transfer-attach: %s\n", srcobj->tracetag);
 	}
 }
@@ -444,13 +697,24 @@ static void pop_transfer_persists(
 			continue;
 
 		arcan_vobject* parent = dstobj->parent;
+		bool listed = FL_TEST(dstobj, FL_ACTIVE);
 
 		detach_fromtarget(srcobj->owner, srcobj);
 		src->nalive--;
 
 		memcpy(dstobj, srcobj, sizeof(arcan_vobject));
+		dstobj->hot = &dst->hot_pool[i];
+		*dstobj->hot = *srcobj->hot;
 		attach_object(&dst->stdoutp, dstobj);
 		dstobj->parent = parent;
+
+/* the shadow might already have an entry in the destination set */
+		if (listed)
+			FL_SET(dstobj, FL_ACTIVE);
+		else {
+			FL_CLEAR(dstobj, FL_ACTIVE);
+			ctx_activate(dst, dstobj);
+		}
 		memset(srcobj, '\0', sizeof(arcan_vobject));
 	}
 }
@@ -599,13 +863,16 @@ void arcan_vint_drawcursor(bool erase)
 
 signed arcan_video_pushcontext()
 {
-	arcan_vobject empty_vobj = {
+	struct vobject_hot empty_hot = {
 		.current = {
 			.position = {0},
 			.opa = 1.0,
 			.scale = {.x = 1.0, .y = 1.0, .z = 1.0},
 			.rotation.quaternion = default_quat
-		},
+		}
+	};
+
+	arcan_vobject empty_vobj = {
 /* we transfer the vstore over as that will be used as a
  * container for the main display FBO */
 		.vstore = current_context->world.vstore
@@ -626,11 +893,18 @@ signed arcan_video_pushcontext()
 	}
 
 	current_context = &vcontext_stack[ vcontext_ind ];
-	current_context->stdoutp.first = NULL;
+	current_context->stdoutp.items = NULL;
+	current_context->stdoutp.n_items = current_context->stdoutp.items_limit = 0;
+	current_context->active = NULL;
+	current_context->n_active = current_context->active_limit = 0;
+	memset(&current_context->stdoutp.pick, '\0',
+		sizeof(current_context->stdoutp.pick));
 	current_context->vitem_ofs = 1;
 	current_context->nalive = 0;
 
 	current_context->world = empty_vobj;
+	current_context->world_hot = empty_hot;
+	current_context->world.hot = &current_context->world_hot;
 	current_context->stdoutp.refreshcnt = 1;
 	current_context->stdoutp.refresh = 1;
 	current_context->stdoutp.vppcm = current_context->stdoutp.hppcm = 28;
@@ -641,12 +915,22 @@ signed arcan_video_pushcontext()
 		sizeof(struct arcan_vobject) * current_context->vitem_limit,
 		ARCAN_MEM_VSTRUCT, ARCAN_MEM_BZERO, ARCAN_MEMALIGN_NATURAL
 	);
+	current_context->hot_pool = arcan_alloc_mem(
+		sizeof(struct vobject_hot) * current_context->vitem_limit,
+		ARCAN_MEM_VSTRUCT, ARCAN_MEM_BZERO, ARCAN_MEMALIGN_SIMD
+	);
 
-	current_context->rtargets[0].first = NULL;
+	current_context->rtargets[0].items = NULL;
+	current_context->rtargets[0].n_items = 0;
+	current_context->rtargets[0].items_limit = 0;
+	memset(&current_context->rtargets[0].pick, '\0',
+		sizeof(current_context->rtargets[0].pick));
 
 /* propagate persistent flagged objects upwards */
 	push_transfer_persists(
 		&vcontext_stack[ vcontext_ind - 1], current_context);
+	invalidate_rtgraph();
+	arcan_vint_pickdirty();
 	FLAG_DIRTY(NULL);
 
 	return arcan_video_nfreecontexts();
@@ -776,6 +1060,7 @@ clense:
 		vobj->feed.ffunc = alim[i].ffunc;
 		vobj->origw = alim[i].origw;
 		vobj->origh = alim[i].origh;
+		activate_object(vobj);
 /*		vobj->order = alim[i].zv;
 		vobj->blendmode = BLEND_NORMAL; */
 		vobj->tracetag = alim[i].tracetag;
@@ -899,6 +1184,9 @@ unsigned arcan_video_popcontext()
 	}
 
 	reallocate_gl_context(current_context);
+	arcan_vint_atlas_restore(vcontext_ind);
+	invalidate_rtgraph();
+	arcan_vint_pickdirty();
 	FLAG_DIRTY(NULL);
 
 	return (CONTEXT_STACK_LIMIT - 1) - vcontext_ind;
@@ -953,6 +1241,7 @@ arcan_errc arcan_video_resampleobject(arcan_vobj_id vid,
 	if (vobj->vstore->txmapped != TXSTATE_TEX2D)
 		return ARCAN_ERRC_UNACCEPTED_STATE;
 
+	arcan_vint_atlas_release(vobj, true);
 	arcan_vobj_id xfer = arcan_video_nullobject(neww, newh, 0);
 	if (xfer == ARCAN_EID)
 		return ARCAN_ERRC_OUT_OF_SPACE;
@@ -977,6 +1266,7 @@ arcan_errc arcan_video_resampleobject(arcan_vobj_id vid,
 		}
 
 		bool is_rtgt = arcan_vint_findrt(dvobj) != NULL;
+		arcan_vint_atlas_release(dvobj, true);
 		if (vobj->vstore->txmapped != TXSTATE_TEX2D){
 			arcan_video_deleteobject(xfer);
 			return ARCAN_ERRC_UNACCEPTED_STATE;
@@ -1057,6 +1347,7 @@ arcan_errc arcan_video_mipmapset(arcan_vobj_id vid, bool enable)
 	if (!vobj)
 		return ARCAN_ERRC_NO_SUCH_OBJECT;
 
+	arcan_vint_atlas_release(vobj, true);
 	if (vobj->vstore->txmapped != TXSTATE_TEX2D ||
 		!vobj->vstore->vinf.text.raw)
 		return ARCAN_ERRC_UNACCEPTED_STATE;
@@ -1157,6 +1448,8 @@ static arcan_vobject* new_vobject(arcan_vobj_id* id,
 		return NULL;
 
 	rv = dctx->vitems_pool + fid;
+	rv->hot = dctx->hot_pool + fid;
+	memset(rv->hot, '\0', sizeof(struct vobject_hot));
 	rv->order = 0;
 	populate_vstore(&rv->vstore);
 
@@ -1164,22 +1457,22 @@ static arcan_vobject* new_vobject(arcan_vobj_id* id,
 	rv->childslots = 0;
 	rv->children = NULL;
 
-	rv->valid_cache = false;
+	rv->hot->valid_cache = false;
 
 	rv->blendmode = BLEND_NORMAL;
 	rv->clip = ARCAN_CLIP_OFF;
 
-	rv->current.scale.x = 1.0;
-	rv->current.scale.y = 1.0;
-	rv->current.scale.z = 1.0;
+	rv->hot->current.scale.x = 1.0;
+	rv->hot->current.scale.y = 1.0;
+	rv->hot->current.scale.z = 1.0;
 
-	rv->current.position.x = 0;
-	rv->current.position.y = 0;
-	rv->current.position.z = 0;
+	rv->hot->current.position.x = 0;
+	rv->hot->current.position.y = 0;
+	rv->hot->current.position.z = 0;
 
-	rv->current.rotation.quaternion = default_quat;
+	rv->hot->current.rotation.quaternion = default_quat;
 
-	rv->current.opa = 0.0;
+	rv->hot->current.opa = 0.0;
 
 	rv->cellid = fid;
 	assert(rv->cellid > 0);
@@ -1214,9 +1507,254 @@ arcan_vobject* arcan_video_getobject(arcan_vobj_id id)
 	return rc;
 }
 
+/*
+ * Pipeline helpers, the items array is kept sorted on order with the last
+ * attached object last among equals and a terminating NULL entry. Lookups
+ * are binary searches, the [skip] index is treated as if it wasn't there
+ * so that an entry can be repositioned without removing it first.
+ */
+static inline arcan_vobject* item_at(
+	struct rendertarget* tgt, size_t ind, size_t skip)
+{
+	return tgt->items[ind < skip ? ind : ind + 1].elem;
+}
+
+static size_t items_lower(struct rendertarget* tgt, int order, size_t skip)
+{
+	size_t lo = 0, hi = tgt->n_items - (skip < tgt->n_items);
+	while (lo < hi){
+		size_t mid = lo + ((hi - lo) >> 1);
+		if (item_at(tgt, mid, skip)->order < order)
+			lo = mid + 1;
+		else
+			hi = mid;
+	}
+	return lo;
+}
+
+static size_t items_upper(struct rendertarget* tgt, int order, size_t skip)
+{
+	size_t lo = 0, hi = tgt->n_items - (skip < tgt->n_items);
+	while (lo < hi){
+		size_t mid = lo + ((hi - lo) >> 1);
+		if (item_at(tgt, mid, skip)->order <= order)
+			lo = mid + 1;
+		else
+			hi = mid;
+	}
+	return lo;
+}
+
+/* index of [elem] in the pipeline of [tgt] or n_items if it isn't there */
+static size_t items_find(struct rendertarget* tgt, arcan_vobject* elem)
+{
+	for (size_t i = items_lower(tgt, elem->order, SIZE_MAX);
+		i < tgt->n_items && tgt->items[i].elem->order == elem->order; i++)
+		if (tgt->items[i].elem == elem)
+			return i;
+
+/* order changed while attached, shouldn't happen but don't lose track */
+	for (size_t i = 0; i < tgt->n_items; i++)
+		if (tgt->items[i].elem == elem)
+			return i;
+
+	return tgt->n_items;
+}
+
+/* where [src] should go, normally after all objects of the same order, but
+ * with state sorting after the last of those with the same store / program */
+static size_t items_insertion(
+	struct rendertarget* tgt, arcan_vobject* src, size_t skip)
+{
+	size_t ind = items_upper(tgt, src->order, skip);
+	if (!FL_TEST(tgt, TGTFL_STATESORT))
+		return ind;
+
+	for (size_t i = ind; i > 0; i--){
+		arcan_vobject* cur = item_at(tgt, i - 1, skip);
+		if (cur->order != src->order)
+			break;
+
+		if (cur->vstore == src->vstore && cur->program == src->program)
+			return i;
+	}
+
+	return ind;
+}
+
+static void items_insert(
+	struct rendertarget* tgt, size_t ind, arcan_vobject* src)
+{
+/* room for the new entry and the terminator */
+	if (tgt->n_items + 2 > tgt->items_limit){
+		size_t limit = tgt->items_limit ? tgt->items_limit * 2 : 64;
+		arcan_vobject_litem* items = arcan_alloc_mem(
+			sizeof(arcan_vobject_litem) * limit,
+			ARCAN_MEM_VSTRUCT, ARCAN_MEM_BZERO, ARCAN_MEMALIGN_NATURAL
+		);
+
+		if (tgt->items){
+			memcpy(items, tgt->items,
+				sizeof(arcan_vobject_litem) * (tgt->n_items + 1));
+			arcan_mem_free(tgt->items);
+		}
+
+		tgt->items = items;
+		tgt->items_limit = limit;
+	}
+
+	memmove(&tgt->items[ind + 1], &tgt->items[ind],
+		sizeof(arcan_vobject_litem) * (tgt->n_items - ind + 1));
+	tgt->items[ind].elem = src;
+	tgt->n_items++;
+	arcan_vint_pickdirty();
+}
+
+static void items_remove(struct rendertarget* tgt, size_t ind)
+{
+	memmove(&tgt->items[ind], &tgt->items[ind + 1],
+		sizeof(arcan_vobject_litem) * (tgt->n_items - ind));
+	tgt->n_items--;
+	arcan_vint_pickdirty();
+}
+
+static void items_free(struct rendertarget* tgt)
+{
+	arcan_mem_free(tgt->items);
+	tgt->items = NULL;
+	tgt->n_items = tgt->items_limit = 0;
+
+/* the pick index only refers to the pipeline, so goes with it */
+	arcan_mem_free(tgt->pick.cells);
+	arcan_mem_free(tgt->pick.refs);
+	arcan_mem_free(tgt->pick.dynamic);
+	memset(&tgt->pick, '\0', sizeof(tgt->pick));
+}
+
+static void items_slide(
+	struct rendertarget* tgt, size_t src, arcan_vobject* elem)
+{
+	size_t dst = items_insertion(tgt, elem, src);
+	if (dst < src)
+		memmove(&tgt->items[dst + 1], &tgt->items[dst],
+			sizeof(arcan_vobject_litem) * (src - dst));
+	else if (dst > src)
+		memmove(&tgt->items[src], &tgt->items[src + 1],
+			sizeof(arcan_vobject_litem) * (dst - src));
+	tgt->items[dst].elem = elem;
+	invalidate_rendertarget(tgt);
+	arcan_vint_pickdirty();
+}
+
+/* binary only variant of items_find, for probing pipelines that most likely
+ * do not have [elem] in them */
+static bool items_contains(struct rendertarget* tgt, arcan_vobject* elem)
+{
+	for (size_t i = items_lower(tgt, elem->order, SIZE_MAX);
+		i < tgt->n_items && tgt->items[i].elem->order == elem->order; i++)
+		if (tgt->items[i].elem == elem)
+			return true;
+
+	return false;
+}
+
+/*
+ * Active set, only the objects listed here are visited by tick_active, the
+ * rest of the pipelines are left alone on a logical tick. Anything that sets
+ * one of the conditions in needs_tick should call activate_object afterwards,
+ * entries are dropped again by tick_active when no condition remains.
+ */
+static bool needs_tick(arcan_vobject* vobj)
+{
+	return vobj->transform || vobj->lifetime > 0 ||
+		vobj->feed.ffunc != FFUNC_FATAL ||
+		(vobj->frameset && vobj->frameset->mctr != 0);
+}
+
+static void ctx_activate(struct arcan_video_context* ctx, arcan_vobject* vobj)
+{
+	if (FL_TEST(vobj, FL_ACTIVE) || !needs_tick(vobj))
+		return;
+
+	if (ctx->n_active == ctx->active_limit){
+		size_t limit = ctx->active_limit ? ctx->active_limit * 2 : 64;
+		arcan_vobj_id* active = arcan_alloc_mem(sizeof(arcan_vobj_id) * limit,
+			ARCAN_MEM_VSTRUCT, 0, ARCAN_MEMALIGN_NATURAL);
+
+		if (ctx->active){
+			memcpy(active, ctx->active, sizeof(arcan_vobj_id) * ctx->n_active);
+			arcan_mem_free(ctx->active);
+		}
+
+		ctx->active = active;
+		ctx->active_limit = limit;
+	}
+
+	ctx->active[ctx->n_active++] = vobj->cellid;
+	FL_SET(vobj, FL_ACTIVE);
+}
+
+static void activate_object(arcan_vobject* vobj)
+{
+	ctx_activate(current_context, vobj);
+}
+
+/* leave a hole rather than compacting, tick_active might be walking the set */
+static void deactivate_object(arcan_vobject* vobj)
+{
+	if (!FL_TEST(vobj, FL_ACTIVE))
+		return;
+
+	for (size_t i = 0; i < current_context->n_active; i++)
+		if (current_context->active[i] == vobj->cellid){
+			current_context->active[i] = 0;
+			break;
+		}
+
+	FL_CLEAR(vobj, FL_ACTIVE);
+}
+
+static void active_free(struct arcan_video_context* ctx)
+{
+	arcan_mem_free(ctx->active);
+	ctx->active = NULL;
+	ctx->n_active = ctx->active_limit = 0;
+}
+
+/* change the order of [elem] without detaching it, only the range between
+ * the old and the new position in each pipeline it is in gets shifted */
+static void reorder_object(arcan_vobject* elem, int order)
+{
+	struct rendertarget* tgts[RENDERTARGET_LIMIT + 1];
+	size_t inds[RENDERTARGET_LIMIT + 1];
+	size_t n = 0;
+
+/* positions need to be found while the old order is still set */
+	for (size_t i = 0; i <= current_context->n_rtargets; i++){
+		struct rendertarget* tgt =
+			rt_at(i == current_context->n_rtargets ? RENDERTARGET_LIMIT : i);
+
+/* linked targets have no pipeline of their own */
+		if (tgt->link ||
+			(elem->extrefc.attachments <= 1 && tgt != elem->owner))
+			continue;
+
+		size_t ind = items_find(tgt, elem);
+		if (ind < tgt->n_items){
+			tgts[n] = tgt;
+			inds[n++] = ind;
+		}
+	}
+
+	elem->order = order;
+	for (size_t i = 0; i < n; i++)
+		items_slide(tgts[i], inds[i], elem);
+
+	FLAG_DIRTY(elem);
+}
+
 static bool detach_fromtarget(struct rendertarget* dst, arcan_vobject* src)
 {
-	arcan_vobject_litem* torem;
 	assert(src);
 
 /* already detached? */
@@ -1233,48 +1771,18 @@ static bool detach_fromtarget(struct rendertarget* dst, arcan_vobject* src)
 	}
 
 /* or empty set */
- 	if (!dst->first)
+ 	if (!dst->n_items)
 		return false;
 
 	if (dst->camtag == src->cellid)
 		dst->camtag = ARCAN_EID;
 
-/* find it */
-	torem = dst->first;
-	while(torem){
-		if (torem->elem == src)
-			break;
-
-		torem = torem->next;
-	}
-	if (!torem)
+/* find it and close the gap */
+	size_t ind = items_find(dst, src);
+	if (ind == dst->n_items)
 		return false;
 
-/* (1.) remove first */
-	if (dst->first == torem){
-		dst->first = torem->next;
-
-/* only one element? */
-		if (dst->first){
-			dst->first->previous = NULL;
-		}
-	}
-/* (2.) remove last */
-	else if (torem->next == NULL){
-		assert(torem->previous);
-		torem->previous->next = NULL;
-	}
-/* (3.) remove arbitrary */
-	else {
-		torem->next->previous = torem->previous;
-		torem->previous->next = torem->next;
-	}
-
-/* (4.) mark as something easy to find in dumps */
-	torem->elem = (arcan_vobject*) 0xfeedface;
-
-/* cleanup torem */
-	arcan_mem_free(torem);
+	items_remove(dst, ind);
 
 	if (src->owner == dst)
 		src->owner = NULL;
@@ -1298,13 +1806,15 @@ static bool detach_fromtarget(struct rendertarget* dst, arcan_vobject* src)
 		src->cellid, video_tracetag(src), src->extrefc.attachments);
 	}
 
-	FLAG_DIRTY(NULL);
+	invalidate_rendertarget(dst);
+	invalidate_rtgraph();
 	return true;
 }
 
 void arcan_vint_reraster(arcan_vobject* src, struct rendertarget* rtgt)
 {
-	struct agp_vstore* vs = src->vstore;
+	struct agp_vstore* vs = src->atlas ?
+		arcan_vint_atlas_source(src) : src->vstore;
 
 /* unless the storage is eligible and the density is sufficiently different */
 	if (!
@@ -1315,6 +1825,10 @@ void arcan_vint_reraster(arcan_vobject* src, struct rendertarget* rtgt)
 	)
 		return;
 
+/* the raster goes into the object store, so that has to be its own */
+	arcan_vint_atlas_release(src, true);
+	vs = src->vstore;
+
 /*  in update sourcedescr we guarantee that any vinf that come here with
  *  the TEXT | TEXTARRAY storage type will have a copy of the format string
  *  that led to its creation. This allows us to just reraster into that */
@@ -1338,54 +1852,17 @@ static void attach_object(struct rendertarget* dst, arcan_vobject* src)
 	if (dst->link)
 		return attach_object(dst->link, src);
 
-	arcan_vobject_litem* new_litem =
-		arcan_alloc_mem(sizeof *new_litem,
-			ARCAN_MEM_VSTRUCT, 0, ARCAN_MEMALIGN_NATURAL);
-
-	new_litem->next = new_litem->previous = NULL;
-	new_litem->elem = src;
-
 /* (pre) if orphaned, assign */
 	if (src->owner == NULL){
 		src->owner = dst;
 	}
 
-/* 2. insert first into empty? */
-	if (!dst->first)
-		dst->first = new_litem;
-	else
-/* 3. insert first with n >= 1 */
-	if (dst->first->elem->order > src->order){
-		new_litem->next = dst->first;
-		dst->first = new_litem;
-		new_litem->next->previous = new_litem;
-	}
-/* 4. insert last or arbitrary */
-	else {
-		bool last;
-		arcan_vobject_litem* ipoint = dst->first;
-
-/* 5. scan for insertion point */
-		do
-			last = (ipoint->elem->order <= src->order);
-		while (last && ipoint->next && (ipoint = ipoint->next));
-
-/* 6. insert last? */
-		if (last){
-			new_litem->previous = ipoint;
-			ipoint->next = new_litem;
-		}
-
-		else {
-/* 7. insert arbitrary */
-			ipoint->previous->next = new_litem;
-			new_litem->previous = ipoint->previous;
-			ipoint->previous = new_litem;
-			new_litem->next = ipoint;
-		}
-	}
+	items_insert(dst, items_insertion(dst, src, SIZE_MAX), src);
 
 	FLAG_DIRTY(src);
+	invalidate_rendertarget(dst);
+	invalidate_rtgraph();
+
 	if (dst->color){
 		src->extrefc.attachments++;
 		dst->color->extrefc.attachments++;
@@ -1518,6 +1995,21 @@ const char* const arcan_video_readtag(arcan_vobj_id id)
 	return vobj ? vobj->tracetag : "(no tag)";
 }
 
+/*
+ * With MASK_MAPPING the child samples its own store through the texture
+ * coordinates of the parent, neither side can then be an atlas resident as
+ * the coordinates would point into the wrong page region.
+ */
+static void mapping_atlas_release(arcan_vobject* vobj)
+{
+	if (!(vobj->mask & MASK_MAPPING))
+		return;
+
+	arcan_vint_atlas_release(vobj, true);
+	if (vobj->parent && vobj->parent != &current_context->world)
+		arcan_vint_atlas_release(vobj->parent, true);
+}
+
 arcan_errc arcan_video_transformmask(arcan_vobj_id id,
 	enum arcan_transform_mask mask)
 {
@@ -1526,6 +2018,8 @@ arcan_errc arcan_video_transformmask(arcan_vobj_id id,
 
 	if (vobj && id > FL_INUSE){
 		vobj->mask = mask;
+		mapping_atlas_release(vobj);
+		invalidate_cache(vobj);
 		rv = ARCAN_OK;
 	}
 
@@ -1587,6 +2081,8 @@ arcan_errc arcan_video_linkobjs(arcan_vobj_id srcid, arcan_vobj_id parentid,
 
 	src->p_anchor = anchorp;
 	src->mask = mask;
+	mapping_atlas_release(src);
+	invalidate_cache(src);
 	FLAG_DIRTY(NULL);
 
 	return ARCAN_OK;
@@ -1599,10 +2095,6 @@ arcan_errc arcan_video_init(uint16_t width, uint16_t height, uint8_t bpp,
 
 /* might be called multiple times due to longjmp recover etc. */
 	if (firstinit){
-		if (-1 == arcan_sem_init(&asynchsynch, ASYNCH_CONCURRENT_THREADS)){
-			arcan_warning("video_init couldn't create synchronization handle\n");
-		}
-
 		arcan_vint_defaultmapping(arcan_video_display.default_txcos, 1.0, 1.0);
 		arcan_vint_defaultmapping(arcan_video_display.cursor_txcos, 1.0, 1.0);
 		arcan_vint_mirrormapping(arcan_video_display.mirror_txcos, 1.0, 1.0);
@@ -1629,12 +2121,15 @@ arcan_errc arcan_video_init(uint16_t width, uint16_t height, uint8_t bpp,
 	arcan_video_display.in_video = true;
 	arcan_video_display.conservative = conservative;
 
-	current_context->world.current.scale.x = 1.0;
-	current_context->world.current.scale.y = 1.0;
+	current_context->world.hot->current.scale.x = 1.0;
+	current_context->world.hot->current.scale.y = 1.0;
 	current_context->vitem_limit = arcan_video_display.default_vitemlim;
 	current_context->vitems_pool = arcan_alloc_mem(
 		sizeof(struct arcan_vobject) * current_context->vitem_limit,
 		ARCAN_MEM_VSTRUCT, ARCAN_MEM_BZERO, ARCAN_MEMALIGN_NATURAL);
+	current_context->hot_pool = arcan_alloc_mem(
+		sizeof(struct vobject_hot) * current_context->vitem_limit,
+		ARCAN_MEM_VSTRUCT, ARCAN_MEM_BZERO, ARCAN_MEMALIGN_SIMD);
 
 	struct monitor_mode mode = platform_video_dimensions();
 	if (mode.width == 0 || mode.height == 0){
@@ -1690,6 +2185,7 @@ arcan_errc arcan_video_resize_canvas(size_t neww, size_t newh)
 	current_context->world.origw = neww;
 	current_context->world.origh = newh;
 
+	arcan_vint_pickdirty();
 	FLAG_DIRTY(NULL);
 	arcan_video_forceupdate(ARCAN_VIDEO_WORLDID);
 
@@ -1704,119 +2200,190 @@ static uint16_t nexthigher(uint16_t k)
 	return k+1;
 }
 
-arcan_errc arcan_vint_getimage(const char* fname, arcan_vobject* dst,
-	img_cons forced, bool asynchsrc)
-{
 /*
- * with asynchsynch, it's likely that we get a storm of requests and we'd
- * likely suffer thrashing, so limit this.  also, look into using
- * pthread_setschedparam and switch to pthreads exclusively
+ * Decode (or fetch from the image cache) [fname] into a buffer owned by [ld]
+ * according to the scale mode, flip and forced dimensions set in [ld]. This
+ * does not touch any video object so that it can run on a loader worker, the
+ * result is handed over to the object with attach_image.
  */
-	arcan_sem_wait(asynchsynch);
+struct image_load {
+	enum arcan_vimage_mode scale;
+	bool flip;
+	img_cons forced;
+
+	arcan_errc rc;
+	av_pixel* raw;
+	size_t s_raw, w, h;
+	size_t origw, origh;
+};
 
+static void load_image(const char* fname, struct image_load* ld)
+{
 	size_t inw, inh;
+	img_cons forced = ld->forced;
+	ld->rc = ARCAN_ERRC_BAD_RESOURCE;
 
-/* try- open */
+/* try- open, concurrency for the asynch case is bounded by the loader pool */
 	data_source inres = arcan_open_resource(fname);
-	if (inres.fd == BADFD){
-		arcan_sem_post(asynchsynch);
-		return ARCAN_ERRC_BAD_RESOURCE;
-	}
+	if (inres.fd == BADFD)
+		return;
 
-/* mmap (preferred) or buffer (mmap not working / useful due to alignment) */
-	map_region inmem = arcan_map_resource(&inres, false);
+	struct arcan_img_ckey ckey = {
+		.path = fname,
+		.w = forced.w,
+		.h = forced.h,
+		.mode = ld->scale,
+		.vflip = ld->flip
+	};
+
+/* the cache key needs the file identity, if that can't be had just decode */
+	struct stat fs;
+	bool cacheable = fstat(inres.fd, &fs) == 0;
+	if (cacheable){
+/* replace-by-rename within the same second keeps st_mtime but not the inode,
+ * and a copy preserving the timestamp ends up on another inode or device */
+		ckey.dev = fs.st_dev;
+		ckey.ino = fs.st_ino;
+#ifdef __APPLE__
+		struct timespec mtim = fs.st_mtimespec;
+#else
+		struct timespec mtim = fs.st_mtim;
+#endif
+		ckey.mtime = (int64_t) mtim.tv_sec * 1000000000 + mtim.tv_nsec;
+		ckey.size = fs.st_size;
+
+		if (arcan_img_cache_get(&ckey,
+			&ld->raw, &ld->w, &ld->h, &ld->origw, &ld->origh)){
+			arcan_release_resource(&inres);
+			ld->s_raw = ld->w * ld->h * sizeof(av_pixel);
+			ld->rc = ARCAN_OK;
+			return;
+		}
+	}
+
+/* mmap (preferred) or buffer (mmap not working / useful due to alignment) */
+	map_region inmem = arcan_map_resource(&inres, false);
 	if (inmem.ptr == NULL){
-		arcan_sem_post(asynchsynch);
 		arcan_release_resource(&inres);
-		return ARCAN_ERRC_BAD_RESOURCE;
+		return;
 	}
 
+/* decoded straight into the final format, the buffer becomes the store
+ * unless it needs to be rescaled */
 	struct arcan_img_meta meta = {0};
-	uint32_t* ch_imgbuf = NULL;
+	av_pixel* imgbuf = NULL;
 
-	arcan_errc rv = arcan_img_decode(fname, inmem.ptr, inmem.sz,
-		&ch_imgbuf, &inw, &inh, &meta, dst->vstore->imageproc == IMAGEPROC_FLIPH);
+	ld->rc = arcan_img_decode_native(fname, inmem.ptr, inmem.sz,
+		&imgbuf, &inw, &inh, &meta, ld->flip);
 
 	arcan_release_map(inmem);
 	arcan_release_resource(&inres);
 
-	if (ARCAN_OK != rv)
-		goto done;
-
-	av_pixel* imgbuf = arcan_img_repack(ch_imgbuf, inw, inh);
-	if (!imgbuf){
-		rv = ARCAN_ERRC_OUT_OF_SPACE;
-		goto done;
-	}
+	if (ARCAN_OK != ld->rc)
+		return;
 
 	uint16_t neww, newh;
 
 /* store this so we can maintain aspect ratios etc. while still
  * possibly aligning to next power of two */
-	dst->origw = inw;
-	dst->origh = inh;
+	ld->origw = inw;
+	ld->origh = inh;
 
 	neww = inw;
 	newh = inh;
 
-/* the thread_loader will take care of converting the asynchsrc
- * to an image once its completely done */
-	if (!asynchsrc)
-		dst->feed.state.tag = ARCAN_TAG_IMAGE;
-
-/* need to keep the identification string in order to rebuild
- * on a forced push/pop */
-	struct agp_vstore* dstframe = dst->vstore;
-	dstframe->vinf.text.source = strdup(fname);
-
-	enum arcan_vimage_mode desm = dst->vstore->scale;
-
-	if (meta.compressed)
-		goto push_comp;
+/* natively compressed formats are not uploaded, only the dimensions and
+ * the source are kept */
+	if (meta.compressed){
+		arcan_mem_free(imgbuf);
+		return;
+	}
 
 /* the user requested specific dimensions, or we are in a mode where
  * we should manually enfore a stretch to the nearest power of two */
-	if (desm == ARCAN_VIMAGE_SCALEPOW2){
+	if (ld->scale == ARCAN_VIMAGE_SCALEPOW2){
 		forced.w = nexthigher(neww) == neww ? 0 : nexthigher(neww);
 		forced.h = nexthigher(newh) == newh ? 0 : nexthigher(newh);
 	}
 
 	if (forced.h > 0 && forced.w > 0){
-		neww = desm == ARCAN_VIMAGE_SCALEPOW2 ? nexthigher(forced.w) : forced.w;
-		newh = desm == ARCAN_VIMAGE_SCALEPOW2 ? nexthigher(forced.h) : forced.h;
-		dst->origw = forced.w;
-		dst->origh = forced.h;
+		neww = ld->scale == ARCAN_VIMAGE_SCALEPOW2 ? nexthigher(forced.w) : forced.w;
+		newh = ld->scale == ARCAN_VIMAGE_SCALEPOW2 ? nexthigher(forced.h) : forced.h;
+		ld->origw = forced.w;
+		ld->origh = forced.h;
 
-		dstframe->vinf.text.s_raw = neww * newh * sizeof(av_pixel);
-		dstframe->vinf.text.raw = arcan_alloc_mem(dstframe->vinf.text.s_raw,
+		ld->s_raw = neww * newh * sizeof(av_pixel);
+		ld->raw = arcan_alloc_mem(ld->s_raw,
 			ARCAN_MEM_VBUFFER, 0, ARCAN_MEMALIGN_PAGE);
 
 		arcan_renderfun_stretchblit((char*)imgbuf, inw, inh,
-			(uint32_t*) dstframe->vinf.text.raw,
-			neww, newh, dst->vstore->imageproc == IMAGEPROC_FLIPH);
+			(uint32_t*) ld->raw, neww, newh, ld->flip);
 		arcan_mem_free(imgbuf);
 	}
 	else {
 		neww = inw;
 		newh = inh;
-		dstframe->vinf.text.raw = imgbuf;
-		dstframe->vinf.text.s_raw = inw * inh * sizeof(av_pixel);
+		ld->raw = imgbuf;
+		ld->s_raw = inw * inh * sizeof(av_pixel);
 	}
 
-	dst->vstore->w = neww;
-	dst->vstore->h = newh;
+	ld->w = neww;
+	ld->h = newh;
 
-/*
- * for the asynch case, we need to do this separately as we're in a different
- * thread and forcibly assigning the glcontext to another thread is expensive */
+	if (cacheable)
+		arcan_img_cache_put(&ckey, ld->raw,
+			neww, newh, ld->origw, ld->origh, inw, inh);
+}
 
-push_comp:
-	if (!asynchsrc && dst->vstore->txmapped != TXSTATE_OFF)
-		agp_update_vstore(dst->vstore, true);
+/* main thread side of load_image, [dst] takes over the decoded buffer */
+static void attach_image(arcan_vobject* dst,
+	const char* fname, struct image_load* ld)
+{
+	struct agp_vstore* dstframe = dst->vstore;
+	dst->origw = ld->origw;
+	dst->origh = ld->origh;
 
-done:
-	arcan_sem_post(asynchsynch);
-	return rv;
+/* need to keep the identification string in order to rebuild
+ * on a forced push/pop */
+	dstframe->vinf.text.source = strdup(fname);
+
+/* the soft backend keeps raw around in conservative mode as well, so a
+ * reload can find the previous buffer still there */
+	if (ld->raw){
+		if (dstframe->vinf.text.raw != ld->raw)
+			arcan_mem_free(dstframe->vinf.text.raw);
+		dstframe->vinf.text.raw = ld->raw;
+		dstframe->vinf.text.s_raw = ld->s_raw;
+		dstframe->w = ld->w;
+		dstframe->h = ld->h;
+		ld->raw = NULL;
+	}
+}
+
+arcan_errc arcan_vint_getimage(const char* fname, arcan_vobject* dst,
+	img_cons forced, bool asynchsrc)
+{
+	struct image_load ld = {
+		.scale = dst->vstore->scale,
+		.flip = dst->vstore->imageproc == IMAGEPROC_FLIPH,
+		.forced = forced
+	};
+
+	load_image(fname, &ld);
+	if (ARCAN_OK != ld.rc)
+		return ld.rc;
+
+	attach_image(dst, fname, &ld);
+
+/* the thread_loader will take care of converting the asynchsrc
+ * to an image once its completely done */
+	if (!asynchsrc){
+		dst->feed.state.tag = ARCAN_TAG_IMAGE;
+		if (dst->vstore->txmapped != TXSTATE_OFF)
+			agp_update_vstore(dst->vstore, true);
+	}
+
+	return ARCAN_OK;
 }
 
 arcan_errc arcan_video_3dorder(enum arcan_order3d order, arcan_vobj_id rt)
@@ -1859,6 +2426,7 @@ arcan_errc arcan_video_framecyclemode(arcan_vobj_id id, int mode)
 		return ARCAN_ERRC_UNACCEPTED_STATE;
 
 	vobj->frameset->ctr = vobj->frameset->mctr = abs(mode);
+	activate_object(vobj);
 
 	return ARCAN_OK;
 }
@@ -1893,6 +2461,8 @@ void arcan_video_cursorstore(arcan_vobj_id src)
 		vobj->vstore->txmapped != TXSTATE_TEX2D)
 		return;
 
+	arcan_vint_atlas_release(vobj, true);
+
 /* texture coordinates are managed separately through _display.cursor_txcos */
 	arcan_video_display.cursor.vstore = vobj->vstore;
 	vobj->vstore->refcount++;
@@ -1906,6 +2476,10 @@ arcan_errc arcan_video_shareglstore(arcan_vobj_id sid, arcan_vobj_id did)
 	if (!src || !dst || src == dst)
 		return ARCAN_ERRC_NO_SUCH_OBJECT;
 
+/* the page might not have been uploaded yet */
+	if (src->atlas)
+		arcan_vint_atlas_flush();
+
 	if (src->vstore->txmapped == TXSTATE_OFF ||
 		src->vstore->vinf.text.glid == 0 ||
 		FL_TEST(src, FL_PRSIST) ||
@@ -1914,9 +2488,12 @@ arcan_errc arcan_video_shareglstore(arcan_vobj_id sid, arcan_vobj_id did)
 		return ARCAN_ERRC_UNACCEPTED_STATE;
 
 /* remove the original target store, substitute in our own */
+	arcan_vint_atlas_release(dst, false);
 	arcan_vint_drop_vstore(dst->vstore);
 	dst->vstore = src->vstore;
 	dst->vstore->refcount++;
+	arcan_vint_atlas_share(src, dst);
+	invalidate_rtgraph();
 
 /* customized texture coordinates unless we should use defaults ... */
 	if (src->txcos){
@@ -2000,7 +2577,8 @@ arcan_vobj_id arcan_video_rawobject(av_pixel* buf,
 	newvobj->blendmode = BLEND_NORMAL;
 	newvobj->order = zv;
 
-	agp_update_vstore(newvobj->vstore, true);
+	if (!arcan_vint_atlas_insert(newvobj, vcontext_ind))
+		agp_update_vstore(newvobj->vstore, true);
 	arcan_vint_attachobject(rv);
 
 	return rv;
@@ -2035,13 +2613,10 @@ arcan_errc arcan_video_rendertargetdensity(
 	rtgt->vppcm = vppcm;
 	rtgt->hppcm = hppcm;
 
-	struct arcan_vobject_litem* cent = rtgt->first;
-	while(cent){
-		struct arcan_vobject* vobj = cent->elem;
-		if (vobj->owner != rtgt){
-			cent = cent->next;
+	for (size_t i = 0; i < rtgt->n_items; i++){
+		struct arcan_vobject* vobj = rtgt->items[i].elem;
+		if (vobj->owner != rtgt)
 			continue;
-		}
 
 /* for all vobj- that are attached to this rendertarget AND has it as
  * primary, check if it is possible to rebuild a raster representation
@@ -2050,16 +2625,15 @@ arcan_errc arcan_video_rendertargetdensity(
 			arcan_vint_reraster(vobj, rtgt);
 
 		if (rescale){
-			float ox = (float)vobj->origw*vobj->current.scale.x;
-			float oy = (float)vobj->origh*vobj->current.scale.y;
+			float ox = (float)vobj->origw*vobj->hot->current.scale.x;
+			float oy = (float)vobj->origh*vobj->hot->current.scale.y;
 			rescale_origwh(vobj,
-					sfx / vobj->current.scale.x, sfy / vobj->current.scale.y);
+					sfx / vobj->hot->current.scale.x, sfy / vobj->hot->current.scale.y);
 			invalidate_cache(vobj);
 		}
-		cent = cent->next;
 	}
 
-	FLAG_DIRTY(rtgt);
+	invalidate_rendertarget(rtgt);
 	return ARCAN_OK;
 }
 
@@ -2236,6 +2810,31 @@ arcan_errc arcan_video_rendertarget_setnoclear(arcan_vobj_id did, bool value)
 	return ARCAN_OK;
 }
 
+arcan_errc arcan_video_rendertarget_setstatesort(arcan_vobj_id did, bool value)
+{
+	struct rendertarget* rtgt;
+
+	if (did == ARCAN_VIDEO_WORLDID)
+		rtgt = &current_context->stdoutp;
+	else {
+		arcan_vobject* vobj = arcan_video_getobject(did);
+		if (!vobj)
+			return ARCAN_ERRC_NO_SUCH_OBJECT;
+
+		rtgt = arcan_vint_findrt(vobj);
+	}
+
+	if (!rtgt)
+		return ARCAN_ERRC_NO_SUCH_OBJECT;
+
+	if (value)
+		FL_SET(rtgt, TGTFL_STATESORT);
+	else
+		FL_CLEAR(rtgt, TGTFL_STATESORT);
+
+	return ARCAN_OK;
+}
+
 arcan_errc arcan_video_linkrendertarget(arcan_vobj_id did,
 	arcan_vobj_id tgt_id, int refresh, bool scale, enum rendertarget_mode format)
 {
@@ -2254,6 +2853,7 @@ arcan_errc arcan_video_linkrendertarget(arcan_vobj_id did,
 	vobj = arcan_video_getobject(did);
 	struct rendertarget* newtgt = arcan_vint_findrt(vobj);
 	newtgt->link = tgt;
+	invalidate_rtgraph();
 	return ARCAN_OK;
 }
 
@@ -2273,6 +2873,8 @@ arcan_errc arcan_video_setuprendertarget(arcan_vobj_id did,
 		return rv;
 	}
 
+	arcan_vint_atlas_release(vobj, true);
+
 /* hard-coded number of render-targets allowed */
 	if (current_context->n_rtargets >= RENDERTARGET_LIMIT)
 		return ARCAN_ERRC_OUT_OF_SPACE;
@@ -2280,6 +2882,7 @@ arcan_errc arcan_video_setuprendertarget(arcan_vobj_id did,
 	int ind = current_context->n_rtargets++;
 	struct rendertarget* dst = &current_context->rtargets[ ind ];
 	*dst = (struct rendertarget){};
+	invalidate_rtgraph();
 
 	FL_SET(vobj, FL_RTGT);
 	FL_SET(dst, TGTFL_ALIVE);
@@ -2353,10 +2956,13 @@ arcan_errc arcan_video_setasframe(arcan_vobj_id dst,
 	if (fid >= dstvobj->frameset->n_frames)
 		return ARCAN_ERRC_BAD_ARGUMENT;
 
+	arcan_vint_atlas_release(srcvobj, true);
+
 	struct frameset_store* store = &dstvobj->frameset->frames[fid];
 	if (store->frame != srcvobj->vstore){
 		arcan_vint_drop_vstore(store->frame);
 		store->frame = srcvobj->vstore;
+		invalidate_rtgraph();
 	}
 
 /* we need texture coordinates to come with in order to support
@@ -2371,43 +2977,173 @@ arcan_errc arcan_video_setasframe(arcan_vobj_id dst,
 	return ARCAN_OK;
 }
 
+/*
+ * Asynchronous image loading runs on a fixed pool of workers. Jobs wait in
+ * [loader.queue] (visible objects first, then in request order) and are
+ * handed back through a lock-free stack that the conductor drains with
+ * arcan_vint_pollasynch, so nothing in the tick path has to block. Workers
+ * decode into the job (load_image) and the object only gets the result in
+ * complete_asynch, so cancelling a job that is being decoded just marks it
+ * as consumed and its buffer goes when it comes off the stack.
+ */
+enum asynch_state {
+	ASYNCH_QUEUED = 0,
+	ASYNCH_RUNNING,
+	ASYNCH_DONE
+};
+
 struct thread_loader_args {
 	arcan_vobject* dst;
-	pthread_t self;
 	arcan_vobj_id dstid;
 	char* fname;
 	intptr_t tag;
-	img_cons constraints;
-	arcan_errc rc;
+
+/* the worker only ever touches this, [dst] belongs to the main thread */
+	struct image_load ld;
+
+/* state / visible / seq are guarded by loader.lock */
+	enum asynch_state state;
+	bool visible;
+	uint64_t seq;
+
+/* set by the main thread when the job has been collected or cancelled, the
+ * completion stack entry then only needs to be freed */
+	bool consumed;
+	struct thread_loader_args* next;
 };
 
-static void* thread_loader(void* in)
+static struct {
+	bool initialized;
+	pthread_mutex_t lock;
+	pthread_cond_t wake, done;
+	size_t n_workers;
+
+	struct thread_loader_args** queue;
+	size_t n_queue, queue_limit;
+	uint64_t seq;
+
+	_Atomic(struct thread_loader_args*) completed;
+	_Atomic size_t busy;
+} loader = {
+	.lock = PTHREAD_MUTEX_INITIALIZER,
+	.wake = PTHREAD_COND_INITIALIZER,
+	.done = PTHREAD_COND_INITIALIZER
+};
+
+static void free_loader_job(struct thread_loader_args* job)
 {
-	struct thread_loader_args* largs = (struct thread_loader_args*) in;
-	arcan_vobject* dst = largs->dst;
-	largs->rc = arcan_vint_getimage(largs->fname, dst, largs->constraints, true);
-	dst->feed.state.tag = ARCAN_TAG_ASYNCIMGRD;
-	return 0;
+	arcan_mem_free(job->ld.raw);
+	arcan_mem_free(job->fname);
+	arcan_mem_free(job);
 }
 
-void arcan_vint_joinasynch(arcan_vobject* img, bool emit, bool force)
+/* highest priority queued job, needs loader.lock */
+static struct thread_loader_args* loader_dequeue()
 {
-	if (!force && img->feed.state.tag != ARCAN_TAG_ASYNCIMGRD){
-		return;
+	size_t best = 0;
+	for (size_t i = 1; i < loader.n_queue; i++){
+		struct thread_loader_args* a = loader.queue[i];
+		struct thread_loader_args* b = loader.queue[best];
+		if (a->visible > b->visible || (a->visible == b->visible && a->seq < b->seq))
+			best = i;
+	}
+
+	struct thread_loader_args* job = loader.queue[best];
+	loader.queue[best] = loader.queue[--loader.n_queue];
+	return job;
+}
+
+/* drop a specific queued job, needs loader.lock */
+static void loader_unqueue(struct thread_loader_args* job)
+{
+	for (size_t i = 0; i < loader.n_queue; i++)
+		if (loader.queue[i] == job){
+			loader.queue[i] = loader.queue[--loader.n_queue];
+			return;
+		}
+}
+
+static void* loader_worker(void* arg)
+{
+/* only the synchronous fault signals should be able to land here */
+	sigset_t mask;
+	sigfillset(&mask);
+	sigdelset(&mask, SIGBUS);
+	sigdelset(&mask, SIGSEGV);
+	pthread_sigmask(SIG_BLOCK, &mask, NULL);
+
+	pthread_mutex_lock(&loader.lock);
+
+	for(;;){
+		while (!loader.n_queue)
+			pthread_cond_wait(&loader.wake, &loader.lock);
+
+		struct thread_loader_args* job = loader_dequeue();
+		job->state = ASYNCH_RUNNING;
+		pthread_mutex_unlock(&loader.lock);
+
+		atomic_fetch_add(&loader.busy, 1);
+		load_image(job->fname, &job->ld);
+		atomic_fetch_sub(&loader.busy, 1);
+
+		pthread_mutex_lock(&loader.lock);
+		job->state = ASYNCH_DONE;
+		pthread_cond_broadcast(&loader.done);
+		pthread_mutex_unlock(&loader.lock);
+
+/* last access to the job from this thread, after this it belongs to
+ * whoever drains the stack */
+		struct thread_loader_args* head = atomic_load(&loader.completed);
+		do {
+			job->next = head;
+		} while (!atomic_compare_exchange_weak(&loader.completed, &head, job));
+
+		pthread_mutex_lock(&loader.lock);
 	}
 
-	struct thread_loader_args* args =
-		(struct thread_loader_args*) img->feed.state.ptr;
+	return NULL;
+}
+
+size_t arcan_vint_loaderbusy()
+{
+	return atomic_load(&loader.busy);
+}
+
+static void setup_loader()
+{
+	if (loader.initialized)
+		return;
+	loader.initialized = true;
+
+	long count = sysconf(_SC_NPROCESSORS_ONLN);
+	if (count > ASYNCH_CONCURRENT_THREADS)
+		count = ASYNCH_CONCURRENT_THREADS;
 
-	pthread_join(args->self, NULL);
+	for (long i = 0; i < (count > 0 ? count : 1); i++){
+		pthread_t pth;
+		if (0 != pthread_create(&pth, NULL, loader_worker, NULL)){
+			arcan_warning("video: couldn't spawn image loader worker\n");
+			break;
+		}
+		pthread_detach(pth);
+		loader.n_workers++;
+	}
+}
 
+/* main thread side of a finished job, the object gets the image or the
+ * broken placeholder and the job is flagged so the stack entry is skipped */
+static void complete_asynch(arcan_vobject* img,
+	struct thread_loader_args* args, bool emit)
+{
 	arcan_event loadev = {
 		.category = EVENT_VIDEO,
 		.vid.data = args->tag,
 		.vid.source = args->dstid
 	};
+	size_t origw = img->origw, origh = img->origh;
 
-	if (args->rc == ARCAN_OK){
+	if (args->ld.rc == ARCAN_OK){
+		attach_image(img, args->fname, &args->ld);
 		loadev.vid.kind = EVENT_VIDEO_ASYNCHIMAGE_LOADED;
 		loadev.vid.width = img->origw;
 		loadev.vid.height = img->origh;
@@ -2431,16 +3167,114 @@ void arcan_vint_joinasynch(arcan_vobject* img, bool emit, bool force)
 	}
 
 	agp_update_vstore(img->vstore, true);
+	if (img->origw != origw || img->origh != origh)
+		arcan_vint_pickdirty();
+	FLAG_DIRTY(img);
 
 	if (emit)
 		arcan_event_enqueue(arcan_event_defaultctx(), &loadev);
 
-	arcan_mem_free(args->fname);
-	arcan_mem_free(args);
+	args->consumed = true;
 	img->feed.state.ptr = NULL;
 	img->feed.state.tag = ARCAN_TAG_IMAGE;
 }
 
+void arcan_vint_joinasynch(arcan_vobject* img, bool emit, bool force)
+{
+	struct thread_loader_args* args = img->feed.state.ptr;
+	if (img->feed.state.tag != ARCAN_TAG_ASYNCIMGLD || !args)
+		return;
+
+	pthread_mutex_lock(&loader.lock);
+
+/* not started, just do it here rather than wait for a worker */
+	if (args->state == ASYNCH_QUEUED){
+		if (!force){
+			pthread_mutex_unlock(&loader.lock);
+			return;
+		}
+
+		loader_unqueue(args);
+		pthread_mutex_unlock(&loader.lock);
+
+		load_image(args->fname, &args->ld);
+		complete_asynch(img, args, emit);
+		free_loader_job(args);
+		return;
+	}
+
+	if (!force && args->state != ASYNCH_DONE){
+		pthread_mutex_unlock(&loader.lock);
+		return;
+	}
+
+	while (args->state != ASYNCH_DONE)
+		pthread_cond_wait(&loader.done, &loader.lock);
+	pthread_mutex_unlock(&loader.lock);
+
+/* the stack entry still refers to args, arcan_vint_pollasynch frees it */
+	complete_asynch(img, args, emit);
+}
+
+/* the object is going away, drop the job without delivering anything */
+static void cancel_asynch(arcan_vobject* img)
+{
+	struct thread_loader_args* args = img->feed.state.ptr;
+	if (img->feed.state.tag != ARCAN_TAG_ASYNCIMGLD || !args)
+		return;
+
+	img->feed.state.ptr = NULL;
+	img->feed.state.tag = ARCAN_TAG_NONE;
+
+	pthread_mutex_lock(&loader.lock);
+	if (args->state == ASYNCH_QUEUED){
+		loader_unqueue(args);
+		pthread_mutex_unlock(&loader.lock);
+		free_loader_job(args);
+		return;
+	}
+	pthread_mutex_unlock(&loader.lock);
+
+/* the worker only writes into the job, so no need to wait for it, the
+ * result is freed when the job comes off the completion stack */
+	args->consumed = true;
+}
+
+void arcan_vint_pollasynch()
+{
+	if (!loader.initialized)
+		return;
+
+/* re-rank what is still waiting, the usual pattern is to load hidden and
+ * show_image once the loaded event arrives, but anything already shown or
+ * fading in should not wait behind a thumbnail grid */
+	pthread_mutex_lock(&loader.lock);
+	for (size_t i = 0; i < loader.n_queue; i++)
+		loader.queue[i]->visible =
+			loader.queue[i]->dst->hot->current.opa > EPSILON ||
+			loader.queue[i]->dst->transform != NULL;
+	pthread_mutex_unlock(&loader.lock);
+
+	struct thread_loader_args* job = atomic_exchange(&loader.completed, NULL);
+
+/* the stack is LIFO, flip it so events come in completion order */
+	struct thread_loader_args* ordered = NULL;
+	while (job){
+		struct thread_loader_args* next = job->next;
+		job->next = ordered;
+		ordered = job;
+		job = next;
+	}
+
+	while (ordered){
+		struct thread_loader_args* next = ordered->next;
+		if (!ordered->consumed)
+			complete_asynch(ordered->dst, ordered, true);
+		free_loader_job(ordered);
+		ordered = next;
+	}
+}
+
 static arcan_vobj_id loadimage_asynch(const char* fname,
 	img_cons constraints, intptr_t tag)
 {
@@ -2449,20 +3283,56 @@ static arcan_vobj_id loadimage_asynch(const char* fname,
 	if (!dstobj)
 		return rv;
 
+	setup_loader();
+
 	struct thread_loader_args* args = arcan_alloc_mem(
 		sizeof(struct thread_loader_args),
-		ARCAN_MEM_THREADCTX, 0, ARCAN_MEMALIGN_NATURAL);
+		ARCAN_MEM_THREADCTX, ARCAN_MEM_BZERO, ARCAN_MEMALIGN_NATURAL);
 
 	args->dstid = rv;
 	args->dst = dstobj;
 	args->fname = strdup(fname);
 	args->tag = tag;
-	args->constraints = constraints;
+	args->ld = (struct image_load){
+		.scale = dstobj->vstore->scale,
+		.flip = dstobj->vstore->imageproc == IMAGEPROC_FLIPH,
+		.forced = constraints
+	};
 
 	dstobj->feed.state.tag = ARCAN_TAG_ASYNCIMGLD;
 	dstobj->feed.state.ptr = args;
 
-	pthread_create(&args->self, NULL, thread_loader, (void*) args);
+/* no workers could be spawned, load here but still deliver the result
+ * through the completion stack so the caller sees the same event order */
+	if (!loader.n_workers){
+		load_image(fname, &args->ld);
+		args->state = ASYNCH_DONE;
+		args->next = atomic_load(&loader.completed);
+		atomic_store(&loader.completed, args);
+		return rv;
+	}
+
+	pthread_mutex_lock(&loader.lock);
+	if (loader.n_queue == loader.queue_limit){
+		size_t limit = loader.queue_limit ? loader.queue_limit * 2 : 64;
+		struct thread_loader_args** queue = arcan_alloc_mem(
+			sizeof(struct thread_loader_args*) * limit,
+			ARCAN_MEM_VSTRUCT, 0, ARCAN_MEMALIGN_NATURAL);
+
+		if (loader.queue){
+			memcpy(queue, loader.queue,
+				sizeof(struct thread_loader_args*) * loader.n_queue);
+			arcan_mem_free(loader.queue);
+		}
+
+		loader.queue = queue;
+		loader.queue_limit = limit;
+	}
+
+	args->seq = loader.seq++;
+	loader.queue[loader.n_queue++] = args;
+	pthread_cond_signal(&loader.wake);
+	pthread_mutex_unlock(&loader.lock);
 
 	return rv;
 }
@@ -2498,6 +3368,8 @@ static arcan_vobj_id loadimage(const char* fname, img_cons constraints,
 
 	if (rc != ARCAN_OK)
 		arcan_video_deleteobject(rv);
+	else
+		arcan_vint_atlas_insert(newvobj, vcontext_ind);
 
 	if (errcode != NULL)
 		*errcode = rc;
@@ -2525,8 +3397,10 @@ arcan_errc arcan_video_alterfeed(arcan_vobj_id id,
 	if (!vobj)
 		return ARCAN_ERRC_NO_SUCH_OBJECT;
 
+	arcan_vint_atlas_release(vobj, true);
 	vobj->feed.state = state;
 	vobj->feed.ffunc = cb;
+	activate_object(vobj);
 
 	return ARCAN_OK;
 }
@@ -2573,6 +3447,7 @@ static arcan_vobj_id arcan_video_setupfeed(
 		ARCAN_MEM_VBUFFER, ARCAN_MEM_BZERO, ARCAN_MEMALIGN_PAGE);
 
 	newvobj->feed.ffunc = ffunc;
+	activate_object(newvobj);
 	agp_update_vstore(newvobj->vstore, true);
 
 	return rv;
@@ -2590,14 +3465,16 @@ arcan_errc arcan_video_resizefeed(arcan_vobj_id id, size_t w, size_t h)
 		vobj->feed.state.tag == ARCAN_TAG_ASYNCIMGRD)
 		arcan_video_pushasynch(id);
 
+	arcan_vint_atlas_release(vobj, true);
+
 /* rescale transformation chain */
-	float ox = (float)vobj->origw*vobj->current.scale.x;
-	float oy = (float)vobj->origh*vobj->current.scale.y;
+	float ox = (float)vobj->origw*vobj->hot->current.scale.x;
+	float oy = (float)vobj->origh*vobj->hot->current.scale.y;
 	float sfx = ox / (float)w;
 	float sfy = oy / (float)h;
-	if (vobj->current.scale.x > 0 && vobj->current.scale.y > 0){
+	if (vobj->hot->current.scale.x > 0 && vobj->hot->current.scale.y > 0){
 		rescale_origwh(vobj,
-			sfx / vobj->current.scale.x, sfy / vobj->current.scale.y);
+			sfx / vobj->hot->current.scale.x, sfy / vobj->hot->current.scale.y);
 	}
 
 /* "initial" base dimensions, important when dimensions change for objects that
@@ -2605,12 +3482,12 @@ arcan_errc arcan_video_resizefeed(arcan_vobj_id id, size_t w, size_t h)
 	vobj->origw = w;
 	vobj->origh = h;
 
-	vobj->current.scale.x = sfx;
-	vobj->current.scale.y = sfy;
+	vobj->hot->current.scale.x = sfx;
+	vobj->hot->current.scale.y = sfy;
 	invalidate_cache(vobj);
 	agp_resize_vstore(vobj->vstore, w, h);
 
-	FLAG_DIRTY();
+	FLAG_DIRTY(vobj);
 	return ARCAN_OK;
 }
 
@@ -2623,7 +3500,7 @@ arcan_vobj_id arcan_video_loadimageasynch(const char* rloc,
 		arcan_vobject* vobj = arcan_video_getobject(rv);
 
 		if (vobj){
-			vobj->current.rotation.quaternion = default_quat;
+			vobj->hot->current.rotation.quaternion = default_quat;
 			arcan_vint_attachobject(rv);
 		}
 	}
@@ -2642,7 +3519,7 @@ arcan_vobj_id arcan_video_loadimage(const char* rloc,
 		arcan_vobject* vobj = arcan_video_getobject(rv);
 		if (vobj){
 			vobj->order = zv;
-			vobj->current.rotation.quaternion = default_quat;
+			vobj->hot->current.rotation.quaternion = default_quat;
 			arcan_vint_attachobject(rv);
 		}
 	}
@@ -2678,6 +3555,7 @@ arcan_errc arcan_video_scaletxcos(arcan_vobj_id id, float sfs, float sft)
 	if (!vobj)
 		return ARCAN_ERRC_NO_SUCH_OBJECT;
 
+	arcan_vint_atlas_release(vobj, true);
 	if (!vobj->txcos){
 		vobj->txcos = arcan_alloc_mem(8 * sizeof(float),
 			ARCAN_MEM_VSTRUCT, 0, ARCAN_MEMALIGN_SIMD);
@@ -2739,20 +3617,12 @@ static arcan_errc update_zv(arcan_vobject* vobj, int newzv)
 	newzv = newzv > 65535 ? 65535 : newzv;
 
 /*
- * attach also works like an insertion sort where
- * the insertion criterion is <= order, to aid dynamic
- * corruption checks, this could be further optimized
- * by using the fact that we're simply "sliding" in the
- * same chain.
+ * same insertion criterion as attach (<= order) but we're simply sliding
+ * within the same pipeline so there is no need to detach
  */
 	int oldv = vobj->order;
-	detach_fromtarget(owner, vobj);
-	vobj->order = newzv;
-
-	if (vobj->feed.state.tag == ARCAN_TAG_3DOBJ)
-		vobj->order *= -1;
-
-	attach_object(owner, vobj);
+	reorder_object(vobj,
+		vobj->feed.state.tag == ARCAN_TAG_3DOBJ ? -newzv : newzv);
 
 /*
  * unfortunately, we need to do this recursively AND
@@ -2808,6 +3678,7 @@ arcan_errc arcan_video_setlife(arcan_vobj_id id, unsigned lifetime)
 			vobj->mask |= MASK_LIVING;
 
 		vobj->lifetime = lifetime;
+		activate_object(vobj);
 		rv = ARCAN_OK;
 	}
 
@@ -2939,7 +3810,7 @@ arcan_errc arcan_video_instanttransform(
 	while (current){
 
 		if (current->move.startt){
-			vobj->current.position = current->move.endp;
+			vobj->hot->current.position = current->move.endp;
 
 			at_last = (method == TAG_TRANSFORM_LAST) &&
 				!( current->next && current->next->move.startt );
@@ -2949,7 +3820,7 @@ arcan_errc arcan_video_instanttransform(
 		}
 
 		if (current->blend.startt){
-			vobj->current.opa = current->blend.endopa;
+			vobj->hot->current.opa = current->blend.endopa;
 
 			at_last = (method == TAG_TRANSFORM_LAST) &&
 				!( current->next && current->next->blend.startt );
@@ -2959,7 +3830,7 @@ arcan_errc arcan_video_instanttransform(
 		}
 
 		if (current->rotate.startt){
-			vobj->current.rotation = current->rotate.endo;
+			vobj->hot->current.rotation = current->rotate.endo;
 
 			at_last = (method == TAG_TRANSFORM_LAST) &&
 				!( current->next && current->next->rotate.startt );
@@ -2970,7 +3841,7 @@ arcan_errc arcan_video_instanttransform(
 		}
 
 		if (current->scale.startt){
-			vobj->current.scale = current->scale.endd;
+			vobj->hot->current.scale = current->scale.endd;
 
 			at_last = (method == TAG_TRANSFORM_LAST) &&
 				!( current->next && current->next->scale.startt );
@@ -2996,6 +3867,7 @@ arcan_errc arcan_video_objecttexmode(arcan_vobj_id id,
 	arcan_errc rv = ARCAN_ERRC_NO_SUCH_OBJECT;
 
 	if (src){
+		arcan_vint_atlas_release(src, true);
 		src->vstore->txu = modes;
 		src->vstore->txv = modet;
 		agp_update_vstore(src->vstore, false);
@@ -3013,6 +3885,7 @@ arcan_errc arcan_video_objectfilter(arcan_vobj_id id,
 
 /* fake an upload with disabled filteroptions */
 	if (src){
+		arcan_vint_atlas_release(src, true);
 		src->vstore->filtermode = mode;
 		agp_update_vstore(src->vstore, false);
 	}
@@ -3048,14 +3921,14 @@ arcan_errc arcan_video_copyprops ( arcan_vobj_id sid, arcan_vobj_id did )
 		surface_properties newprop;
 		arcan_resolve_vidprop(src, 0.0, &newprop);
 
-		dst->current = newprop;
+		dst->hot->current = newprop;
 /* we need to translate scale */
 		if (newprop.scale.x > 0 && newprop.scale.y > 0){
 			int dstw = newprop.scale.x * src->origw;
 			int dsth = newprop.scale.y * src->origh;
 
-			dst->current.scale.x = (float) dstw / (float) dst->origw;
-			dst->current.scale.y = (float) dsth / (float) dst->origh;
+			dst->hot->current.scale.x = (float) dstw / (float) dst->origw;
+			dst->hot->current.scale.y = (float) dsth / (float) dst->origh;
 		}
 
 		rv = ARCAN_OK;
@@ -3076,10 +3949,11 @@ arcan_errc arcan_video_copytransform(arcan_vobj_id sid, arcan_vobj_id did)
 
 /* remove what's happening in destination, move
  * pointers from source to dest and done. */
-	memcpy(&dst->current, &src->current, sizeof(surface_properties));
+	memcpy(&dst->hot->current, &src->hot->current, sizeof(surface_properties));
 
 	arcan_video_zaptransform(did, NULL);
 	dst->transform = dup_chain(src->transform);
+	activate_object(dst);
 	update_zv(dst, src->order);
 
 	invalidate_cache(dst);
@@ -3132,6 +4006,7 @@ static void drop_rtarget(arcan_vobject* vobj)
 
 /* found one, disassociate with the context */
 	current_context->n_rtargets--;
+	invalidate_rtgraph();
 	if (current_context->n_rtargets < 0){
 		arcan_warning(
 			"[bug] rtgt count (%d) < 0\n", current_context->n_rtargets);
@@ -3148,14 +4023,14 @@ static void drop_rtarget(arcan_vobject* vobj)
 
 /* create a temporary copy of all the elements in the rendertarget,
  * this will be a noop for a linked rendertarget */
-	arcan_vobject_litem* current = dst->first;
 	size_t pool_sz = (dst->color->extrefc.attachments) * sizeof(arcan_vobject*);
 	pool = arcan_alloc_mem(pool_sz, ARCAN_MEM_VSTRUCT, ARCAN_MEM_TEMPORARY,
 		ARCAN_MEMALIGN_NATURAL);
 
 /* note the contents of the rendertarget as "detached" from the source vobj */
-	while (current){
-		arcan_vobject* base = current->elem;
+	for (size_t i = 0; i < dst->n_items &&
+		cascade_c * sizeof(arcan_vobject*) < pool_sz; i++){
+		arcan_vobject* base = dst->items[i].elem;
 		pool[cascade_c++] = base;
 
 /* rtarget has one less attachment, and base is attached to one less */
@@ -3164,7 +4039,7 @@ static void drop_rtarget(arcan_vobject* vobj)
 
 		trace("(deleteobject::drop_rtarget) remove attached (%d:%s) from"
 			"	rendertarget (%d:%s), left: %d:%d\n",
-			current->elem->cellid, video_tracetag(current->elem), vobj->cellid,
+			base->cellid, video_tracetag(base), vobj->cellid,
 			video_tracetag(vobj),vobj->extrefc.attachments,base->extrefc.attachments);
 
 		if (base->extrefc.attachments < 0){
@@ -3177,14 +4052,11 @@ static void drop_rtarget(arcan_vobject* vobj)
 				"[bug] rtgt-ext-refc (%d) < 0\n", vobj->extrefc.attachments);
 		}
 
-/* cleanup and unlink before moving on */
-		arcan_vobject_litem* last = current;
-		current->elem = (arcan_vobject*) 0xfacefeed;
-		current = current->next;
-		last->next = (struct arcan_vobject_litem*) 0xdeadbeef;
-		arcan_mem_free(last);
 	}
 
+/* the pipeline goes with the rendertarget */
+	items_free(dst);
+
 /* compact the context array of rendertargets */
 	if (dstind+1 < RENDERTARGET_LIMIT)
 		memmove(&current_context->rtargets[dstind],
@@ -3329,10 +4201,10 @@ arcan_errc arcan_video_deleteobject(arcan_vobj_id id)
 		vobj->feed.state.tag = ARCAN_TAG_NONE;
 	}
 
-	if (vobj->feed.state.tag == ARCAN_TAG_ASYNCIMGLD)
-		arcan_video_pushasynch(id);
+	cancel_asynch(vobj);
 
 /* video storage, will take care of refcounting in case of shared storage */
+	arcan_vint_atlas_release(vobj, false);
 	arcan_vint_drop_vstore(vobj->vstore);
 	vobj->vstore = NULL;
 
@@ -3348,6 +4220,8 @@ arcan_errc arcan_video_deleteobject(arcan_vobj_id id)
 
 	arcan_mem_free(vobj->tracetag);
 	arcan_vint_dropshape(vobj);
+	deactivate_object(vobj);
+	drop_interp_lanes(vobj);
 
 /* lots of default values are assumed to be 0, so reset the
  * entire object to be sure. will help leak detectors as well */
@@ -3373,6 +4247,7 @@ arcan_errc arcan_video_override_mapping(arcan_vobj_id id, float* newmapping)
 	arcan_errc rv = ARCAN_ERRC_NO_SUCH_OBJECT;
 
 	if (vobj && id > 0){
+		arcan_vint_atlas_release(vobj, true);
 		if (vobj->txcos)
 			arcan_mem_free(vobj->txcos);
 
@@ -3392,7 +4267,8 @@ arcan_errc arcan_video_retrieve_mapping(arcan_vobj_id id, float* dst)
 	arcan_errc rv = ARCAN_ERRC_NO_SUCH_OBJECT;
 
 	if (vobj && dst && id > 0){
-		float* sptr = vobj->txcos ?
+/* atlas residents report the mapping they would have on their own store */
+		float* sptr = vobj->txcos && !vobj->atlas ?
 			vobj->txcos : arcan_video_display.default_txcos;
 		memcpy(dst, sptr, sizeof(float) * 8);
 		rv = ARCAN_OK;
@@ -3475,15 +4351,15 @@ arcan_errc arcan_video_objectrotate3d(arcan_vobj_id id,
 	if (tv == 0){
 		swipe_chain(vobj->transform, offsetof(surface_transform, rotate),
 			sizeof(struct transf_rotate));
-		vobj->current.rotation.roll  = roll;
-		vobj->current.rotation.pitch = pitch;
-		vobj->current.rotation.yaw   = yaw;
-		vobj->current.rotation.quaternion = build_quat_taitbryan(roll,pitch,yaw);
+		vobj->hot->current.rotation.roll  = roll;
+		vobj->hot->current.rotation.pitch = pitch;
+		vobj->hot->current.rotation.yaw   = yaw;
+		vobj->hot->current.rotation.quaternion = build_quat_taitbryan(roll,pitch,yaw);
 
 		return ARCAN_OK;
 	}
 
-	surface_orientation bv  = vobj->current.rotation;
+	surface_orientation bv  = vobj->hot->current.rotation;
 	surface_transform* base = vobj->transform;
 	surface_transform* last = base;
 
@@ -3507,6 +4383,7 @@ arcan_errc arcan_video_objectrotate3d(arcan_vobj_id id,
 
 	if (!vobj->transform)
 		vobj->transform = base;
+	activate_object(vobj);
 
 	base->rotate.startt = last->rotate.endt < arcan_video_display.c_ticks ?
 		arcan_video_display.c_ticks : last->rotate.endt;
@@ -3543,6 +4420,8 @@ arcan_errc arcan_video_allocframes(arcan_vobj_id id,
 	if (FL_TEST(target, FL_PRSIST))
 		return ARCAN_ERRC_CLONE_NOT_PERMITTED;
 
+	arcan_vint_atlas_release(target, true);
+
 /* special case, de-allocate */
 	if (capacity <= 1){
 		drop_frameset(target);
@@ -3570,6 +4449,7 @@ arcan_errc arcan_video_allocframes(arcan_vobj_id id,
 
 		target->vstore->refcount++;
 	}
+	invalidate_rtgraph();
 
 	target->frameset->mode = mode;
 
@@ -3610,10 +4490,10 @@ arcan_errc arcan_video_objectopacity(arcan_vobj_id id,
 		if (tv == 0){
 			swipe_chain(vobj->transform, offsetof(surface_transform, blend),
 				sizeof(struct transf_blend));
-			vobj->current.opa = opa;
+			vobj->hot->current.opa = opa;
 		}
 		else { /* find endpoint to attach at */
-			float bv = vobj->current.opa;
+			float bv = vobj->hot->current.opa;
 
 			surface_transform* base = vobj->transform;
 			surface_transform* last = base;
@@ -3637,6 +4517,7 @@ arcan_errc arcan_video_objectopacity(arcan_vobj_id id,
 
 			if (!vobj->transform)
 				vobj->transform = base;
+			activate_object(vobj);
 
 			if (vobj->owner)
 				vobj->owner->transfc++;
@@ -3736,9 +4617,9 @@ arcan_errc arcan_video_objectmove(arcan_vobj_id id, float newx,
 	if (tv == 0){
 		swipe_chain(vobj->transform, offsetof(surface_transform, move),
 			sizeof(struct transf_move));
-		vobj->current.position.x = newx;
-		vobj->current.position.y = newy;
-		vobj->current.position.z = newz;
+		vobj->hot->current.position.x = newx;
+		vobj->hot->current.position.y = newy;
+		vobj->hot->current.position.z = newz;
 		return ARCAN_OK;
 	}
 
@@ -3747,7 +4628,7 @@ arcan_errc arcan_video_objectmove(arcan_vobj_id id, float newx,
 	surface_transform* last = base;
 
 /* figure out the coordinates which the transformation is chained to */
-	point bwp = vobj->current.position;
+	point bwp = vobj->hot->current.position;
 
 	while (base && base->move.startt){
 		bwp = base->move.endp;
@@ -3771,6 +4652,7 @@ arcan_errc arcan_video_objectmove(arcan_vobj_id id, float newx,
 
 	if (!vobj->transform)
 		vobj->transform = base;
+	activate_object(vobj);
 
 	base->move.startt = last->move.endt < arcan_video_display.c_ticks ?
 		arcan_video_display.c_ticks : last->move.endt;
@@ -3803,16 +4685,16 @@ arcan_errc arcan_video_objectscale(arcan_vobj_id id, float wf,
 			swipe_chain(vobj->transform, offsetof(surface_transform, scale),
 				sizeof(struct transf_scale));
 
-			vobj->current.scale.x = wf;
-			vobj->current.scale.y = hf;
-			vobj->current.scale.z = df;
+			vobj->hot->current.scale.x = wf;
+			vobj->hot->current.scale.y = hf;
+			vobj->hot->current.scale.z = df;
 		}
 		else {
 			surface_transform* base = vobj->transform;
 			surface_transform* last = base;
 
 /* figure out the coordinates which the transformation is chained to */
-			scalefactor bs = vobj->current.scale;
+			scalefactor bs = vobj->hot->current.scale;
 
 			while (base && base->scale.startt){
 				bs = base->scale.endd;
@@ -3832,6 +4714,7 @@ arcan_errc arcan_video_objectscale(arcan_vobj_id id, float wf,
 
 			if (!vobj->transform)
 				vobj->transform = base;
+			activate_object(vobj);
 
 			base->scale.startt = last->scale.endt < arcan_video_display.c_ticks ?
 				arcan_video_display.c_ticks : last->scale.endt;
@@ -4014,6 +4897,9 @@ arcan_errc arcan_video_setprogram(arcan_vobj_id id, agp_shader_id shid)
 	arcan_errc rv = ARCAN_ERRC_NO_SUCH_OBJECT;
 
 	if (vobj && agp_shader_valid(shid)){
+		if (shid != agp_default_shader(BASIC_2D))
+			arcan_vint_atlas_release(vobj, true);
+
 		FLAG_DIRTY(vobj);
 		vobj->program = shid;
 		rv = ARCAN_OK;
@@ -4029,34 +4915,136 @@ static inline float lerp_fract(float startt, float endt, float ts)
 	return rv;
 }
 
+/* running transforms dirty every pipeline [vobj] is in, and through the
+ * parent chain, every pipeline its children are in */
+static void count_transform(arcan_vobject* vobj, size_t n)
+{
+	if (vobj->owner){
+		if (vobj->extrefc.attachments <= 1 && !FL_TEST(vobj, FL_RTGT))
+			vobj->owner->transfc += n;
+		else {
+			for (size_t i = 0; i < current_context->n_rtargets; i++)
+				if (items_contains(&current_context->rtargets[i], vobj))
+					current_context->rtargets[i].transfc += n;
+
+			if (items_contains(&current_context->stdoutp, vobj))
+				current_context->stdoutp.transfc += n;
+		}
+	}
+
+	for (size_t i = 0; i < vobj->childslots; i++)
+		if (vobj->children[i])
+			count_transform(vobj->children[i], 1);
+}
+
+/*
+ * Running blend/move/scale transforms are not evaluated in place, the
+ * start/end pairs are gathered into lanes here and resolved in one pass
+ * (interp_lanes, SIMD where available) once tick_active has been through.
+ * The interpolation function only shapes the per-lane weight. Completion,
+ * cycling, events and rotations stay on the per-object path.
+ */
+#define INTERP_BATCH_LANES 256
+static struct {
+	float _Alignas(16) sv[INTERP_BATCH_LANES * 4];
+	float _Alignas(16) ev[INTERP_BATCH_LANES * 4];
+	float _Alignas(16) res[INTERP_BATCH_LANES * 4];
+	float w[INTERP_BATCH_LANES];
+	float* dst[INTERP_BATCH_LANES];
+	uint8_t nc[INTERP_BATCH_LANES];
+	size_t count;
+} interp_batch;
+
+static void flush_interp_batch()
+{
+	if (!interp_batch.count)
+		return;
+
+	interp_lanes(interp_batch.res,
+		interp_batch.sv, interp_batch.ev, interp_batch.w, interp_batch.count);
+
+	for (size_t i = 0; i < interp_batch.count; i++)
+		memcpy(interp_batch.dst[i],
+			&interp_batch.res[i * 4], interp_batch.nc[i] * sizeof(float));
+
+	interp_batch.count = 0;
+}
+
+/*
+ * lifetimes and feed ticks can delete objects with lanes still queued, the
+ * hot slot can then be reused before the flush so those lanes must go
+ */
+static void drop_interp_lanes(arcan_vobject* vobj)
+{
+	if (!vobj->hot)
+		return;
+
+	uintptr_t lo = (uintptr_t) vobj->hot;
+	uintptr_t hi = lo + sizeof(struct vobject_hot);
+	size_t used = 0;
+
+	for (size_t i = 0; i < interp_batch.count; i++){
+		uintptr_t dst = (uintptr_t) interp_batch.dst[i];
+		if (dst >= lo && dst < hi)
+			continue;
+
+		if (used != i){
+			memcpy(&interp_batch.sv[used * 4], &interp_batch.sv[i * 4], 4 * sizeof(float));
+			memcpy(&interp_batch.ev[used * 4], &interp_batch.ev[i * 4], 4 * sizeof(float));
+			interp_batch.w[used] = interp_batch.w[i];
+			interp_batch.dst[used] = interp_batch.dst[i];
+			interp_batch.nc[used] = interp_batch.nc[i];
+		}
+		used++;
+	}
+
+	interp_batch.count = used;
+}
+
+static void queue_interp(float* dst, const float* sv, const float* ev,
+	uint8_t nc, enum arcan_vinterp kind, float fract)
+{
+	if (interp_batch.count == INTERP_BATCH_LANES)
+		flush_interp_batch();
+
+	size_t i = interp_batch.count++;
+	float* lsv = &interp_batch.sv[i * 4];
+	float* lev = &interp_batch.ev[i * 4];
+	for (size_t j = 0; j < 4; j++){
+		lsv[j] = j < nc ? sv[j] : 0.0;
+		lev[j] = j < nc ? ev[j] : 0.0;
+	}
+
+	interp_batch.w[i] = lut_interp_1d[kind](0.0, 1.0, fract);
+	interp_batch.dst[i] = dst;
+	interp_batch.nc[i] = nc;
+}
+
 static int update_object(arcan_vobject* ci, unsigned long long stamp)
 {
-	int upd = 0;
+	int upd = 0, own;
 
 /* update parent if this has not already been updated this cycle */
-	if (ci->last_updated < stamp &&
+	if (ci->hot->last_updated < stamp &&
 		ci->parent && ci->parent != &current_context->world &&
-		ci->parent->last_updated != stamp){
+		ci->parent->hot->last_updated != stamp){
 		upd += update_object(ci->parent, stamp);
 	}
 
-	ci->last_updated = stamp;
+	ci->hot->last_updated = stamp;
 
 	if (!ci->transform)
 		return upd;
 
+	own = upd;
+
 	if (ci->transform->blend.startt){
 		upd++;
 		float fract = lerp_fract(ci->transform->blend.startt,
 			ci->transform->blend.endt, stamp);
 
-		ci->current.opa = lut_interp_1d[ci->transform->blend.interp](
-			ci->transform->blend.startopa,
-			ci->transform->blend.endopa, fract
-		);
-
 		if (fract > 1.0-EPSILON){
-			ci->current.opa = ci->transform->blend.endopa;
+			ci->hot->current.opa = ci->transform->blend.endopa;
 
 			if (FL_TEST(ci, FL_TCYCLE)){
 				arcan_video_objectopacity(ci->cellid, ci->transform->blend.endopa,
@@ -4073,6 +5061,9 @@ static int update_object(arcan_vobject* ci, unsigned long long stamp)
 				offsetof(surface_transform, blend),
 				sizeof(struct transf_blend));
 		}
+		else
+			queue_interp(&ci->hot->current.opa, &ci->transform->blend.startopa,
+				&ci->transform->blend.endopa, 1, ci->transform->blend.interp, fract);
 	}
 
 	if (ci->transform && ci->transform->move.startt){
@@ -4080,13 +5071,8 @@ static int update_object(arcan_vobject* ci, unsigned long long stamp)
 		float fract = lerp_fract(ci->transform->move.startt,
 			ci->transform->move.endt, stamp);
 
-		ci->current.position = lut_interp_3d[ci->transform->move.interp](
-				ci->transform->move.startp,
-				ci->transform->move.endp, fract
-			);
-
 		if (fract > 1.0-EPSILON){
-			ci->current.position = ci->transform->move.endp;
+			ci->hot->current.position = ci->transform->move.endp;
 
 			if (FL_TEST(ci, FL_TCYCLE)){
 				arcan_video_objectmove(ci->cellid,
@@ -4108,19 +5094,18 @@ static int update_object(arcan_vobject* ci, unsigned long long stamp)
 				offsetof(surface_transform, move),
 				sizeof(struct transf_move));
 		}
+		else
+			queue_interp(ci->hot->current.position.xyz,
+				ci->transform->move.startp.xyz, ci->transform->move.endp.xyz,
+				3, ci->transform->move.interp, fract);
 	}
 
 	if (ci->transform && ci->transform->scale.startt){
 		upd++;
 		float fract = lerp_fract(ci->transform->scale.startt,
 			ci->transform->scale.endt, stamp);
-		ci->current.scale = lut_interp_3d[ci->transform->scale.interp](
-			ci->transform->scale.startd,
-			ci->transform->scale.endd, fract
-		);
-
 		if (fract > 1.0-EPSILON){
-			ci->current.scale = ci->transform->scale.endd;
+			ci->hot->current.scale = ci->transform->scale.endd;
 
 			if (FL_TEST(ci, FL_TCYCLE)){
 				arcan_video_objectscale(ci->cellid, ci->transform->scale.endd.x,
@@ -4139,6 +5124,10 @@ static int update_object(arcan_vobject* ci, unsigned long long stamp)
 				offsetof(surface_transform, scale),
 				sizeof(struct transf_scale));
 		}
+		else
+			queue_interp(ci->hot->current.scale.xyz,
+				ci->transform->scale.startd.xyz, ci->transform->scale.endd.xyz,
+				3, ci->transform->scale.interp, fract);
 	}
 
 	if (ci->transform && ci->transform->rotate.startt){
@@ -4148,7 +5137,7 @@ static int update_object(arcan_vobject* ci, unsigned long long stamp)
 
 /* close enough */
 		if (fract > 1.0-EPSILON){
-			ci->current.rotation = ci->transform->rotate.endo;
+			ci->hot->current.rotation = ci->transform->rotate.endo;
 			if (FL_TEST(ci, FL_TCYCLE))
 				arcan_video_objectrotate3d(ci->cellid,
 					ci->transform->rotate.endo.roll,
@@ -4166,13 +5155,18 @@ static int update_object(arcan_vobject* ci, unsigned long long stamp)
 				sizeof(struct transf_rotate));
 		}
 		else
-			ci->current.rotation.quaternion =
+			ci->hot->current.rotation.quaternion =
 				ci->transform->rotate.interp(
 					ci->transform->rotate.starto.quaternion,
 					ci->transform->rotate.endo.quaternion, fract
 				);
 	}
 
+	if (upd > own){
+		count_transform(ci, upd - own);
+		ci->hot->stamp = 0;
+	}
+
 	return upd;
 }
 
@@ -4221,22 +5215,38 @@ static inline void process_readback(struct rendertarget* tgt, float fract)
 	}
 }
 
+/* running transformations somewhere in the parent chain, possibly owned by
+ * another rendertarget than the object itself */
+static bool inherits_transform(arcan_vobject* vobj)
+{
+	for (vobj = vobj->parent;
+		vobj && vobj != &current_context->world; vobj = vobj->parent)
+		if (vobj->transform)
+			return true;
+
+	return false;
+}
+
 /*
- * return number of actual objects that were updated / dirty,
- * move/process/etc. and possibly dispatch draw commands if needed
+ * visit the active set, the parts of a logical tick that are per object:
+ * transforms, feed ticks, frameset cycling and lifetimes. Pipelines are
+ * charged for the transforms through count_transform
  */
-static int tick_rendertarget(struct rendertarget* tgt)
+static void tick_active(unsigned long long stamp)
 {
-	tgt->transfc = 0;
-	arcan_vobject_litem* current = tgt->first;
+	struct arcan_video_context* ctx = current_context;
+	size_t used = 0;
 
-	while (current){
-		arcan_vobject* elem = current->elem;
+/* index rather than pointer, feed ticks can activate (grow) the set */
+	for (size_t i = 0; i < ctx->n_active; i++){
+		if (!ctx->active[i])
+			continue;
 
-		arcan_vint_joinasynch(elem, true, false);
+		arcan_vobject* elem = &ctx->vitems_pool[ctx->active[i]];
 
-		if (elem->last_updated != arcan_video_display.c_ticks)
-			tgt->transfc += update_object(elem, arcan_video_display.c_ticks);
+/* objects can already have been updated as the parent of another */
+		if (elem->hot->last_updated != stamp)
+			update_object(elem, stamp);
 
 		if (elem->feed.ffunc)
 			arcan_ffunc_lookup(elem->feed.ffunc)
@@ -4253,12 +5263,36 @@ static int tick_rendertarget(struct rendertarget* tgt)
 
 		if ((elem->mask & MASK_LIVING) > 0)
 			expire_object(elem);
+	}
 
-		current = current->next;
+/* compact, dropping holes and objects that have nothing left to tick */
+	for (size_t i = 0; i < ctx->n_active; i++){
+		if (!ctx->active[i])
+			continue;
+
+		arcan_vobject* elem = &ctx->vitems_pool[ctx->active[i]];
+		if (!needs_tick(elem)){
+			FL_CLEAR(elem, FL_ACTIVE);
+			continue;
+		}
+
+		ctx->active[used++] = ctx->active[i];
 	}
 
+	ctx->n_active = used;
+}
+
+/*
+ * return number of actual objects that were updated / dirty and possibly
+ * dispatch draw commands if needed, the objects themselves have already been
+ * processed by tick_active
+ */
+static int tick_rendertarget(struct rendertarget* tgt)
+{
 	if (tgt->refresh > 0 && process_counter(tgt,
 		&tgt->refreshcnt, tgt->refresh, 0.0)){
+		if (rendertarget_dirty(tgt))
+			rendertarget_drawn(tgt);
 		tgt->transfc += process_rendertarget(tgt, 0.0);
 		tgt->dirtyc = 0;
 	}
@@ -4276,24 +5310,34 @@ unsigned arcan_video_tick(unsigned steps, unsigned* njobs)
 
 	unsigned now = arcan_frametime();
 	uint32_t tsd = arcan_video_display.c_ticks;
+	unsigned jobs = 0;
 
 #ifdef SHADER_TIME_PERIOD
 	tsd = tsd % SHADER_TIME_PERIOD;
 #endif
 
 	do {
+		for (size_t i = 0; i < current_context->n_rtargets; i++)
+			current_context->rtargets[i].transfc = 0;
+		current_context->stdoutp.transfc = 0;
+
 		arcan_video_display.dirty +=
 			update_object(&current_context->world, arcan_video_display.c_ticks);
 
 		arcan_video_display.dirty +=
 			agp_shader_envv(TIMESTAMP_D, &tsd, sizeof(uint32_t));
 
+/* everything is updated before any rendertarget gets to draw */
+		tick_active(arcan_video_display.c_ticks);
+		flush_interp_batch();
+		arcan_video_display.resolve_clock++;
+
+/* rendertargets track their own transformations as dirty, only the world
+ * and shared shader state above affects all of them */
 		for (size_t i = 0; i < current_context->n_rtargets; i++)
-			arcan_video_display.dirty +=
-				tick_rendertarget(&current_context->rtargets[i]);
+			jobs += tick_rendertarget(&current_context->rtargets[i]);
 
-		arcan_video_display.dirty +=
-			tick_rendertarget(&current_context->stdoutp);
+		jobs += tick_rendertarget(&current_context->stdoutp);
 
 /*
  * we don't want c_ticks running too high (the tick is monotonic, but not
@@ -4308,7 +5352,7 @@ unsigned arcan_video_tick(unsigned steps, unsigned* njobs)
 	} while (steps);
 
 	if (njobs)
-		*njobs = arcan_video_display.dirty;
+		*njobs = arcan_video_display.dirty + jobs;
 
 	return arcan_frametime() - now;
 }
@@ -4331,6 +5375,7 @@ arcan_errc arcan_video_persistobject(arcan_vobj_id id)
 	if (!vobj)
 		return ARCAN_ERRC_NO_SUCH_OBJECT;
 
+	arcan_vint_atlas_release(vobj, true);
 	if (!vobj->frameset &&
 		vobj->vstore->refcount == 1 &&
 		vobj->parent == &current_context->world){
@@ -4348,7 +5393,7 @@ bool arcan_video_visible(arcan_vobj_id id)
 	arcan_vobject* vobj= arcan_video_getobject(id);
 
 	if (vobj && id > 0)
-		return vobj->current.opa > EPSILON;
+		return vobj->hot->current.opa > EPSILON;
 
 	return rv;
 }
@@ -4358,7 +5403,7 @@ bool arcan_video_visible(arcan_vobj_id id)
 static void apply(arcan_vobject* vobj, surface_properties* dprops,
 	surface_properties* sprops, float lerp, bool force)
 {
-	*dprops = vobj->current;
+	*dprops = vobj->hot->current;
 
 	if (vobj->transform){
 		surface_transform* tf = vobj->transform;
@@ -4421,6 +5466,21 @@ static void apply(arcan_vobject* vobj, surface_properties* dprops,
 	}
 }
 
+/* running transforms here or in the parent chain, known without the walk
+ * for anything resolved on the current clock */
+static bool chain_moving(arcan_vobject* vobj)
+{
+	for (; vobj; vobj = vobj->parent){
+		if (vobj->transform)
+			return true;
+
+		if (vobj->hot->stamp == arcan_video_display.resolve_clock)
+			return vobj->hot->moving;
+	}
+
+	return false;
+}
+
 /*
  * Caching works as follows;
  * Any object that has a parent with an ongoing transformation
@@ -4429,39 +5489,67 @@ static void apply(arcan_vobject* vobj, surface_properties* dprops,
  * and a resolve- pass is performed with its results stored in prop_matr
  * which is then re-used every rendercall.
  * Queueing a transformation immediately invalidates the cache.
+ *
+ * Objects that can't be cached still keep their last result in prop_cache
+ * along with the generation of the parent it was derived from. It is reused
+ * as is on the same clock (so each node in a moving hierarchy is resolved
+ * once per pass rather than once per descendant), and on later passes while
+ * the object hasn't changed and its parent is still at the same generation.
  */
 void arcan_resolve_vidprop(arcan_vobject* vobj, float lerp,
 	surface_properties* props)
 {
-	if (vobj->valid_cache)
-		*props = vobj->prop_cache;
+	struct vobject_hot* hot = vobj->hot;
+	arcan_vobject* parent = vobj->parent != &current_context->world ?
+		vobj->parent : NULL;
+	surface_properties dprop = empty_surface();
+
+	if (hot->valid_cache){
+		*props = hot->prop_cache;
+		return;
+	}
+
+	if (hot->stamp == arcan_video_display.resolve_clock && hot->lerp == lerp){
+		*props = hot->prop_cache;
+		return;
+	}
+
+	if (parent)
+		arcan_resolve_vidprop(parent, lerp, &dprop);
+
+/* nothing changed locally and the parent resolved to the same state */
+	if (hot->stamp && !vobj->transform && parent &&
+		parent->hot->gen == hot->parent_gen){
+		hot->stamp = arcan_video_display.resolve_clock;
+		hot->lerp = lerp;
+		*props = hot->prop_cache;
+		goto cache;
+	}
 
 /* first recurse to parents */
-	else if (vobj->parent && vobj->parent != &current_context->world){
-		surface_properties dprop = empty_surface();
-		arcan_resolve_vidprop(vobj->parent, lerp, &dprop);
+	if (parent){
 		apply(vobj, props, &dprop, lerp, false);
 		switch(vobj->p_anchor){
 		case ANCHORP_UR:
-			props->position.x += vobj->parent->origw * vobj->parent->current.scale.x;
+			props->position.x += vobj->parent->origw * vobj->parent->hot->current.scale.x;
 		break;
 		case ANCHORP_LR:
-			props->position.y += vobj->parent->origh * vobj->parent->current.scale.y;
-			props->position.x += vobj->parent->origw * vobj->parent->current.scale.x;
+			props->position.y += vobj->parent->origh * vobj->parent->hot->current.scale.y;
+			props->position.x += vobj->parent->origw * vobj->parent->hot->current.scale.x;
 		break;
 		case ANCHORP_LL:
-			props->position.y += vobj->parent->origh * vobj->parent->current.scale.y;
+			props->position.y += vobj->parent->origh * vobj->parent->hot->current.scale.y;
 		break;
 		case ANCHORP_CR:
-			props->position.y += vobj->parent->origh * vobj->parent->current.scale.y * 0.5;
-			props->position.x += vobj->parent->origw * vobj->parent->current.scale.x;
+			props->position.y += vobj->parent->origh * vobj->parent->hot->current.scale.y * 0.5;
+			props->position.x += vobj->parent->origw * vobj->parent->hot->current.scale.x;
 		break;
 		case ANCHORP_C:
 		case ANCHORP_UC:
 		case ANCHORP_CL:
 		case ANCHORP_LC:{
-			float mid_y = (vobj->parent->origh * vobj->parent->current.scale.y) * 0.5;
-			float mid_x = (vobj->parent->origw * vobj->parent->current.scale.x) * 0.5;
+			float mid_y = (vobj->parent->origh * vobj->parent->hot->current.scale.y) * 0.5;
+			float mid_x = (vobj->parent->origw * vobj->parent->hot->current.scale.x) * 0.5;
 			if (vobj->p_anchor == ANCHORP_UC ||
 				vobj->p_anchor == ANCHORP_LC || vobj->p_anchor == ANCHORP_C)
 				props->position.x += mid_x;
@@ -4470,7 +5558,7 @@ void arcan_resolve_vidprop(arcan_vobject* vobj, float lerp,
 				props->position.y += mid_y;
 
 			if (vobj->p_anchor == ANCHORP_LC)
-				props->position.y += vobj->parent->origh * vobj->parent->current.scale.y;
+				props->position.y += vobj->parent->origh * vobj->parent->hot->current.scale.y;
 		}
 		case ANCHORP_UL:
 		default:
@@ -4478,26 +5566,26 @@ void arcan_resolve_vidprop(arcan_vobject* vobj, float lerp,
 		}
 	}
 	else
-		apply(vobj, props, &current_context->world.current, lerp, true);
+		apply(vobj, props, &current_context->world.hot->current, lerp, true);
 
-	arcan_vobject* current = vobj;
-	bool can_cache = true;
-	while (current){
-		if (current->transform){
-			can_cache = false;
-			break;
-		}
-		current = current->parent;
-	}
+/* new generation if this is a local change or the result differs, so that
+ * children of an object that moves back and forth don't recompute for nothing */
+	if (!hot->stamp || memcmp(props, &hot->prop_cache, sizeof(surface_properties)))
+		hot->gen = ++arcan_video_display.resolve_gen;
 
-	if (can_cache && vobj->owner && vobj->valid_cache == false){
+	hot->prop_cache = *props;
+	hot->parent_gen = parent ? parent->hot->gen : 0;
+	hot->stamp = arcan_video_display.resolve_clock;
+	hot->lerp = lerp;
+
+cache:
+	hot->moving = vobj->transform || chain_moving(vobj->parent);
+
+	if (!hot->moving && vobj->owner){
 		surface_properties dprop = *props;
-		vobj->prop_cache  = *props;
-		vobj->valid_cache = true;
-		build_modelview(vobj->prop_matr, vobj->owner->base, &dprop, vobj);
+		hot->valid_cache = true;
+		build_modelview(hot->prop_matr, vobj->owner->base, &dprop, vobj);
 	}
-	else
-		;
 }
 
 static void calc_cp_area(arcan_vobject* vobj, point* ul, point* lr)
@@ -4615,12 +5703,12 @@ static inline void setup_surf(struct rendertarget* dst,
 		return;
 
 /* currently, we only cache the primary rendertarget */
-	if (src->valid_cache && dst == src->owner){
+	if (src->hot->valid_cache && dst == src->owner){
 		prop->scale.x *= src->origw * 0.5f;
 		prop->scale.y *= src->origh * 0.5f;
 		prop->position.x += prop->scale.x;
 		prop->position.y += prop->scale.y;
-		*mv = src->prop_matr;
+		*mv = src->hot->prop_matr;
 	}
 	else {
 		build_modelview(dmatr, dst->base, prop, src);
@@ -4760,15 +5848,13 @@ arcan_errc arcan_vint_pollfeed(arcan_vobj_id vid, bool step)
  * all cases where n*obj_size < data_cache_size} as that hit/miss is
  * really all that matters now.
  */
-static void poll_list(arcan_vobject_litem* current, int cookie)
+static void poll_list(struct rendertarget* tgt, int cookie)
 {
-	while(current && current->elem){
-		arcan_vobject* celem = current->elem;
+	for (size_t i = 0; i < tgt->n_items; i++){
+		arcan_vobject* celem = tgt->items[i].elem;
 
 		if (celem->feed.ffunc)
 			ffunc_process(celem, cookie, true);
-
-		current = current->next;
 	}
 }
 
@@ -4785,9 +5871,9 @@ void arcan_video_pollfeed()
 	arcan_vint_pollreadback(&current_context->stdoutp);
 
 	for (size_t i = 0; i < current_context->n_rtargets; i++)
-		poll_list(current_context->rtargets[i].first, vcookie);
+		poll_list(&current_context->rtargets[i], vcookie);
 
-	poll_list(current_context->stdoutp.first, vcookie);
+	poll_list(&current_context->stdoutp, vcookie);
 }
 
 static inline void populate_stencil(struct rendertarget* tgt,
@@ -4934,11 +6020,296 @@ static inline bool setup_shallow_texclip(arcan_vobject* elem,
 	dprops->scale.y = cp_h / elem->origh;
 
 /* this is expensive, we should instead temporarily offset */
-	elem->valid_cache = false;
+	elem->hot->valid_cache = false;
 	*txcos = cliptxbuf;
 	return true;
 }
 
+/*
+ * corners of the 2D quad of [vobj] as drawn with the resolved [prop],
+ * rotated (roll only, as in build_modelview) around the center or the
+ * user-defined origin offset
+ */
+static void object_corners(
+	arcan_vobject* vobj, surface_properties* prop, vector* res)
+{
+	float w = (float)vobj->origw * prop->scale.x;
+	float h = (float)vobj->origh * prop->scale.y;
+
+	res[0].x = prop->position.x;
+	res[0].y = prop->position.y;
+	res[1].x = res[0].x + w;
+	res[1].y = res[0].y;
+	res[2].x = res[1].x;
+	res[2].y = res[1].y + h;
+	res[3].x = res[0].x;
+	res[3].y = res[2].y;
+
+	if (fabsf(prop->rotation.roll) > EPSILON){
+		float ang = DEG2RAD(prop->rotation.roll);
+		float sinv = sinf(ang);
+		float cosv = cosf(ang);
+
+		float cpx = res[0].x + 0.5 * w;
+		float cpy = res[0].y + 0.5 * h;
+
+		if (vobj->origo_ofs.x > EPSILON || vobj->origo_ofs.y > EPSILON){
+			cpx += vobj->origo_ofs.x;
+			cpy += vobj->origo_ofs.y;
+		}
+
+		for (size_t i = 0; i < 4; i++){
+			float rx = cosv * (res[i].x - cpx) - sinv * (res[i].y-cpy) + cpx;
+			float ry = sinv * (res[i].x - cpx) + cosv * (res[i].y-cpy) + cpy;
+			res[i].x = rx;
+			res[i].y = ry;
+		}
+	}
+}
+
+/*
+ * project the resolved 2D bounds of [elem] into pixels of the output of
+ * [tgt] (origin lower-left, padded to cover filtering), rotated objects use
+ * the bounding box of their corners. Returns false if the screen space
+ * footprint can't be cheaply determined (3D, shape/mesh with possible vertex
+ * stage displacement).
+ */
+static bool object_box(struct rendertarget* tgt, arcan_vobject* elem,
+	surface_properties* dprops, struct agp_region* out)
+{
+	if (elem->shape || FL_TEST(elem, FL_FULL3D) ||
+		elem->feed.state.tag == ARCAN_TAG_3DOBJ ||
+		!tgt->color || !tgt->color->vstore)
+		return false;
+
+	float w = tgt->color->vstore->w;
+	float h = tgt->color->vstore->h;
+	float* b = tgt->base;
+	float* p = tgt->projection;
+
+	vector corners[4];
+	object_corners(elem, dprops, corners);
+
+	float x1 = INFINITY, y1 = INFINITY, x2 = -INFINITY, y2 = -INFINITY;
+	for (size_t i = 0; i < 4; i++){
+		float x = ((p[0] * (b[0] * corners[i].x + b[12]) + p[12]) + 1.0) * 0.5 * w;
+		float y = ((p[5] * (b[5] * corners[i].y + b[13]) + p[13]) + 1.0) * 0.5 * h;
+		x1 = fminf(x1, x);
+		y1 = fminf(y1, y);
+		x2 = fmaxf(x2, x);
+		y2 = fmaxf(y2, y);
+	}
+
+	x1 = floorf(x1) - 1.0;
+	y1 = floorf(y1) - 1.0;
+	x2 = ceilf(x2) + 1.0;
+	y2 = ceilf(y2) + 1.0;
+
+	if (isnan(x1) || isnan(y1) || isnan(x2) || isnan(y2))
+		return false;
+
+	out->x1 = x1 < 0 ? 0 : (x1 > w ? w : x1);
+	out->y1 = y1 < 0 ? 0 : (y1 > h ? h : y1);
+	out->x2 = x2 < 0 ? 0 : (x2 > w ? w : x2);
+	out->y2 = y2 < 0 ? 0 : (y2 > h ? h : y2);
+
+	return true;
+}
+
+static void region_union(struct agp_region* dst, struct agp_region* src)
+{
+	if (src->x1 == src->x2 || src->y1 == src->y2)
+		return;
+
+	if (dst->x1 == dst->x2 || dst->y1 == dst->y2){
+		*dst = *src;
+		return;
+	}
+
+	dst->x1 = src->x1 < dst->x1 ? src->x1 : dst->x1;
+	dst->y1 = src->y1 < dst->y1 ? src->y1 : dst->y1;
+	dst->x2 = src->x2 > dst->x2 ? src->x2 : dst->x2;
+	dst->y2 = src->y2 > dst->y2 ? src->y2 : dst->y2;
+}
+
+static bool region_overlap(struct agp_region* a, struct agp_region* b)
+{
+	return a->x1 < b->x2 && a->x2 > b->x1 && a->y1 < b->y2 && a->y2 > b->y1;
+}
+
+/*
+ * Sweep the pipeline of [tgt] and build the union of the previous and the
+ * current bounds of everything that has changed since the last draw. Returns
+ * false if some change can't be bounded, meaning the whole target needs to
+ * be redrawn.
+ */
+static bool rendertarget_damage(
+	struct rendertarget* tgt, float fract, struct agp_region* out)
+{
+	*out = (struct agp_region){0};
+
+	for (size_t i = 0; i < tgt->n_items; i++){
+		arcan_vobject* elem = tgt->items[i].elem;
+		if (elem->order < 0 || elem->owner != tgt)
+			return false;
+
+		if (elem == tgt->color ||
+			elem->order < tgt->min_order || elem->order > tgt->max_order)
+			continue;
+
+		if (!elem->damage.changed && !elem->transform && elem->hot->valid_cache &&
+			elem->damage.valid && !inherits_transform(elem))
+			continue;
+
+		surface_properties dprops = empty_surface();
+		arcan_resolve_vidprop(elem, fract, &dprops);
+
+/* old position needs to be restored with whatever is beneath it */
+		if (elem->damage.valid){
+			struct agp_region old = {
+				.x1 = elem->damage.x1, .y1 = elem->damage.y1,
+				.x2 = elem->damage.x2, .y2 = elem->damage.y2
+			};
+			region_union(out, &old);
+		}
+
+		elem->damage.valid = false;
+		elem->damage.changed = false;
+		if (dprops.opa <= EPSILON)
+			continue;
+
+		struct agp_region box;
+		if (!object_box(tgt, elem, &dprops, &box))
+			return false;
+
+		region_union(out, &box);
+		elem->damage.valid = true;
+		elem->damage.x1 = box.x1;
+		elem->damage.y1 = box.y1;
+		elem->damage.x2 = box.x2;
+		elem->damage.y2 = box.y2;
+	}
+
+	return true;
+}
+
+/*
+ * Consecutive 2D objects that only differ in their modelview (same store,
+ * default shader, blend state and opacity) are transformed on the CPU and
+ * collected here, so they can be submitted as a single draw call.
+ */
+#define BATCH_LIMIT 512
+static struct {
+	struct agp_vstore* store;
+	enum arcan_blendfunc blend;
+	float opa;
+	size_t count;
+	float _Alignas(16) verts[BATCH_LIMIT * 12];
+	float _Alignas(16) txcos[BATCH_LIMIT * 12];
+} batch;
+
+static enum arcan_blendfunc object_blend(arcan_vobject* elem, float opa)
+{
+	if (opa < 1.0 - EPSILON || elem->blendmode == BLEND_NONE ||
+		elem->blendmode == BLEND_FORCE)
+		return elem->blendmode;
+
+	return BLEND_NORMAL;
+}
+
+static void flush_batch()
+{
+	if (!batch.count)
+		return;
+
+	agp_shader_activate(agp_default_shader(BASIC_2D));
+	agp_shader_envv(OBJ_OPACITY, &batch.opa, sizeof(float));
+	agp_blendstate(batch.blend);
+	agp_activate_vstore(batch.store);
+	agp_draw_vobj_batch(batch.verts, batch.txcos, batch.count);
+	batch.count = 0;
+}
+
+/*
+ * Add [elem] to the current batch if it qualifies, flushing the batch first
+ * on a state mismatch. Returns false if the object needs the regular draw
+ * path (custom shader, clipping, shapes, multitexturing, 3D orientation).
+ */
+static bool batch_object(struct rendertarget* tgt,
+	arcan_vobject* elem, surface_properties* dprops)
+{
+	agp_shader_id defshdr = agp_default_shader(BASIC_2D);
+	if ((elem->program != 0 && elem->program != defshdr) ||
+		elem->shape || FL_TEST(elem, FL_FULL3D) ||
+		elem->vstore->txmapped != TXSTATE_TEX2D ||
+		elem->feed.state.tag == ARCAN_TAG_ASYNCIMGLD ||
+		(elem->clip != ARCAN_CLIP_OFF && elem->parent != &current_context->world))
+		return false;
+
+	struct agp_vstore* store = elem->vstore;
+	float* txcos = elem->txcos;
+	if ( (elem->mask & MASK_MAPPING) > 0)
+		txcos = elem->parent != &current_context->world ?
+			elem->parent->txcos : elem->txcos;
+
+	if (elem->frameset){
+		if (elem->frameset->mode == ARCAN_FRAMESET_MULTITEXTURE)
+			return false;
+
+		struct frameset_store* ds =
+			&elem->frameset->frames[elem->frameset->index];
+		store = ds->frame;
+		txcos = ds->txcos;
+	}
+
+	if (!txcos)
+		txcos = arcan_video_display.default_txcos;
+
+	enum arcan_blendfunc blend = object_blend(elem, dprops->opa);
+
+	if (batch.count && (batch.count == BATCH_LIMIT || batch.store != store ||
+		batch.blend != blend || batch.opa != dprops->opa))
+		flush_batch();
+
+	batch.store = store;
+	batch.blend = blend;
+	batch.opa = dprops->opa;
+
+/* same modelview as setup_surf would produce, but without the uniforms */
+	float _Alignas(16) dmatr[16];
+	float* m = dmatr;
+	surface_properties prop = *dprops;
+
+	if (elem->hot->valid_cache && tgt == elem->owner){
+		prop.scale.x *= elem->origw * 0.5f;
+		prop.scale.y *= elem->origh * 0.5f;
+		m = elem->hot->prop_matr;
+	}
+	else
+		build_modelview(dmatr, tgt->base, &prop, elem);
+
+	float ov[4][2] = {
+		{-prop.scale.x, -prop.scale.y}, { prop.scale.x, -prop.scale.y},
+		{ prop.scale.x,  prop.scale.y}, {-prop.scale.x,  prop.scale.y}
+	};
+
+/* two triangles, (0, 1, 2) and (0, 2, 3) */
+	static const size_t tri[] = {0, 1, 2, 0, 2, 3};
+	float* dv = &batch.verts[batch.count * 12];
+	float* dt = &batch.txcos[batch.count * 12];
+
+	for (size_t i = 0; i < 6; i++){
+		float x = ov[tri[i]][0], y = ov[tri[i]][1];
+		dv[i * 2 + 0] = m[0] * x + m[4] * y + m[12];
+		dv[i * 2 + 1] = m[1] * x + m[5] * y + m[13];
+		dt[i * 2 + 0] = txcos[tri[i] * 2 + 0];
+		dt[i * 2 + 1] = txcos[tri[i] * 2 + 1];
+	}
+
+	batch.count++;
+	return true;
+}
+
 _Thread_local static struct rendertarget* current_rendertarget;
 struct rendertarget* arcan_vint_current_rt()
 {
@@ -4947,17 +6318,18 @@ struct rendertarget* arcan_vint_current_rt()
 
 static size_t process_rendertarget(struct rendertarget* tgt, float fract)
 {
-	arcan_vobject_litem* current;
+	struct rendertarget* base = tgt;
 	if (tgt->link){
-		current = tgt->link->first;
+		base = tgt->link;
 		tgt->dirtyc += tgt->link->dirtyc;
 		tgt->transfc += tgt->link->transfc;
 	}
-	else
-		current = tgt->first;
+
+/* walked until the NULL terminator, an empty pipeline might lack storage */
+	arcan_vobject_litem* current = base->n_items ? base->items : NULL;
 
 	if (arcan_video_display.ignore_dirty == 0 &&
-		(!tgt->link && tgt->dirtyc == 0 && tgt->transfc == 0))
+		tgt->dirtyc == 0 && tgt->transfc == 0)
 		return 0;
 
 	current_rendertarget = tgt;
@@ -4965,6 +6337,16 @@ static size_t process_rendertarget(struct rendertarget* tgt, float fract)
 	agp_shader_envv(RTGT_ID, &tgt->id, sizeof(int));
 	agp_shader_envv(OBJ_OPACITY, &(float){1.0}, sizeof(float));
 
+/* if the changes can be bounded and the previous contents are still there,
+ * restrict clear and draw to the damaged region and skip whatever is outside */
+	struct agp_region damage;
+	bool partial = !tgt->full_redraw && !tgt->link &&
+		arcan_video_display.ignore_dirty == 0 &&
+		rendertarget_damage(tgt, fract, &damage) &&
+		damage.x1 != damage.x2 && damage.y1 != damage.y2 &&
+		agp_rendertarget_clip(&damage);
+	tgt->full_redraw = false;
+
 	if (!FL_TEST(tgt, TGTFL_NOCLEAR))
 		agp_rendertarget_clear();
 
@@ -4977,10 +6359,10 @@ static size_t process_rendertarget(struct rendertarget* tgt, float fract)
 	}
 
 /* skip a possible 3d pipeline */
-	while (current && current->elem->order < 0)
-		current = current->next;
+	while (current && current->elem && current->elem->order < 0)
+		current++;
 
-	if (!current)
+	if (!current || !current->elem)
 		goto end3d;
 
 /* make sure we're in a decent state for 2D */
@@ -4989,13 +6371,11 @@ static size_t process_rendertarget(struct rendertarget* tgt, float fract)
 	agp_shader_activate(agp_default_shader(BASIC_2D));
 	agp_shader_envv(PROJECTION_MATR, tgt->projection, sizeof(float)*16);
 
-	while (current && current->elem->order >= 0){
+	for (; current->elem && current->elem->order >= 0; current++){
 		arcan_vobject* elem = current->elem;
 
-		if (current->elem->order < tgt->min_order){
-			current = current->next;
+		if (current->elem->order < tgt->min_order)
 			continue;
-		}
 
 		if (current->elem->order > tgt->max_order)
 			break;
@@ -5004,11 +6384,31 @@ static size_t process_rendertarget(struct rendertarget* tgt, float fract)
 		surface_properties dprops = empty_surface();
 		arcan_resolve_vidprop(elem, fract, &dprops);
 
+/* remember the footprint for the next partial pass */
+		struct agp_region box;
+		bool has_box = false;
+		if (elem->owner == tgt && !tgt->link && elem != tgt->color){
+			has_box = dprops.opa > EPSILON && object_box(tgt, elem, &dprops, &box);
+			elem->damage.valid = has_box;
+			elem->damage.changed = false;
+			if (has_box){
+				elem->damage.x1 = box.x1;
+				elem->damage.y1 = box.y1;
+				elem->damage.x2 = box.x2;
+				elem->damage.y2 = box.y2;
+			}
+		}
+
 /* don't waste time on objects that aren't supposed to be visible */
-		if ( dprops.opa <= EPSILON || elem == tgt->color){
-			current = current->next;
+		if ( dprops.opa <= EPSILON || elem == tgt->color ||
+			(partial && has_box && !region_overlap(&box, &damage)))
+			continue;
+
+		if (batch_object(tgt, elem, &dprops)){
+			pc++;
 			continue;
 		}
+		flush_batch();
 
 /* enable clipping using stencil buffer, we need to reset the state of the
  * stencil buffer between draw calls so track if it's enabled or not */
@@ -5058,10 +6458,8 @@ static size_t process_rendertarget(struct rendertarget* tgt, float fract)
  * out through the drawing region */
 		if (elem->clip == ARCAN_CLIP_SHALLOW &&
 			elem->parent != &current_context->world && !elem->rotate_state){
-			if (!setup_shallow_texclip(elem, dstcos, &dprops, fract)){
-				current = current->next;
+			if (!setup_shallow_texclip(elem, dstcos, &dprops, fract))
 				continue;
-			}
 		}
 		else if (elem->clip != ARCAN_CLIP_OFF &&
 			elem->parent != &current_context->world){
@@ -5072,13 +6470,7 @@ static size_t process_rendertarget(struct rendertarget* tgt, float fract)
 		if (!shader_sw)
 			agp_shader_activate(shid);
 
-		if (dprops.opa < 1.0 - EPSILON || elem->blendmode == BLEND_NONE)
-			agp_blendstate(elem->blendmode);
-		else
-			if (elem->blendmode == BLEND_FORCE)
-				agp_blendstate(elem->blendmode);
-			else
-				agp_blendstate(BLEND_NORMAL);
+		agp_blendstate(object_blend(elem, dprops.opa));
 
 		if (elem->vstore->txmapped == TXSTATE_OFF && elem->program != 0)
 			draw_colorsurf(tgt, dprops, elem, elem->vstore->vinf.col.r,
@@ -5091,20 +6483,22 @@ static size_t process_rendertarget(struct rendertarget* tgt, float fract)
 
 		if (clipped)
 			agp_disable_stencil();
-
-		current = current->next;
 	}
+	flush_batch();
 
 /* reset and try the 3d part again if requested */
 end3d:
-	current = tgt->first;
+	current = base->n_items ? base->items : NULL;
 	if (current && current->elem->order < 0 && tgt->order3d == ORDER3D_LAST){
 		agp_shader_activate(agp_default_shader(BASIC_2D));
 		current = arcan_3d_refresh(tgt->camtag, current, fract);
-		if (current != tgt->first)
+		if (current != base->items)
 			pc++;
 	}
 
+/* contents are now whole, which is what the next partial pass builds on */
+	agp_rendertarget_clip(NULL);
+
 	return pc;
 }
 
@@ -5120,9 +6514,13 @@ arcan_errc arcan_video_forceread(arcan_vobj_id sid, bool local,
  */
 
 	arcan_vobject* vobj = arcan_video_getobject(sid);
+	if (!vobj)
+		return ARCAN_ERRC_NO_SUCH_OBJECT;
+
+	arcan_vint_atlas_release(vobj, true);
 	struct agp_vstore* dstore = vobj->vstore;
 
-	if (!vobj || !dstore)
+	if (!dstore)
 		return ARCAN_ERRC_NO_SUCH_OBJECT;
 
 	if (dstore->txmapped != TXSTATE_TEX2D)
@@ -5178,6 +6576,7 @@ arcan_errc arcan_video_forceupdate(arcan_vobj_id vid)
 
 	size_t id = arcan_video_display.ignore_dirty;
 	arcan_video_display.ignore_dirty = 1;
+	rendertarget_drawn(tgt);
 	process_rendertarget(tgt, arcan_video_display.c_lerp);
 	arcan_video_display.ignore_dirty = id;
 	current_rendertarget = NULL;
@@ -5234,28 +6633,37 @@ void arcan_vint_pollreadback(struct rendertarget* tgt)
 	FL_CLEAR(tgt, TGTFL_READING);
 }
 
-static size_t steptgt(float fract, struct rendertarget* tgt)
+/* returns true if the contents of [tgt] were redrawn */
+static bool steptgt(float fract, struct rendertarget* tgt)
 {
-	size_t transfc = 0;
+	bool drawn = false;
 	if (tgt->refresh < 0 && process_counter(tgt,
 		&tgt->refreshcnt, tgt->refresh, fract)){
+		drawn = rendertarget_dirty(tgt);
+		if (drawn)
+			rendertarget_drawn(tgt);
+
 		process_rendertarget(tgt, fract);
-		transfc = tgt->transfc;
 		tgt->dirtyc = 0;
 /* may need to readback even if we havn't updated as it may
  * be used as clock (though optimization possibility of using buffer) */
 		process_readback(tgt, fract);
 	}
-	return transfc;
+	return drawn;
 }
 
 unsigned arcan_vint_refresh(float fract, size_t* ndirty)
 {
 	long long int pre = arcan_timemillis();
-	size_t transfc = 0;
+	uint64_t ts = arcan_conductor_trace_begin();
+	size_t drawn = 0;
 
 /* we track last interp. state in order to handle forcerefresh */
 	arcan_video_display.c_lerp = fract;
+	arcan_video_display.resolve_clock++;
+
+/* packed surfaces are synched once per page rather than per object */
+	arcan_vint_atlas_flush();
 
 /* active shaders with counter counts towards dirty */
 	arcan_video_display.dirty +=
@@ -5264,11 +6672,22 @@ unsigned arcan_vint_refresh(float fract, size_t* ndirty)
 	if (arcan_video_display.ignore_dirty > 0)
 		arcan_video_display.ignore_dirty--;
 
-/* rendertargets may be composed on world- output, begin there */
-	for (size_t ind = 0; ind < current_context->n_rtargets; ind++){
-		struct rendertarget* tgt = &current_context->rtargets[ind];
-		tgt->dirtyc += arcan_video_display.dirty;
-		transfc += steptgt(fract, tgt);
+	if (!current_context->rtgraph.valid)
+		rebuild_rtgraph();
+
+/* rendertargets may be composed on world- output, begin there in dependency
+ * order so that a redrawn rendertarget can dirty its consumers in the same
+ * pass. Global dirty goes to all of them. Targets that are only mapped to
+ * displays that can't take a new frame yet are held, they keep accumulating
+ * dirty and get drawn when that display is ready */
+	size_t dirty = arcan_video_display.dirty;
+	for (size_t i = 0; i < current_context->n_rtargets; i++){
+		struct rendertarget* tgt =
+			&current_context->rtargets[current_context->rtgraph.order[i]];
+		tgt->dirtyc += dirty;
+		tgt->full_redraw |= dirty > 0;
+		if (!arcan_conductor_display_held(rtid(tgt)))
+			drawn += steptgt(fract, tgt);
 	}
 
 /* reset the bound rendertarget, otherwise we may be in an undefined
@@ -5276,10 +6695,16 @@ unsigned arcan_vint_refresh(float fract, size_t* ndirty)
 	current_rendertarget = NULL;
 	agp_activate_rendertarget(NULL);
 
-	current_context->stdoutp.dirtyc += arcan_video_display.dirty;
-	transfc += steptgt(fract, &current_context->stdoutp);
-	*ndirty = arcan_video_display.dirty;
-	arcan_video_display.dirty = transfc;
+	current_context->stdoutp.dirtyc += dirty;
+	current_context->stdoutp.full_redraw |= dirty > 0;
+	if (!arcan_conductor_display_held(ARCAN_VIDEO_WORLDID))
+		drawn += steptgt(fract, &current_context->stdoutp);
+
+/* running transformations stay as dirty on their rendertarget until the
+ * next tick, so there is nothing to carry over */
+	*ndirty = dirty + drawn;
+	arcan_video_display.dirty = 0;
+	arcan_conductor_trace(CONDUCTOR_TRACE_REFRESH, ts, -1);
 
 	long long int post = arcan_timemillis();
 	return post - pre;
@@ -5309,41 +6734,14 @@ arcan_errc arcan_video_screencoords(arcan_vobj_id id, vector* res)
 
 	surface_properties prop;
 
-	if (vobj->valid_cache)
-		prop = vobj->prop_cache;
+	if (vobj->hot->valid_cache)
+		prop = vobj->hot->prop_cache;
 	else {
 		prop = empty_surface();
 		arcan_resolve_vidprop(vobj, arcan_video_display.c_lerp, &prop);
 	}
 
-	float w = (float)vobj->origw * prop.scale.x;
-	float h = (float)vobj->origh * prop.scale.y;
-
-	res[0].x = prop.position.x;
-	res[0].y = prop.position.y;
-	res[1].x = res[0].x + w;
-	res[1].y = res[0].y;
-	res[2].x = res[1].x;
-	res[2].y = res[1].y + h;
-	res[3].x = res[0].x;
-	res[3].y = res[2].y;
-
-	if (fabsf(prop.rotation.roll) > EPSILON){
-		float ang = DEG2RAD(prop.rotation.roll);
-		float sinv = sinf(ang);
-		float cosv = cosf(ang);
-
-		float cpx = res[0].x + 0.5 * w;
-		float cpy = res[0].y + 0.5 * h;
-
-		for (size_t i = 0; i < 4; i++){
-			float rx = cosv * (res[i].x - cpx) - sinv * (res[i].y-cpy) + cpx;
-			float ry = sinv * (res[i].x - cpx) + cosv * (res[i].y-cpy) + cpy;
-			res[i].x = rx;
-			res[i].y = ry;
-		}
-	}
-
+	object_corners(vobj, &prop, res);
 	return ARCAN_OK;
 }
 
@@ -5404,6 +6802,7 @@ arcan_errc arcan_video_sliceobject(arcan_vobj_id sid,
 	if (!src)
 		return ARCAN_ERRC_NO_SUCH_OBJECT;
 
+	arcan_vint_atlas_release(src, true);
 	return (agp_slice_vstore(src->vstore, n_slices, base,
 		type == ARCAN_CUBEMAP ? TXSTATE_CUBE : TXSTATE_TEX3D))
 		? ARCAN_OK : ARCAN_ERRC_UNACCEPTED_STATE;
@@ -5423,6 +6822,7 @@ arcan_errc arcan_video_updateslices(
 			vstores[i] = NULL;
 			continue;
 		}
+		arcan_vint_atlas_release(slot, true);
 		vstores[i] = slot->vstore;
 	}
 
@@ -5432,16 +6832,196 @@ arcan_errc arcan_video_updateslices(
 
 static inline bool obj_visible(arcan_vobject* vobj)
 {
-	bool visible = vobj->current.opa > EPSILON;
+	bool visible = vobj->hot->current.opa > EPSILON;
 
 	while (visible && vobj->parent && (vobj->mask & MASK_OPACITY) > 0){
-		visible = vobj->current.opa > EPSILON;
+		visible = vobj->hot->current.opa > EPSILON;
 		vobj = vobj->parent;
 	}
 
 	return visible;
 }
 
+/*
+ * Pick index, a uniform grid over the screen-space bounds of the objects in
+ * a pipeline that is rebuilt on the first pick after anything that could
+ * move, resize or reorder objects (pick_epoch). Objects that move on their
+ * own, running transforms here or in the parent chain, and 3d objects don't
+ * have stable bounds and are kept in a list that is always tested. The grid
+ * only narrows the candidates down, visibility and hittest still apply.
+ */
+#ifndef PICKGRID_MAX
+#define PICKGRID_MAX 64
+#endif
+
+static void* pick_grow(void* buf, size_t* limit, size_t need)
+{
+	if (need <= *limit)
+		return buf;
+
+	arcan_mem_free(buf);
+	*limit = need + (need >> 1);
+	return arcan_alloc_mem(sizeof(uint32_t) * *limit,
+		ARCAN_MEM_VSTRUCT, 0, ARCAN_MEMALIGN_NATURAL);
+}
+
+static bool pick_bounds(arcan_vobject* vobj, float b[4])
+{
+	vector projv[4];
+	if (vobj->feed.state.tag == ARCAN_TAG_3DOBJ ||
+		ARCAN_OK != arcan_video_screencoords(vobj->cellid, projv))
+		return false;
+
+	b[0] = b[2] = projv[0].x;
+	b[1] = b[3] = projv[0].y;
+	for (size_t i = 1; i < 4; i++){
+		b[0] = projv[i].x < b[0] ? projv[i].x : b[0];
+		b[1] = projv[i].y < b[1] ? projv[i].y : b[1];
+		b[2] = projv[i].x > b[2] ? projv[i].x : b[2];
+		b[3] = projv[i].y > b[3] ? projv[i].y : b[3];
+	}
+
+/* hittest works on truncated coordinates for rotated objects */
+	b[0] -= 1.0; b[1] -= 1.0;
+	b[2] += 1.0; b[3] += 1.0;
+
+	return true;
+}
+
+static inline size_t pick_cell(float v, float base, float step, size_t lim)
+{
+	float ind = floorf((v - base) / step);
+	return ind < 0 ? 0 : (ind >= lim ? lim - 1 : (size_t) ind);
+}
+
+static void pick_build(struct rendertarget* tgt)
+{
+	size_t n = tgt->n_items, n_static = 0;
+	float (*bb)[4] = NULL;
+	bool* dyn = NULL;
+	bool moving = current_context->world.transform != NULL;
+
+	tgt->pick.n_dynamic = 0;
+	tgt->pick.x1 = tgt->pick.y1 = tgt->pick.x2 = tgt->pick.y2 = 0;
+
+	if (n){
+		bb = arcan_alloc_mem(sizeof(float) * 4 * n,
+			ARCAN_MEM_VSTRUCT, ARCAN_MEM_TEMPORARY, ARCAN_MEMALIGN_NATURAL);
+		dyn = arcan_alloc_mem(sizeof(bool) * n,
+			ARCAN_MEM_VSTRUCT, ARCAN_MEM_TEMPORARY, ARCAN_MEMALIGN_NATURAL);
+		tgt->pick.dynamic = pick_grow(tgt->pick.dynamic,
+			&tgt->pick.dynamic_limit, n);
+	}
+
+/* bounds and split between the grid and the always-tested set */
+	for (size_t i = 0; i < n; i++){
+		arcan_vobject* elem = tgt->items[i].elem;
+		dyn[i] = false;
+
+		if (!elem->cellid)
+			continue;
+
+		if (moving || elem->transform ||
+			inherits_transform(elem) || !pick_bounds(elem, bb[i])){
+			dyn[i] = true;
+			tgt->pick.dynamic[tgt->pick.n_dynamic++] = i;
+			continue;
+		}
+
+		if (!n_static++){
+			tgt->pick.x1 = bb[i][0]; tgt->pick.y1 = bb[i][1];
+			tgt->pick.x2 = bb[i][2]; tgt->pick.y2 = bb[i][3];
+		}
+		else {
+			tgt->pick.x1 = bb[i][0] < tgt->pick.x1 ? bb[i][0] : tgt->pick.x1;
+			tgt->pick.y1 = bb[i][1] < tgt->pick.y1 ? bb[i][1] : tgt->pick.y1;
+			tgt->pick.x2 = bb[i][2] > tgt->pick.x2 ? bb[i][2] : tgt->pick.x2;
+			tgt->pick.y2 = bb[i][3] > tgt->pick.y2 ? bb[i][3] : tgt->pick.y2;
+		}
+	}
+
+	size_t side = ceilf(sqrtf(n_static));
+	side = side < 1 ? 1 : (side > PICKGRID_MAX ? PICKGRID_MAX : side);
+	size_t n_cells = side * side;
+
+	tgt->pick.cols = tgt->pick.rows = side;
+	tgt->pick.cw = (tgt->pick.x2 - tgt->pick.x1) / (float) side;
+	tgt->pick.ch = (tgt->pick.y2 - tgt->pick.y1) / (float) side;
+	tgt->pick.cw = tgt->pick.cw < 1.0 ? 1.0 : tgt->pick.cw;
+	tgt->pick.ch = tgt->pick.ch < 1.0 ? 1.0 : tgt->pick.ch;
+
+	tgt->pick.cells = pick_grow(tgt->pick.cells,
+		&tgt->pick.cells_limit, n_cells + 1);
+	memset(tgt->pick.cells, '\0', sizeof(uint32_t) * (n_cells + 1));
+
+/* two passes, count references per cell then fill, with cells[c] as the
+ * write cursor that ends up at the start of c + 1 */
+	for (int pass = 0; pass < 2; pass++){
+		for (size_t i = 0; i < n; i++){
+			if (!tgt->items[i].elem->cellid || dyn[i])
+				continue;
+
+			size_t c1 = pick_cell(bb[i][0], tgt->pick.x1, tgt->pick.cw, side);
+			size_t c2 = pick_cell(bb[i][2], tgt->pick.x1, tgt->pick.cw, side);
+			size_t r1 = pick_cell(bb[i][1], tgt->pick.y1, tgt->pick.ch, side);
+			size_t r2 = pick_cell(bb[i][3], tgt->pick.y1, tgt->pick.ch, side);
+
+			for (size_t r = r1; r <= r2; r++)
+				for (size_t c = c1; c <= c2; c++){
+					if (pass == 0)
+						tgt->pick.cells[r * side + c + 1]++;
+					else
+						tgt->pick.refs[tgt->pick.cells[r * side + c]++] = i;
+				}
+		}
+
+		if (pass == 0){
+			for (size_t c = 0; c < n_cells; c++)
+				tgt->pick.cells[c + 1] += tgt->pick.cells[c];
+
+			tgt->pick.refs = pick_grow(tgt->pick.refs,
+				&tgt->pick.refs_limit, tgt->pick.cells[n_cells] + 1);
+		}
+	}
+
+	for (size_t c = n_cells; c > 0; c--)
+		tgt->pick.cells[c] = tgt->pick.cells[c - 1];
+	tgt->pick.cells[0] = 0;
+
+	arcan_mem_free(bb);
+	arcan_mem_free(dyn);
+	tgt->pick.epoch = arcan_video_display.pick_epoch;
+}
+
+/* candidates for [x, y] as two ascending index ranges (grid cell, dynamic),
+ * the caller merges them to keep pipeline order */
+static void pick_candidates(struct rendertarget* tgt, int x, int y,
+	uint32_t** cell, size_t* n_cell)
+{
+	if (!tgt->pick.cells || tgt->pick.epoch != arcan_video_display.pick_epoch)
+		pick_build(tgt);
+
+	*cell = NULL;
+	*n_cell = 0;
+
+	if (x < tgt->pick.x1 || y < tgt->pick.y1 ||
+		x > tgt->pick.x2 || y > tgt->pick.y2)
+		return;
+
+	size_t c = pick_cell(x, tgt->pick.x1, tgt->pick.cw, tgt->pick.cols);
+	size_t r = pick_cell(y, tgt->pick.y1, tgt->pick.ch, tgt->pick.rows);
+	size_t ind = r * tgt->pick.cols + c;
+
+	*cell = &tgt->pick.refs[tgt->pick.cells[ind]];
+	*n_cell = tgt->pick.cells[ind + 1] - tgt->pick.cells[ind];
+}
+
+static inline bool pick_test(arcan_vobject* vobj, int x, int y)
+{
+	return vobj->cellid && !(vobj->mask & MASK_UNPICKABLE) &&
+		obj_visible(vobj) && arcan_video_hittest(vobj->cellid, x, y);
+}
+
 size_t arcan_video_rpick(arcan_vobj_id rt,
 	arcan_vobj_id* dst, size_t lim, int x, int y)
 {
@@ -5449,23 +7029,25 @@ size_t arcan_video_rpick(arcan_vobj_id rt,
 	arcan_vobject* vobj = arcan_video_getobject(rt);
 	struct rendertarget* tgt = arcan_vint_findrt(vobj);
 
-	if (lim == 0 || !tgt || !tgt->first)
+	if (lim == 0 || !tgt)
 		return count;
 
-	arcan_vobject_litem* current = tgt->first;
-
-/* skip to last, then start stepping backwards */
-	while (current->next)
-		current = current->next;
-
-	while (current && count < lim){
-		arcan_vobject* vobj = current->elem;
+	uint32_t* cell;
+	size_t n_cell, n_dyn;
+	pick_candidates(tgt, x, y, &cell, &n_cell);
+	n_dyn = tgt->pick.n_dynamic;
 
-		if ((vobj->mask & MASK_UNPICKABLE) == 0 && obj_visible(vobj) &&
-			arcan_video_hittest(vobj->cellid, x, y))
-				dst[count++] = vobj->cellid;
+/* step backwards from the last */
+	while ((n_cell || n_dyn) && count < lim){
+		uint32_t ind;
+		if (!n_dyn || (n_cell && cell[n_cell-1] > tgt->pick.dynamic[n_dyn-1]))
+			ind = cell[--n_cell];
+		else
+			ind = tgt->pick.dynamic[--n_dyn];
 
-		current = current->previous;
+		arcan_vobject* vobj = tgt->items[ind].elem;
+		if (pick_test(vobj, x, y))
+			dst[count++] = vobj->cellid;
 	}
 
 	return count;
@@ -5477,19 +7059,24 @@ size_t arcan_video_pick(arcan_vobj_id rt,
 	size_t count = 0;
 	arcan_vobject* vobj = arcan_video_getobject(rt);
 	struct rendertarget* tgt = arcan_vint_findrt(vobj);
-	if (lim == 0 || !tgt || !tgt->first)
+	if (lim == 0 || !tgt)
 		return count;
 
-	arcan_vobject_litem* current = tgt->first;
+	uint32_t* cell;
+	size_t n_cell, i = 0, j = 0;
+	pick_candidates(tgt, x, y, &cell, &n_cell);
 
-	while (current && count < lim){
-		arcan_vobject* vobj = current->elem;
-
-		if (vobj->cellid && !(vobj->mask & MASK_UNPICKABLE) &&
-			obj_visible(vobj) && arcan_video_hittest(vobj->cellid, x, y))
-				dst[count++] = vobj->cellid;
+	while ((i < n_cell || j < tgt->pick.n_dynamic) && count < lim){
+		uint32_t ind;
+		if (j == tgt->pick.n_dynamic ||
+			(i < n_cell && cell[i] < tgt->pick.dynamic[j]))
+			ind = cell[i++];
+		else
+			ind = tgt->pick.dynamic[j++];
 
-		current = current->next;
+		arcan_vobject* vobj = tgt->items[ind].elem;
+		if (pick_test(vobj, x, y))
+			dst[count++] = vobj->cellid;
 	}
 
 	return count;
@@ -5544,7 +7131,7 @@ surface_properties arcan_video_current_properties(arcan_vobj_id id)
 	arcan_vobject* vobj = arcan_video_getobject(id);
 
 	if (vobj){
-		rv = vobj->current;
+		rv = vobj->hot->current;
 		rv.scale.x *= vobj->origw;
 		rv.scale.y *= vobj->origh;
 	}
@@ -5563,7 +7150,7 @@ surface_properties arcan_video_properties_at(arcan_vobj_id id, unsigned ticks)
 	arcan_vobject* vobj = arcan_video_getobject(id);
 
 	if (vobj){
-		rv = vobj->current;
+		rv = vobj->hot->current;
 /* if there's no transform defined, then the ticks will be the same */
 		if (vobj->transform){
 /* translate ticks from relative to absolute */
@@ -5689,16 +7276,13 @@ arcan_errc arcan_video_maxorder(arcan_vobj_id rt, uint16_t* ov)
 	if (!tgt)
 		return ARCAN_ERRC_UNACCEPTED_STATE;
 
-	arcan_vobject_litem* current = current_context->stdoutp.first;
+	struct rendertarget* base = &current_context->stdoutp;
 	uint16_t order = 0;
 
-	while (current){
-		if (current->elem && current->elem->order > order &&
-			current->elem->order < 65531)
-			order = current->elem->order;
-
-		current = current->next;
-	}
+/* sorted, so the last one below the reserved range */
+	size_t ind = items_lower(base, 65531, SIZE_MAX);
+	if (ind && base->items[ind-1].elem->order > 0)
+		order = base->items[ind-1].elem->order;
 
 	*ov = order;
 	return ARCAN_OK;
@@ -5793,6 +7377,7 @@ void arcan_video_shutdown(bool release_fsrv)
 	agp_shader_flush();
 	deallocate_gl_context(current_context, true, NULL);
 	arcan_video_reset_fontcache();
+	arcan_img_cache_flush();
 	agp_rendertarget_clear();
 	TTF_Quit();
 	platform_video_shutdown();
@@ -5891,8 +7476,8 @@ lineheights, &w, &h, &dsz, &maxw, &maxh, false
 		ds->w = w;
 		ds->h = h;
 
-/* transfer sync is done separately here */
-		agp_update_vstore(ds, true);
+/* transfer sync is deferred until the source description is set so that
+ * the store can be packed into an atlas page and still be rerastered */
 		arcan_vint_attachobject(rv);
 	}
 	else {
@@ -5903,6 +7488,7 @@ lineheights, &w, &h, &dsz, &maxw, &maxh, false
 		if (vobj->feed.state.tag != ARCAN_TAG_TEXT)
 			FAIL(ARCAN_ERRC_UNACCEPTED_STATE);
 
+		arcan_vint_atlas_release(vobj, true);
 		ds = vobj->vstore;
 
 		if (data.multiple)
@@ -5919,6 +7505,9 @@ lineheights, &w, &h, &dsz, &maxw, &maxh, false
 
 	update_sourcedescr(ds, &data);
 
+	if (src == ARCAN_EID && !arcan_vint_atlas_insert(vobj, vcontext_ind))
+		agp_update_vstore(ds, true);
+
 /*
  * POT but not all used,
 	vobj->txcos = arcan_alloc_mem(8 * sizeof(float),
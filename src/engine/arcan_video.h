@@ -286,6 +286,12 @@ void arcan_video_default_texmode(enum arcan_vtex_mode s,
 	enum arcan_vtex_mode t);
 void arcan_video_default_texfilter(enum arcan_vfilter_mode);
 void arcan_video_default_imageprocmode(enum arcan_imageproc_mode);
+
+/*
+ * Let small, static textured objects (images, raw surfaces, text) created
+ * from now on be packed into shared atlas pages, see arcan_atlas.c
+ */
+void arcan_video_default_atlas(bool);
 arcan_errc arcan_video_screenshot(av_pixel** dptr, size_t* dsize);
 
 /*
@@ -517,10 +523,11 @@ arcan_errc arcan_video_resizefeed(arcan_vobj_id id, size_t w, size_t h);
  * defined in the resource will be retained, otherwise the image will be
  * rescaled upon loading (unfiltered and rather slow).
  *
- * The asynchronous version will spawn a worker thread (up to a certain
- * number, compile-time limited with ASYNCH_CONCURRENT_THREADS).
- * Context operations will force a join on any outstanding asynchronous
- * loading jobs.
+ * The asynchronous version queues the job for a fixed pool of worker
+ * threads (one per core, compile-time limited by ASYNCH_CONCURRENT_THREADS)
+ * where jobs for visible objects are picked first. Deleting the object
+ * cancels a job that has not started yet. Context operations will force
+ * a join on any outstanding asynchronous loading jobs.
  *
  * Loadimage returns ARCAN_EID on failure, asynch will always succeed but
  * may later enqueue EVENT_ASYNCHIMAGE_FAILED or EVENT_VIDEO_ASYNCHIMAGE_LOADED
@@ -717,6 +724,14 @@ arcan_errc arcan_video_detachfromrendertarget(arcan_vobj_id did,
 arcan_errc arcan_video_alterreadback(arcan_vobj_id did, int readback);
 arcan_errc arcan_video_rendertarget_setnoclear(arcan_vobj_id did, bool value);
 
+/*
+ * Objects with the same order value are normally drawn in the order they were
+ * attached. With [value] set, later attachments to the rendertarget of [did]
+ * are instead grouped with same-order objects that share vstore and shader,
+ * trading the tie-break order for fewer state changes and longer batches.
+ */
+arcan_errc arcan_video_rendertarget_setstatesort(arcan_vobj_id did, bool value);
+
 /*
  * Define the range of valid, resolved, order values that will actually be
  * drawn for the rendertarget. A negative number or where max < min will
@@ -18,11 +18,17 @@
 
 /*
  *  Indicate that the video pipeline is in such a state that
- *  it should be redrawn. X should be NULL or a vobj reference
- *  (to permit partial redraws in the future if we need to save
- *  bandwidth).
+ *  it should be redrawn. X should be NULL (all rendertargets) or a
+ *  vobj reference, then only the rendertargets that the object is
+ *  attached to, and the ones that depend on those, will be redrawn.
  */
-#define FLAG_DIRTY(X) (arcan_video_display.dirty++);
+#define FLAG_DIRTY(X) arcan_vint_flagdirty(X)
+
+/* upper limit for tracked vstores that are shared with a rendertarget
+ * pipeline, past this dirty- flagging of shared stores is global */
+#ifndef RTGRAPH_SHARED_LIMIT
+#define RTGRAPH_SHARED_LIMIT 256
+#endif
 
 #define FL_SET(obj_ptr, fl) ((obj_ptr)->flags |= fl)
 #define FL_CLEAR(obj_ptr, fl) ((obj_ptr)->flags &= ~fl)
@@ -34,7 +40,8 @@ struct arcan_vobject;
 enum rtgt_flags {
 	TGTFL_READING = 1,
 	TGTFL_ALIVE   = 2,
-	TGTFL_NOCLEAR = 4
+	TGTFL_NOCLEAR = 4,
+	TGTFL_STATESORT = 8
 };
 
 struct rendertarget {
@@ -49,12 +56,13 @@ struct rendertarget {
 	int id;
 
 /* color representes the attached vid,
- * first is the pipeline (subset of context vid pool) */
+ * items is the pipeline (subset of context vid pool) sorted on order */
 	struct arcan_vobject* color;
-	struct arcan_vobject_litem* first;
+	struct arcan_vobject_litem* items;
+	size_t n_items, items_limit;
 
 /* it is possible for one rendertarget to share the pipeline with
- * another, if so, first is set to NULL and link points to the rtgt vid */
+ * another, if so, items is empty and link points to the rtgt vid */
 	struct rendertarget* link;
 
 /* corresponding agp backend store for the rendertarget in question */
@@ -81,16 +89,29 @@ struct rendertarget {
 	size_t transfc;
 
 /*
- * dirty- management is still incomplete in two ways, one is that dirty-
- * flagging is a global video state and not bound to rendertarget which is in
- * conflict with rendertargets being updated at different clocks.
- * second is that we do not consider the dirty- area, and just go for a full
- * redraw when it is time. Important optimizations but still low on the list.
- * When it is to be implemented, use this variable, an list of invalidation
- * rects and sweep the codebase for FLAG_DIRTY
+ * dirty- management is per rendertarget, FLAG_DIRTY on an object goes to
+ * the rendertarget it is attached to and is forwarded to [consumers] when
+ * the rendertarget is drawn. We still do not consider the dirty- area, and
+ * just go for a full redraw when it is time. When it is to be implemented,
+ * use this variable, an list of invalidation rects and sweep the codebase
+ * for FLAG_DIRTY
  */
 	size_t dirtyc;
 
+/*
+ * edges in the rendertarget dependency graph, indices into the context
+ * rtargets (RENDERTARGET_LIMIT for stdoutp) of the rendertargets that sample
+ * the output of, or are linked to, this one. See arcan_vint_refresh.
+ */
+	uint16_t consumers[RENDERTARGET_LIMIT + 1];
+	size_t n_consumers;
+
+/*
+ * set when the dirty state can't be attributed to objects in the pipeline,
+ * otherwise only the changed objects are considered for a partial redraw
+ */
+	bool full_redraw;
+
 /*
  * track density per rendertarget, this affects some video objects that gets
  * attached in that they are rerasterized to match the properties of the new
@@ -102,6 +123,23 @@ struct rendertarget {
  * the 3d pipe. This is defaulted to BADID until a vobj is explicitly camtaged */
 	arcan_vobj_id camtag;
 
+/*
+ * spatial index for pick/rpick, uniform grid over the screen-space bounds of
+ * the pipeline where [cells] are offsets into [refs] (item indices, sorted)
+ * for cols * rows + 1 cells. Valid as long as epoch matches the display
+ * pick_epoch, see pick_build.
+ */
+	struct {
+		size_t epoch;
+		float x1, y1, x2, y2, cw, ch;
+		size_t cols, rows;
+		uint32_t* cells;
+		uint32_t* refs;
+		uint32_t* dynamic;
+		size_t n_dynamic;
+		size_t cells_limit, refs_limit, dynamic_limit;
+	} pick;
+
 /*
  * to be able to temporarily cut off certain order values from being drawn,
  * we need to track the lower accepted bounds and the max accepted bounds.
@@ -118,6 +156,7 @@ enum vobj_flags {
 	FL_PRSIST = 32,
 	FL_FULL3D = 64, /* switch to a quaternion- based orientation scheme */
 	FL_RTGT   = 128,
+	FL_ACTIVE = 512, /* listed in the context active set */
 #ifdef _DEBUG
 	FL_FROZEN = 256
 #else
@@ -203,6 +242,33 @@ struct vobject_frameset {
  *
  *  - null- terminate children
  */
+/*
+ * The state that is read and written every tick and every frame is kept out
+ * of arcan_vobject in a pool that runs parallel to vitems_pool (same index as
+ * the cellid) so that update and resolve passes touch packed memory instead
+ * of dragging the management fields of each object through the cache.
+ */
+struct vobject_hot {
+	surface_properties current;
+
+/* transform caching,
+ * the invalidated flag will be active as long as there are running
+ * transformations for the object in question, or if there's running
+ * transformations somewhere in the parent chain */
+	bool valid_cache;
+	unsigned long last_updated;
+	surface_properties prop_cache;
+	float _Alignas(16) prop_matr[16];
+
+/* when !valid_cache, prop_cache still holds the last resolved state: current
+ * for [stamp, lerp] of the resolve clock, and reusable on later frames while
+ * the parent stays at [parent_gen]. [gen] changes when the resolved state
+ * does, stamp 0 means the object itself changed. See arcan_resolve_vidprop */
+	uint64_t gen, parent_gen, stamp;
+	float lerp;
+	bool moving;
+};
+
 typedef struct arcan_vobject {
 	struct arcan_vobject* parent;
 	struct arcan_vobject** children;
@@ -227,25 +293,18 @@ typedef struct arcan_vobject {
 	float* txcos;
 	enum arcan_blendfunc blendmode;
 
-/* position */
+/* position, the per-frame state lives in the context hot pool */
 	signed int order;
-	surface_properties current;
+	struct vobject_hot* hot;
 	point origo_ofs;
 
 	surface_transform* transform;
 	enum arcan_transform_mask mask;
 	enum arcan_clipmode clip;
 
-/* transform caching,
- * the invalidated flag will be active as long as there are running
- * transformations for the object in question, or if there's running
- * transformations somewhere in the parent chain */
-	bool valid_cache, rotate_state;
-	surface_properties prop_cache;
-	float _Alignas(16) prop_matr[16];
+	bool rotate_state;
 
 /* life-cycle tracking */
-	unsigned long last_updated;
 	long lifetime;
 
 /* management mappings */
@@ -256,6 +315,16 @@ typedef struct arcan_vobject {
 	struct rendertarget* owner;
 	arcan_vobj_id cellid;
 
+/* bounds in owner rendertarget pixels when last drawn and if the object has
+ * been flagged as dirty since, used for partial redraws */
+	struct {
+		bool changed, valid;
+		size_t x1, y1, x2, y2;
+	} damage;
+
+/* set if the vstore is a shared atlas page, see arcan_atlas.c */
+	struct arcan_atlas_slot* atlas;
+
 #ifdef _DEBUG
 	bool frozen;
 #endif
@@ -270,21 +339,28 @@ typedef struct arcan_vobject {
 	char* tracetag;
 } arcan_vobject;
 
-/* regular old- linked list, but also mapped to an array */
+/* pipeline entry, rendertargets keep these in an array sorted on order
+ * (stable for equal order) that is terminated by an entry where elem is
+ * NULL so it can be walked without knowing the count */
 struct arcan_vobject_litem {
 	arcan_vobject* elem;
-	struct arcan_vobject_litem* next;
-	struct arcan_vobject_litem* previous;
 };
 typedef struct arcan_vobject_litem arcan_vobject_litem;
 
 struct arcan_video_display {
-	bool suspended, fullscreen, conservative, in_video, no_stdout;
+	bool suspended, fullscreen, conservative, in_video, no_stdout, atlas;
 
 	int dirty;
 	size_t ignore_dirty;
 	enum arcan_order3d order3d;
 
+/* bumped on changes that can invalidate the rendertarget pick indices */
+	size_t pick_epoch;
+
+/* resolve clock, advanced when time does (tick, new interpolation fragment)
+ * and the source of unique resolve generations */
+	uint64_t resolve_clock, resolve_gen;
+
 /*
  * track mouse-cursor as a separate entity that re-uses an image vstore, in
  * order to have a default FBO that is rendered to and not cause excessive
@@ -340,11 +416,35 @@ struct arcan_video_context {
 	arcan_vobject world;
 	arcan_vobject* vitems_pool;
 
+/* hot state for the world and for each entry in vitems_pool */
+	struct vobject_hot world_hot;
+	struct vobject_hot* hot_pool;
+
+/* cellids of objects that need to be visited every logical tick, (running
+ * transforms, lifetime, frameset cycling, feed functions, asynch loads)
+ * where 0 marks an entry that was dropped since the last tick */
+	arcan_vobj_id* active;
+	size_t n_active, active_limit;
+
 	struct rendertarget rtargets[RENDERTARGET_LIMIT];
 	struct rendertarget* attachment;
 	ssize_t n_rtargets;
 
 	struct rendertarget stdoutp;
+
+/* rendertarget dependency graph, rebuilt on refresh when !valid. [order] is
+ * rtargets indices with producers ahead of their consumers and [shared] maps
+ * vstores with more than one user to the rendertargets that sample them */
+	struct {
+		bool valid;
+		size_t order[RENDERTARGET_LIMIT];
+		struct {
+			struct agp_vstore* store;
+			uint16_t rt;
+		} shared[RTGRAPH_SHARED_LIMIT];
+		size_t n_shared;
+		bool overflow;
+	} rtgraph;
 };
 
 extern struct arcan_video_context vcontext_stack[];
@@ -362,6 +462,19 @@ extern struct arcan_video_display arcan_video_display;
  */
 unsigned arcan_vint_refresh(float fragment, size_t* ndirty);
 
+/*
+ * Mark [vobj] as changed, see FLAG_DIRTY. NULL means that the change can't
+ * be attributed and all rendertargets should be redrawn.
+ */
+void arcan_vint_flagdirty(arcan_vobject* vobj);
+
+/*
+ * Geometry of some object has changed in a way that doesn't go through the
+ * normal transform or attachment functions (e.g. direct changes to origw /
+ * origh), the pick indices need to be rebuilt.
+ */
+void arcan_vint_pickdirty();
+
 /*
  * populate props with the (possibly cached) transformation state
  * of existing video object (vobj) at interpolation stage (0..1)
@@ -423,8 +536,52 @@ void arcan_vint_mirrormapping(float* dst, float st, float tt);
  */
 void arcan_vint_joinasynch(arcan_vobject* img, bool emit, bool force);
 
+/*
+ * collect asynchronous image loads that the worker pool has finished and
+ * emit their loaded/failed events, called once per conductor pass
+ */
+void arcan_vint_pollasynch();
+
+/*
+ * number of image loader workers currently decoding, used to size other
+ * parallel work so that it doesn't oversubscribe the cores
+ */
+size_t arcan_vint_loaderbusy();
+
 void arcan_vint_reraster(arcan_vobject* img, struct rendertarget*);
 
+/*
+ * Pack the store of [vobj] into a shared atlas page for context level
+ * [context] if it is small, static and textured, replacing its vstore and
+ * texture coordinates. Returns false and leaves [vobj] untouched otherwise.
+ */
+bool arcan_vint_atlas_insert(arcan_vobject* vobj, unsigned context);
+
+/*
+ * Drop the reference [vobj] has to its atlas region (if any). With [restore]
+ * set, the contents are moved back into a store of its own first, this is
+ * needed before anything that modifies, reads back or remaps the store.
+ */
+void arcan_vint_atlas_release(arcan_vobject* vobj, bool restore);
+
+/*
+ * Let [dst] reference the same atlas region as [src] (shared storage),
+ * [dst] should have its previous region released first.
+ */
+void arcan_vint_atlas_share(arcan_vobject* src, arcan_vobject* dst);
+
+/*
+ * The store [vobj] had before it was packed, for its metadata only.
+ */
+struct agp_vstore* arcan_vint_atlas_source(arcan_vobject* vobj);
+
+/*
+ * Synch modified pages, [restore] marks the pages of context level [context]
+ * as modified after their textures have been dropped by a context push.
+ */
+void arcan_vint_atlas_flush();
+void arcan_vint_atlas_restore(unsigned context);
+
 /*
  * Figure out what the vid will be for the next object allocated in this
  * context. This function is primarily used to avoid an initialization
@@ -440,6 +597,12 @@ arcan_vobj_id arcan_vint_nextfree();
 struct rendertarget* arcan_vint_findrt(arcan_vobject* vobj);
 struct rendertarget* arcan_vint_findrt_vstore(struct agp_vstore* st);
 
+/*
+ * resolve the vid of the rendertarget (ARCAN_VIDEO_WORLDID for the default
+ * output) that [vobj] is primarily attached to, ARCAN_EID if unattached.
+ */
+arcan_vobj_id arcan_vint_rtid(arcan_vobject* vobj);
+
 /*
  * used by the video platform layer, assume that agp_vstore points
  * to the backing end of a rendertarget, and draw it to the bound output-rt
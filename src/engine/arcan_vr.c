@@ -166,10 +166,10 @@ static void apply_limb(struct vr_limb* limb, struct limb_ent* lent)
 	FLAG_DIRTY(vobj);
 
 	if (lent->orientation){
-		vobj->current.rotation.roll = tb.x;
-		vobj->current.rotation.pitch = tb.y;
-		vobj->current.rotation.yaw = tb.z;
-		vobj->current.rotation.quaternion = limb->data.orientation;
+		vobj->hot->current.rotation.roll = tb.x;
+		vobj->hot->current.rotation.pitch = tb.y;
+		vobj->hot->current.rotation.yaw = tb.z;
+		vobj->hot->current.rotation.quaternion = limb->data.orientation;
 	}
 /* since 3dbase disables resolving entirely if there's a limb-map,
  * when we have the opportunity to test tools, we likely need to
@@ -177,10 +177,10 @@ static void apply_limb(struct vr_limb* limb, struct limb_ent* lent)
 	if (lent->position){
 		surface_properties dprop;
 		arcan_resolve_vidprop(vobj, 0.0, &dprop);
-		vobj->current.position = limb->data.position;
-		vobj->current.position.x += dprop.position.x;
-		vobj->current.position.y += dprop.position.y;
-		vobj->current.position.z += dprop.position.z;
+		vobj->hot->current.position = limb->data.position;
+		vobj->hot->current.position.x += dprop.position.x;
+		vobj->hot->current.position.y += dprop.position.y;
+		vobj->hot->current.position.z += dprop.position.z;
 	}
 }
 
@@ -218,6 +218,7 @@ void agp_readback_synchronous(struct agp_vstore* dst)
 		GL_PIXEL_FORMAT, GL_UNSIGNED_BYTE, dst->vinf.text.raw);
 	dst->update_ts = arcan_timemillis();
 	env->bind_texture(GL_TEXTURE_2D, 0);
+	env->last_texid = -1;
 }
 
 static void pbo_stream(struct agp_vstore* s,
@@ -419,6 +420,25 @@ struct stream_meta agp_stream_prepare(struct agp_vstore* s,
 		agp_deactivate_vstore();
 	break;
 
+/* map the unpack buffer and hand it back, the caller populates it (possibly
+ * from another thread) and the upload is triggered in commit */
+	case STREAM_RAW_DIRECT_MAPPED:
+		verbose_print("(%"PRIxPTR") prepare upload (raw/mapped)", (uintptr_t) s);
+		if (!s->vinf.text.wid)
+			setup_unpack_pbo(s, NULL);
+
+		env->bind_buffer(GL_PIXEL_UNPACK_BUFFER, s->vinf.text.wid);
+
+/* orphan the previous contents so that the map doesn't stall on a transfer
+ * that is still pending from the last frame */
+		env->buffer_data(GL_PIXEL_UNPACK_BUFFER,
+			s->w * s->h * sizeof(av_pixel), NULL, GL_STREAM_DRAW);
+		res.buf = env->map_buffer(GL_PIXEL_UNPACK_BUFFER, GL_WRITE_ONLY);
+		res.state = res.buf != NULL;
+		res.dirty = false;
+		env->bind_buffer(GL_PIXEL_UNPACK_BUFFER, 0);
+	break;
+
 	case STREAM_HANDLE:
 /* if platform_video_map_handle fails here, prepare an empty vstore and attempt
  * again, if that succeeds it means that we had to go through a RTT
@@ -446,6 +466,28 @@ void agp_stream_release(struct agp_vstore* s, struct stream_meta meta)
 
 void agp_stream_commit(struct agp_vstore* s, struct stream_meta meta)
 {
+	if (meta.type != STREAM_RAW_DIRECT_MAPPED)
+		return;
+
+	struct agp_fenv* env = agp_env();
+	env->bind_buffer(GL_PIXEL_UNPACK_BUFFER, s->vinf.text.wid);
+
+/* the contents are undefined if the unmap fails, keep the last frame */
+	if (!env->unmap_buffer(GL_PIXEL_UNPACK_BUFFER) || !meta.state){
+		env->bind_buffer(GL_PIXEL_UNPACK_BUFFER, 0);
+		return;
+	}
+
+	verbose_print(
+		"(%"PRIxPTR") mapped stream update %zu*%zu", (uintptr_t) s, s->w, s->h);
+
+	agp_activate_vstore(s);
+	env->tex_subimage_2d(GL_TEXTURE_2D, 0, 0, 0, s->w, s->h,
+		s->vinf.text.s_fmt ? s->vinf.text.s_fmt : GL_PIXEL_FORMAT,
+		GL_UNSIGNED_BYTE, 0
+	);
+	env->bind_buffer(GL_PIXEL_UNPACK_BUFFER, 0);
+	agp_deactivate_vstore();
 }
 
 static void default_release(void* tag)
@@ -489,6 +531,7 @@ void agp_request_readback(struct agp_vstore* store)
 	env->get_tex_image(GL_TEXTURE_2D, 0, GL_PIXEL_FORMAT, GL_UNSIGNED_BYTE, NULL);
 	env->bind_buffer(GL_PIXEL_PACK_BUFFER, 0);
 	env->bind_texture(GL_TEXTURE_2D, 0);
+	env->last_texid = -1;
 }
 
 struct asynch_readback_meta agp_poll_readback(struct agp_vstore* store)
@@ -327,6 +327,12 @@ struct stream_meta agp_stream_prepare(struct agp_vstore* s,
 		agp_deactivate_vstore();
 	break;
 
+/* no PBOs here, let the caller fall back to RAW_DIRECT */
+	case STREAM_RAW_DIRECT_MAPPED:
+		mout.buf = NULL;
+		mout.state = false;
+	break;
+
 /* see notes in gl21.c */
 	case STREAM_HANDLE:
 		mout.state = platform_video_map_handle(s, meta.handle);
@@ -150,6 +150,11 @@ struct agp_fenv {
 	int model_flags;
 	GLenum blend_src_alpha, blend_dst_alpha;
 	GLint last_store_mode;
+
+/* shadowed state used to skip redundant changes, -1 means unknown and
+ * [last_texid] is what is bound to [last_store_mode] on texture unit 0 */
+	int last_blend;
+	GLint last_texid;
 };
 
 void agp_glinit_fenv(struct agp_fenv* dst,
@@ -296,6 +296,8 @@ void agp_glinit_fenv(struct agp_fenv* dst,
 			lookup(tag, "glFinish");
 
 	dst->last_store_mode = GL_TEXTURE_2D;
+	dst->last_blend = -1;
+	dst->last_texid = -1;
 #undef lookup_opt
 #undef lookup
 
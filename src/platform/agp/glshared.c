@@ -28,7 +28,7 @@
 
 #ifdef HEADLESS_NOARCAN
 #undef FLAG_DIRTY
-#define FLAG_DIRTY()
+#define FLAG_DIRTY(X)
 #endif
 
 #ifndef GL_VERTEX_PROGRAM_POINT_SIZE
@@ -93,6 +93,9 @@ static struct agp_rendertarget* active_rendertarget;
  */
 #define MAX_BUFFERS 3
 
+/* past this, dirty regions are merged into one bounding region */
+#define MAX_DIRTY 8
+
 struct agp_rendertarget
 {
 	GLuint fbo;
@@ -109,6 +112,12 @@ struct agp_rendertarget
 	bool (*proxy_state)(struct agp_rendertarget* tgt, uintptr_t tag);
 	uintptr_t proxy_tag;
 
+/* partial updates, [retained] is set when a full update has been drawn and
+ * the contents can be trusted to stay, [direct] when proxied to the display */
+	bool retained, direct, clipped;
+	struct agp_region clip;
+	struct agp_region dirty[MAX_DIRTY];
+
 /* used for multi-buffering mode */
 	bool rz_ack;
 	size_t n_stores;
@@ -180,20 +189,94 @@ void agp_rendertarget_dropswap(struct agp_rendertarget* tgt)
 	tgt->dirty_flip++;
 }
 
+static bool region_contains(struct agp_region* a, struct agp_region* b)
+{
+	return a->x1 <= b->x1 && a->y1 <= b->y1 && a->x2 >= b->x2 && a->y2 >= b->y2;
+}
+
+static void region_merge(struct agp_region* dst, struct agp_region* src)
+{
+	dst->x1 = src->x1 < dst->x1 ? src->x1 : dst->x1;
+	dst->y1 = src->y1 < dst->y1 ? src->y1 : dst->y1;
+	dst->x2 = src->x2 > dst->x2 ? src->x2 : dst->x2;
+	dst->y2 = src->y2 > dst->y2 ? src->y2 : dst->y2;
+}
+
 size_t agp_rendertarget_dirty(
 	struct agp_rendertarget* dst, struct agp_region* dirty)
 {
 	if (!dst)
 		return 0;
 
-	if (dirty){
-/* missing, track / merge dirty rectangles */
-		dst->dirty_region++;
+	if (!dirty)
+		return dst->dirty_region;
+
+	struct agp_region reg = *dirty;
+	if (reg.x2 <= reg.x1 || reg.y2 <= reg.y1){
+		if (dst->clipped)
+			reg = dst->clip;
+		else
+			reg = (struct agp_region){
+				.x2 = dst->store ? dst->store->w : 0,
+				.y2 = dst->store ? dst->store->h : 0
+			};
+	}
+
+/* most draw calls will just repeat the clip region */
+	for (size_t i = 0; i < dst->dirty_region; i++){
+		if (region_contains(&dst->dirty[i], &reg))
+			return dst->dirty_region;
+
+		if (region_contains(&reg, &dst->dirty[i])){
+			dst->dirty[i] = reg;
+			return dst->dirty_region;
+		}
 	}
 
+	if (dst->dirty_region == MAX_DIRTY){
+		for (size_t i = 1; i < MAX_DIRTY; i++)
+			region_merge(&dst->dirty[0], &dst->dirty[i]);
+		region_merge(&dst->dirty[0], &reg);
+		dst->dirty_region = 1;
+	}
+	else
+		dst->dirty[dst->dirty_region++] = reg;
+
 	return dst->dirty_region;
 }
 
+bool agp_rendertarget_clip(struct agp_region* region)
+{
+	struct agp_rendertarget* tgt = active_rendertarget;
+	if (!tgt || !tgt->store)
+		return false;
+
+	size_t w = tgt->store->w;
+	size_t h = tgt->store->h;
+
+	if (!region){
+		if (tgt->clipped)
+			agp_env()->scissor(0, 0, w, h);
+		tgt->clipped = false;
+		tgt->retained = true;
+		return true;
+	}
+
+	if (!tgt->retained || tgt->direct || tgt->n_stores)
+		return false;
+
+	struct agp_region reg = *region;
+	reg.x2 = reg.x2 > w ? w : reg.x2;
+	reg.y2 = reg.y2 > h ? h : reg.y2;
+	reg.x1 = reg.x1 > reg.x2 ? reg.x2 : reg.x1;
+	reg.y1 = reg.y1 > reg.y2 ? reg.y2 : reg.y1;
+
+	agp_env()->scissor(reg.x1, reg.y1, reg.x2 - reg.x1, reg.y2 - reg.y1);
+	tgt->clip = reg;
+	tgt->clipped = true;
+	return true;
+}
+
 uint64_t agp_rendertarget_swap(struct agp_rendertarget* dst, bool* swap)
 {
 	struct agp_fenv* env = agp_env();
@@ -242,7 +325,7 @@ uint64_t agp_rendertarget_swap(struct agp_rendertarget* dst, bool* swap)
 	*swap = true;
 	if (dst->dirty_flip > 0){
 		dst->dirty_flip--;
-		FLAG_DIRTY();
+		FLAG_DIRTY(NULL);
 		verbose_print("(%"PRIxPTR") dirty left: %zu", (uintptr_t) dst, dst->dirty_flip);
 
 /* now that we have 'dirtied out' and any external users should have received
@@ -528,6 +611,7 @@ static bool update_3dtex(
 {
 	struct agp_fenv* env = agp_env();
 	env->bind_texture(GL_TEXTURE_3D, backing->vinf.text.glid);
+	env->last_texid = -1;
 	return true;
 }
 
@@ -551,6 +635,7 @@ static bool update_cube(
  */
 	struct agp_fenv* env = agp_env();
 	env->bind_texture(GL_TEXTURE_CUBE_MAP, backing->vinf.text.glid);
+	env->last_texid = -1;
 	env->tex_param_i(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
 	env->tex_param_i(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
 	env->tex_param_i(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
@@ -596,6 +681,7 @@ static bool update_cube(
 
 	backing->update_ts = arcan_timemillis();
 	env->bind_texture(GL_TEXTURE_CUBE_MAP, 0);
+	env->last_texid = -1;
 	return true;
 }
 
@@ -874,12 +960,12 @@ void agp_activate_rendertarget(struct agp_rendertarget* tgt)
 	if (!tgt || !(tgt->mode & RENDERTARGET_RETAIN_ALPHA)){
 		env->blend_src_alpha = GL_ONE;
 		env->blend_dst_alpha = GL_ONE;
-		agp_blendstate(BLEND_NORMAL);
 	}
 	else {
 		env->blend_src_alpha = GL_SRC_ALPHA;
 		env->blend_dst_alpha = GL_ONE_MINUS_SRC_ALPHA;
 	}
+	env->last_blend = -1;
 	agp_blendstate(BLEND_NORMAL);
 
 #ifdef HEADLESS_NOARCAN
@@ -901,6 +987,7 @@ void agp_activate_rendertarget(struct agp_rendertarget* tgt)
 		if (tgt->store->refcount < 2 &&
 			tgt->proxy_state && tgt->proxy_state(tgt, tgt->proxy_tag)){
 			verbose_print("rendertarget-proxy");
+			tgt->direct = true;
 			BIND_FRAMEBUFFER(0);
 			env->clear_color(tgt->clearcol[0],
 				tgt->clearcol[1], tgt->clearcol[2], tgt->clearcol[3]);
@@ -909,8 +996,12 @@ void agp_activate_rendertarget(struct agp_rendertarget* tgt)
 		}
 		else {
 			verbose_print("rendertarget-fbo(%d)", (int)tgt->fbo);
+			if (tgt->direct)
+				tgt->retained = false;
+			tgt->direct = false;
 			BIND_FRAMEBUFFER(tgt->fbo);
 		}
+		tgt->clipped = false;
 		w = tgt->store->w;
 		h = tgt->store->h;
 		env->clear_color(tgt->clearcol[0],
@@ -930,12 +1021,8 @@ void agp_activate_rendertarget(struct agp_rendertarget* tgt)
 void agp_rendertarget_dirty_reset(
 	struct agp_rendertarget* src, struct agp_region* dst)
 {
-	for (size_t i = 0; i < src->dirty_region && dst; i++){
-		dst[i] = (struct agp_region){
-			.x1 = 0, .y1 = 0,
-			.x2 = src->store->w, .y2 = src->store->h
-		};
-	}
+	if (dst)
+		memcpy(dst, src->dirty, sizeof(struct agp_region) * src->dirty_region);
 	src->dirty_region = 0;
 }
 
@@ -985,6 +1072,7 @@ void agp_null_vstore(struct agp_vstore* store)
 		return;
 
 	agp_env()->delete_textures(1, &store->vinf.text.glid);
+	agp_env()->last_texid = -1;
 	verbose_print("cleared (%"PRIxPTR"), dropped %u",
 		(uintptr_t) store, store->vinf.text.glid);
 	store->vinf.text.glid = GL_NONE;
@@ -1021,6 +1109,8 @@ void agp_resize_rendertarget(
 	tgt->store->h = newh;
 	tgt->store_ind = 0;
 	tgt->rz_ack = true;
+	tgt->retained = false;
+	tgt->dirty_region = 0;
 
 	if (tgt->n_stores){
 		for (size_t i = 0; i < tgt->n_stores; i++){
@@ -1080,6 +1170,7 @@ void agp_activate_vstore_multi(struct agp_vstore** backing, size_t n)
 	}
 
 	env->active_texture(GL_TEXTURE0);
+	env->last_texid = -1;
 }
 
 void agp_update_vstore(struct agp_vstore* s, bool copy)
@@ -1090,8 +1181,9 @@ void agp_update_vstore(struct agp_vstore* s, bool copy)
 
 	verbose_print(
 		"update vstore (%"PRIxPTR"), copy: %d", (uintptr_t) s, (int) copy);
-	FLAG_DIRTY();
+	FLAG_DIRTY(NULL);
 
+	env->last_texid = -1;
 	if (!copy)
 		env->bind_texture(GL_TEXTURE_2D, s->vinf.text.glid);
 	else{
@@ -1188,6 +1280,7 @@ void agp_update_vstore(struct agp_vstore* s, bool copy)
 #endif
 
 	env->bind_texture(GL_TEXTURE_2D, 0);
+	env->last_texid = -1;
 }
 
 void agp_prepare_stencil()
@@ -1198,6 +1291,7 @@ void agp_prepare_stencil()
 	struct agp_fenv* env = agp_env();
 	env->enable(GL_STENCIL_TEST);
 	env->disable(GL_BLEND);
+	env->last_blend = -1;
 	env->clear_stencil(0);
 	env->clear(GL_STENCIL_BUFFER_BIT);
 	env->color_mask(0, 0, 0, 0);
@@ -1228,6 +1322,9 @@ static float ident[] = {
 void agp_blendstate(enum arcan_blendfunc mode)
 {
 	struct agp_fenv* env = agp_env();
+	if (env->last_blend == (int) mode)
+		return;
+	env->last_blend = mode;
 
 	if (mode == BLEND_NONE){
 		env->disable(GL_BLEND);
@@ -1311,6 +1408,37 @@ void agp_draw_vobj(
 	agp_rendertarget_dirty(active_rendertarget, &(struct agp_region){});
 }
 
+void agp_draw_vobj_batch(const float* verts, const float* txcos, size_t n)
+{
+	verbose_print("draw-vobj-batch(%zu)", n);
+	struct agp_fenv* env = agp_env();
+
+	agp_shader_envv(MODELVIEW_MATR, ident, sizeof(float) * 16);
+
+	GLint attrindv = agp_shader_vattribute_loc(ATTRIBUTE_VERTEX);
+	GLint attrindt = agp_shader_vattribute_loc(ATTRIBUTE_TEXCORD0);
+
+	if (attrindv == -1 || !n)
+		return;
+
+	env->enable_vertex_attrarray(attrindv);
+	env->vertex_attrpointer(attrindv, 2, GL_FLOAT, GL_FALSE, 0, verts);
+
+	if (attrindt != -1){
+		env->enable_vertex_attrarray(attrindt);
+		env->vertex_attrpointer(attrindt, 2, GL_FLOAT, GL_FALSE, 0, txcos);
+	}
+
+	env->draw_arrays(GL_TRIANGLES, 0, n * 6);
+
+	if (attrindt != -1)
+		env->disable_vertex_attrarray(attrindt);
+
+	env->disable_vertex_attrarray(attrindv);
+
+	agp_rendertarget_dirty(active_rendertarget, &(struct agp_region){});
+}
+
 static void toggle_debugstates(float* modelview)
 {
 	struct agp_fenv* env = agp_env();
@@ -1499,6 +1627,7 @@ void agp_drop_vstore(struct agp_vstore* s)
 	}
 
 	env->delete_textures(1, &s->vinf.text.glid);
+	env->last_texid = -1;
 	s->vinf.text.glid = GL_NONE;
 
 	if (GL_NONE != s->vinf.text.rid){
@@ -1618,6 +1747,8 @@ void agp_invalidate_mesh(struct agp_mesh_store* bs)
 void agp_activate_vstore(struct agp_vstore* s)
 {
 	struct agp_fenv* env = agp_env();
+	GLint mode = env->last_store_mode;
+
 	if (s->txmapped == TXSTATE_OFF){
 		return;
 	}
@@ -1631,15 +1762,23 @@ void agp_activate_vstore(struct agp_vstore* s)
 		env->last_store_mode = GL_TEXTURE_2D;
 	}
 
+	GLint id = agp_resolve_texid(s);
+	if (mode == env->last_store_mode && id == env->last_texid)
+		return;
+
 	verbose_print("(%"PRIxPTR") vstore, glid: %u",
-		(uintptr_t) s, (unsigned) agp_resolve_texid(s));
-	env->bind_texture(env->last_store_mode, agp_resolve_texid(s));
+		(uintptr_t) s, (unsigned) id);
+	env->bind_texture(env->last_store_mode, id);
+	env->last_texid = id;
 }
 
 void agp_deactivate_vstore()
 {
 	verbose_print("");
-	agp_env()->bind_texture(GL_TEXTURE_2D, 0);
+	struct agp_fenv* env = agp_env();
+	env->bind_texture(GL_TEXTURE_2D, 0);
+	env->last_store_mode = GL_TEXTURE_2D;
+	env->last_texid = 0;
 }
 
 void agp_rendertarget_clearcolor(
@@ -25,7 +25,7 @@
 
 #ifdef HEADLESS_NOARCAN
 #undef FLAG_DIRTY
-#define FLAG_DIRTY()
+#define FLAG_DIRTY(X)
 #endif
 
 #define TBLSIZE (1 + TIMESTAMP_D - MODELVIEW_MATR)
@@ -158,6 +158,11 @@ struct shader_cont {
 /* match attrsymtbl */
 	GLint attributes[9];
 
+/* last values uploaded for the global uniforms, [synched] is a bitmap of
+ * slots where the shadow matches the program state */
+	struct shader_envts shadow;
+	uint32_t synched;
+
 	struct arcan_strarr ugroups;
 };
 
@@ -182,6 +187,22 @@ static struct {
 static bool build_shader(const char*, GLuint*, GLuint*, GLuint*,
 	const char*, const char*);
 static void kill_shader(GLuint* dprg, GLuint* vprg, GLuint* fprg);
+static void setv(GLint loc, enum shdrutype kind, void* val,
+	const char* id, const char* program);
+
+/* upload global [slot] to [cur] unless it already has that value */
+static void synch_global(struct shader_cont* cur, int slot, void* value)
+{
+	char* dst = (char*)(&cur->shadow) + ofstbl[slot];
+	size_t size = sizetbl[typetbl[slot]];
+
+	if ((cur->synched & (1 << slot)) && memcmp(dst, value, size) == 0)
+		return;
+
+	setv(cur->locations[slot], typetbl[slot], value, symtbl[slot], cur->label);
+	memcpy(dst, value, size);
+	cur->synched |= 1 << slot;
+}
 
 static void setv(GLint loc, enum shdrutype kind, void* val,
 	const char* id, const char* program)
@@ -320,8 +341,7 @@ int agp_shader_activate(agp_shader_id shid)
  */
 		for (size_t i = 0; i < sizeof(ofstbl) / sizeof(ofstbl[0]); i++){
 			if (cur->locations[i] >= 0){
-				setv(cur->locations[i], typetbl[i], (char*)(&shdr_global.context)
-					+ ofstbl[i], symtbl[i], cur->label);
+				synch_global(cur, i, (char*)(&shdr_global.context) + ofstbl[i]);
 				counttbl[i]++;
 			}
 		}
@@ -464,6 +484,7 @@ agp_shader_id agp_shader_build(const char* tag,
 
 /* always reset locations tbl */
 	int global_lim = sizeof(ofstbl) / sizeof(ofstbl[0]);
+	cur->synched = 0;
 	for (int i = 0; i < global_lim; i++)
 		cur->locations[i] = -1;
 
@@ -534,8 +555,8 @@ int agp_shader_envv(enum agp_shader_envts slot, void* value, size_t size)
  */
 	if (glloc != -1){
 		assert(size == sizetbl[ typetbl[slot] ]);
-		setv(glloc, typetbl[slot], value, symtbl[slot],
-			shdr_global.slots[SHADER_INDEX(shdr_global.active_prg)].label );
+		synch_global(
+			&shdr_global.slots[SHADER_INDEX(shdr_global.active_prg)], slot, value);
 		counttbl[slot]++;
 
 		return rv;
@@ -612,7 +633,6 @@ void agp_shader_forceunif(const char* label, enum shdrutype type, void* value)
 	assert(shdr_global.active_prg != BROKEN_SHADER);
 	struct shader_cont* slot = &shdr_global.slots[
 		SHADER_INDEX(shdr_global.active_prg)];
-	FLAG_DIRTY();
 
 /* linear search */
 	struct shaderv** current = (struct shaderv**) &(
@@ -627,6 +647,11 @@ void agp_shader_forceunif(const char* label, enum shdrutype type, void* value)
 		if ((*current)->type != type)
 			arcan_warning("agp_shader_forceunif(), type mismatch for "
 				"persistant shader uniform (%s:%i=>%i), ignored.\n", label, loc, type);
+
+/* group values are uploaded on activation, so an unchanged value is
+ * already what the program has */
+		else if (memcmp((*current)->data, value, sizetbl[type]) == 0)
+			return;
 	}
 	else {
 		loc = agp_env()->get_uniform_loc(slot->prg_container, label);
@@ -637,10 +662,16 @@ void agp_shader_forceunif(const char* label, enum shdrutype type, void* value)
 		(*current)->type  = type;
 		(*current)->next  = NULL;
 	}
+	FLAG_DIRTY(NULL);
 	memcpy((*current)->data, value, sizetbl[type]);
 
 	if (loc >= 0){
 		setv(loc, type, value, label, slot->label);
+
+/* aliasing a global would leave its shadow stale */
+		for (size_t i = 0; i < TBLSIZE; i++)
+			if (slot->locations[i] == loc)
+				slot->synched &= ~(1 << i);
 	}
 #ifdef DEBUG
 	else
@@ -767,5 +798,6 @@ void agp_shader_rebuild_all()
 
 		build_shader(cur->label, &cur->prg_container, &cur->obj_vertex,
 			&cur->obj_fragment, cur->vertex, cur->fragment);
+		cur->synched = 0;
 	}
 }
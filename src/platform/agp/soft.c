@@ -0,0 +1,2278 @@
+/*
+ * Copyright 2026, arcan contributors
+ * License: 3-Clause BSD, see COPYING file in arcan source repository.
+ * Reference: http://arcan-fe.com
+ * Description: Software rasterizer implementation of the AGP interface.
+ * This is intended for GPU-less setups (headless testing, render farms and
+ * low-memory kiosk style compositors). It covers the 2D pipeline (textured
+ * and colored quads, stencil clipping, blending, rendertargets, readbacks)
+ * along with a basic depth-tested triangle path for agp_submit_mesh.
+ *
+ * Notes:
+ *  - shaders are not executed, the program sources are stored so that they
+ *    can be queried, but each program is classified as either 'textured' or
+ *    'color' and behaves like the corresponding default shader.
+ *
+ *  - vstores still use vinf.text.raw as the on-host copy that the engine
+ *    manages, the actual 'texture' lives in a backend owned table indexed by
+ *    vinf.text.glid, mirroring the GL implementations so that the engine
+ *    memory management (conservative mode, forceread, ...) works unmodified.
+ *
+ *  - blend modes match what glshared.c actually configures, which means that
+ *    ADD and MULTIPLY currently behave as NORMAL. This is so that the output
+ *    can be compared against the reference images in tests/regression.
+ */
+
+#include <stdlib.h>
+#include <stdint.h>
+#include <stddef.h>
+#include <stdio.h>
+#include <stdbool.h>
+#include <assert.h>
+#include <string.h>
+#include <math.h>
+#include <inttypes.h>
+
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
+#include "../video_platform.h"
+#include "../platform.h"
+
+#include "arcan_math.h"
+#include "arcan_general.h"
+#include "arcan_video.h"
+#include "arcan_mem.h"
+#include "arcan_videoint.h"
+
+#ifdef HEADLESS_NOARCAN
+#undef FLAG_DIRTY
+#define FLAG_DIRTY(X)
+#endif
+
+#ifdef _DEBUG
+#define DEBUG 1
+#else
+#define DEBUG 0
+#endif
+
+#define debug_print(fmt, ...) \
+            do { if (DEBUG) arcan_warning("%lld:%s:%d:%s(): " fmt "\n",\
+						arcan_timemillis(), "agp-soft:", __LINE__, __func__,##__VA_ARGS__); } while (0)
+
+#ifndef verbose_print
+#define verbose_print
+#endif
+
+/*
+ * These are never executed, they are only kept so that scripts that query
+ * and patch the default programs still receive something sensible, and are
+ * used to classify the default shaders.
+ */
+static const char* defvprg =
+"#version 120\n"
+"uniform mat4 modelview;\n"
+"uniform mat4 projection;\n"
+"attribute vec2 texcoord;\n"
+"varying vec2 texco;\n"
+"attribute vec4 vertex;\n"
+"void main(){\n"
+"	gl_Position = (projection * modelview) * vertex;\n"
+"   texco = texcoord;\n"
+"}";
+
+static const char* deffprg =
+"#version 120\n"
+"uniform sampler2D map_diffuse;\n"
+"varying vec2 texco;\n"
+"uniform float obj_opacity;\n"
+"void main(){\n"
+"   vec4 col = texture2D(map_diffuse, texco);\n"
+"   col.a = col.a * obj_opacity;\n"
+"	gl_FragColor = col;\n"
+"}";
+
+static const char* defcfprg =
+"#version 120\n"
+"uniform vec3 obj_col;\n"
+"uniform float obj_opacity;\n"
+"void main(){\n"
+"   gl_FragColor = vec4(obj_col.rgb, obj_opacity);\n"
+"}\n";
+
+static const char * defcvprg =
+"#version 120\n"
+"uniform mat4 modelview;\n"
+"uniform mat4 projection;\n"
+"attribute vec4 vertex;\n"
+"void main(){\n"
+" gl_Position = (projection * modelview) * vertex;\n"
+"}";
+
+/* same as in glshared.c, see the comments there on buffer rotation */
+#define MAX_BUFFERS 3
+
+/* number of pixels processed per span in the gather -> blend stage */
+#define SPAN_CHUNK 256
+
+/*
+ * Texture objects, vinf.text.glid is 1 + the index into this table so that
+ * the engine tests against 0 (GL_NONE) still work.
+ */
+struct soft_tex {
+	av_pixel* buf;
+	size_t w, h;
+	bool used;
+	bool noalpha;
+
+/* agp_request_readback / agp_poll_readback */
+	bool rb_pending;
+	av_pixel* rb_buf;
+	size_t rb_sz;
+};
+
+struct agp_rendertarget
+{
+	struct agp_vstore* store;
+	enum rendertarget_mode mode;
+	float clearcol[4];
+
+/* lazily allocated on first stencil / depth use, sized to the target */
+	uint8_t* stencil;
+	float* depth;
+	size_t aux_w, aux_h;
+
+	bool (*proxy_state)(struct agp_rendertarget* tgt, uintptr_t tag);
+	uintptr_t proxy_tag;
+
+	size_t dirty_region;
+
+/* used for multi-buffering mode */
+	size_t n_stores;
+	size_t store_ind;
+	struct agp_vstore* stores[MAX_BUFFERS];
+};
+
+/* there is no function environment to speak of, but the video platforms
+ * expect to be able to allocate / set one */
+struct agp_fenv {
+	uint32_t cookie;
+};
+
+/* matches shdrmgmt.c */
+#define TBLSIZE (1 + TIMESTAMP_D - MODELVIEW_MATR)
+
+struct shader_envts {
+	float modelview[16];
+	float projection[16];
+	float texturemat[16];
+
+	float opacity;
+	float blend;
+	float move;
+	float rotate;
+	float scale;
+
+	float sz_input[2];
+	float sz_output[2];
+	float sz_storage[2];
+
+	int rtgt_id;
+
+	float fract_timestamp;
+	arcan_tickv timestamp;
+};
+
+static int ofstbl[TBLSIZE] = {
+	offsetof(struct shader_envts, modelview),
+	offsetof(struct shader_envts, projection),
+	offsetof(struct shader_envts, texturemat),
+	offsetof(struct shader_envts, opacity),
+
+	offsetof(struct shader_envts, blend),
+	offsetof(struct shader_envts, move),
+	offsetof(struct shader_envts, rotate),
+	offsetof(struct shader_envts, scale),
+
+	offsetof(struct shader_envts, sz_input),
+	offsetof(struct shader_envts, sz_output),
+	offsetof(struct shader_envts, sz_storage),
+
+	offsetof(struct shader_envts, rtgt_id),
+
+	offsetof(struct shader_envts, fract_timestamp),
+	offsetof(struct shader_envts, timestamp)
+};
+
+static char* symtbl[TBLSIZE] = {
+	"modelview",
+	"projection",
+	"texturem",
+	"obj_opacity",
+	"trans_blend",
+	"trans_move",
+	"trans_scale",
+	"trans_rotate",
+	"obj_input_sz",
+	"obj_output_sz",
+	"obj_storage_sz",
+	"rtgt_id",
+	"fract_timestamp",
+	"timestamp"
+};
+
+static int sizetbl[7] = {
+	sizeof(int),
+	sizeof(int),
+	sizeof(float),
+	sizeof(float) * 2,
+	sizeof(float) * 3,
+	sizeof(float) * 4,
+	sizeof(float) * 16
+};
+
+struct shaderv {
+	char* label;
+	enum shdrutype type;
+	uint8_t data[64];
+	struct shaderv* next;
+};
+
+enum shader_kind {
+	SHADER_TEXTURED = 0,
+	SHADER_COLOR = 1
+};
+
+struct shader_cont {
+	char* label;
+	char (* vertex), (* fragment);
+	enum shader_kind kind;
+	struct arcan_strarr ugroups;
+};
+
+enum stencil_state {
+	STENCIL_OFF = 0,
+	STENCIL_WRITE,
+	STENCIL_TEST
+};
+
+static struct {
+	struct soft_tex* tex;
+	size_t n_tex;
+
+/* the 'display' used when no rendertarget is active */
+	struct agp_rendertarget screen;
+	struct agp_vstore screen_store;
+
+	struct agp_rendertarget* rtgt;
+	struct agp_vstore* store;
+	enum arcan_blendfunc blend;
+	enum stencil_state stencil;
+	enum pipeline_mode pipeline;
+	bool retain_alpha;
+	int line_width;
+
+	struct shader_cont slots[256];
+	size_t ofs;
+	agp_shader_id active_prg;
+	struct shader_envts context;
+} soft = {
+	.active_prg = BROKEN_SHADER,
+	.blend = BLEND_NORMAL,
+	.line_width = 1
+};
+
+static struct agp_fenv* active_env;
+static struct agp_fenv defenv = {.cookie = 0xfeedface};
+
+static float ident[] = {
+	1.0, 0.0, 0.0, 0.0,
+	0.0, 1.0, 0.0, 0.0,
+	0.0, 0.0, 1.0, 0.0,
+	0.0, 0.0, 0.0, 1.0
+};
+
+/*
+ * Texture table management
+ */
+static struct soft_tex* get_tex(unsigned id)
+{
+	if (id == 0 || id > soft.n_tex || !soft.tex[id-1].used)
+		return NULL;
+
+	return &soft.tex[id-1];
+}
+
+static unsigned alloc_tex()
+{
+	for (size_t i = 0; i < soft.n_tex; i++)
+		if (!soft.tex[i].used){
+			soft.tex[i] = (struct soft_tex){.used = true};
+			return i + 1;
+		}
+
+	size_t new_sz = soft.n_tex ? soft.n_tex * 2 : 64;
+	struct soft_tex* new_tbl = arcan_alloc_mem(
+		sizeof(struct soft_tex) * new_sz,
+		ARCAN_MEM_VSTRUCT, ARCAN_MEM_BZERO, ARCAN_MEMALIGN_NATURAL
+	);
+
+	if (soft.tex){
+		memcpy(new_tbl, soft.tex, sizeof(struct soft_tex) * soft.n_tex);
+		arcan_mem_free(soft.tex);
+	}
+
+	soft.tex = new_tbl;
+	unsigned res = soft.n_tex + 1;
+	soft.n_tex = new_sz;
+	soft.tex[res-1].used = true;
+
+	return res;
+}
+
+static void free_tex(unsigned id)
+{
+	struct soft_tex* t = get_tex(id);
+	if (!t)
+		return;
+
+	arcan_mem_free(t->buf);
+	arcan_mem_free(t->rb_buf);
+	*t = (struct soft_tex){};
+}
+
+static void tex_storage(struct soft_tex* t, size_t w, size_t h)
+{
+	if (t->buf && t->w == w && t->h == h)
+		return;
+
+	arcan_mem_free(t->buf);
+	t->buf = NULL;
+	t->w = w;
+	t->h = h;
+
+	if (!w || !h)
+		return;
+
+	t->buf = arcan_alloc_mem(w * h * sizeof(av_pixel),
+		ARCAN_MEM_VBUFFER, ARCAN_MEM_BZERO, ARCAN_MEMALIGN_PAGE);
+}
+
+static void tex_upload(struct soft_tex* t, const av_pixel* src, size_t stride,
+	size_t x1, size_t y1, size_t w, size_t h)
+{
+	if (!t->buf || !src || x1 >= t->w || y1 >= t->h)
+		return;
+
+	if (x1 + w > t->w)
+		w = t->w - x1;
+
+	if (y1 + h > t->h)
+		h = t->h - y1;
+
+	for (size_t y = y1; y < y1 + h; y++){
+		av_pixel* dst = &t->buf[y * t->w + x1];
+		memcpy(dst, &src[y * stride + x1], w * sizeof(av_pixel));
+
+		if (t->noalpha)
+			for (size_t x = 0; x < w; x++)
+				dst[x] |= RGBA(0, 0, 0, 0xff);
+	}
+}
+
+unsigned agp_resolve_texid(struct agp_vstore* vs)
+{
+	if (vs->vinf.text.glid_proxy)
+		return *vs->vinf.text.glid_proxy;
+	else
+		return vs->vinf.text.glid;
+}
+
+/*
+ * Function environment, only kept to satisfy the video platforms
+ */
+struct agp_fenv* agp_alloc_fenv(
+	void*(lookup)(void* tag, const char* sym, bool req), void* tag)
+{
+	struct agp_fenv* fenv = arcan_alloc_mem(
+		sizeof(struct agp_fenv),
+		ARCAN_MEM_VSTRUCT, ARCAN_MEM_BZERO, ARCAN_MEMALIGN_NATURAL
+	);
+	fenv->cookie = 0xfeedface;
+
+	if (!active_env)
+		active_env = fenv;
+
+	return fenv;
+}
+
+struct agp_fenv* agp_env()
+{
+	return active_env;
+}
+
+void agp_setenv(struct agp_fenv* dst)
+{
+	active_env = dst;
+}
+
+void agp_dropenv(struct agp_fenv* env)
+{
+	if (!env || env->cookie != 0xfeedface){
+		arcan_warning("agp_dropenv() - code issue: called on bad/broken fenv\n");
+		return;
+	}
+	env->cookie = 0xdeadbeef;
+	if (env != &defenv)
+		arcan_mem_free(env);
+	if (active_env == env)
+		active_env = NULL;
+}
+
+void agp_init()
+{
+	if (!active_env)
+		active_env = &defenv;
+
+	soft.blend = BLEND_NORMAL;
+	soft.stencil = STENCIL_OFF;
+	soft.pipeline = PIPELINE_2D;
+}
+
+const char* agp_ident()
+{
+	return "SOFT";
+}
+
+const char* agp_shader_language()
+{
+	return "NONE";
+}
+
+const char** agp_envopts()
+{
+	static const char* env[] = {
+		NULL, NULL
+	};
+	return env;
+}
+
+void agp_shader_source(enum SHADER_TYPES type,
+	const char** vert, const char** frag)
+{
+	switch(type){
+	case BASIC_2D:
+	case BASIC_3D:
+		*vert = defvprg;
+		*frag = deffprg;
+	break;
+
+	case COLOR_2D:
+		*vert = defcvprg;
+		*frag = defcfprg;
+	break;
+
+	default:
+		*vert = NULL;
+		*frag = NULL;
+	break;
+	}
+}
+
+agp_shader_id agp_default_shader(enum SHADER_TYPES type)
+{
+	static agp_shader_id shids[SHADER_TYPE_ENDM];
+	static bool defshdr_build;
+
+	assert(type < SHADER_TYPE_ENDM);
+
+	if (!defshdr_build){
+		shids[BASIC_2D] = agp_shader_build("DEFAULT", NULL, defvprg, deffprg);
+		shids[COLOR_2D] = agp_shader_build(
+			"DEFAULT_COLOR", NULL, defcvprg, defcfprg);
+		shids[BASIC_3D] = shids[BASIC_2D];
+		defshdr_build = true;
+	}
+
+	return shids[type];
+}
+
+/*
+ * Vstore management
+ */
+void agp_update_vstore(struct agp_vstore* s, bool copy)
+{
+	if (s->txmapped == TXSTATE_OFF)
+		return;
+
+	verbose_print(
+		"update vstore (%"PRIxPTR"), copy: %d", (uintptr_t) s, (int) copy);
+	FLAG_DIRTY(NULL);
+	s->vinf.text.glid_proxy = NULL;
+
+/* filtering and wrapping is resolved when sampling */
+	if (!copy)
+		return;
+
+	if (!get_tex(s->vinf.text.glid))
+		s->vinf.text.glid = alloc_tex();
+
+	if (s->refcount == 0)
+		s->refcount = 1;
+
+	struct soft_tex* t = get_tex(s->vinf.text.glid);
+	tex_storage(t, s->w, s->h);
+	t->noalpha = s->vinf.text.d_fmt == GL_NOALPHA_PIXEL_FORMAT;
+	s->update_ts = arcan_timemillis();
+
+	if (s->txmapped == TXSTATE_TEX2D && s->vinf.text.raw &&
+		s->vinf.text.s_raw >= s->w * s->h * sizeof(av_pixel))
+		tex_upload(t, s->vinf.text.raw, s->w, 0, 0, s->w, s->h);
+
+/* unlike the GL backends, raw is kept in conservative mode as well, there
+ * is no GPU side copy to fall back on for readbacks and re-uploads */
+}
+
+void agp_empty_vstore(struct agp_vstore* vs, size_t w, size_t h)
+{
+	if (vs->vinf.text.s_fmt == 0){
+		vs->vinf.text.s_fmt = GL_PIXEL_FORMAT;
+	if (vs->vinf.text.d_fmt == 0)
+		vs->vinf.text.d_fmt = GL_STORE_PIXEL_FORMAT;
+	}
+
+	vs->w = w;
+	vs->h = h;
+	vs->bpp = sizeof(av_pixel);
+	vs->txmapped = TXSTATE_TEX2D;
+
+/* keep a zeroed raw buffer around, synchronous readbacks into the store
+ * copy through it */
+	size_t sz = w * h * sizeof(av_pixel);
+	if (vs->vinf.text.raw && vs->vinf.text.s_raw == sz)
+		memset(vs->vinf.text.raw, '\0', sz);
+	else {
+		arcan_mem_free(vs->vinf.text.raw);
+		vs->vinf.text.raw = arcan_alloc_mem(sz,
+			ARCAN_MEM_VBUFFER, ARCAN_MEM_BZERO, ARCAN_MEMALIGN_PAGE);
+		vs->vinf.text.s_raw = sz;
+	}
+
+	agp_update_vstore(vs, true);
+	verbose_print("(%"PRIxPTR") cleared to %zu*%zu", (uintptr_t) vs, w, h);
+}
+
+/*
+ * Only the native pixel format is supported, the hint is ignored.
+ */
+void agp_empty_vstoreext(struct agp_vstore* vs,
+	size_t w, size_t h, enum vstore_hint hint)
+{
+	vs->vinf.text.d_fmt = (hint & 1) ?
+		GL_NOALPHA_PIXEL_FORMAT : GL_STORE_PIXEL_FORMAT;
+	vs->vinf.text.s_fmt = GL_PIXEL_FORMAT;
+	agp_empty_vstore(vs, w, h);
+}
+
+bool agp_slice_vstore(struct agp_vstore* backing,
+	size_t n_slices, size_t base, enum txstate txstate)
+{
+	verbose_print("sliced vstores not supported");
+	return false;
+}
+
+bool agp_slice_synch(
+	struct agp_vstore* backing, size_t n_slices, struct agp_vstore** slices)
+{
+	return false;
+}
+
+void agp_null_vstore(struct agp_vstore* store)
+{
+	if (!store ||
+		store->txmapped != TXSTATE_TEX2D || store->vinf.text.glid == 0)
+		return;
+
+	free_tex(store->vinf.text.glid);
+	verbose_print("cleared (%"PRIxPTR")", (uintptr_t) store);
+	store->vinf.text.glid = 0;
+	store->vinf.text.glid_proxy = NULL;
+}
+
+void agp_drop_vstore(struct agp_vstore* s)
+{
+	if (!s || s->vinf.text.glid == 0)
+		return;
+
+	if (s->vinf.text.tag)
+		platform_video_map_handle(s, -1);
+
+	if (s->vinf.text.kind == STORAGE_TEXT){
+		arcan_mem_free(s->vinf.text.source);
+	}
+
+	if (s->vinf.text.kind == STORAGE_TEXTARRAY){
+		char** work = s->vinf.text.source_arr;
+		while(*work){
+			arcan_mem_free(*work);
+			work++;
+		}
+		arcan_mem_free(s->vinf.text.source_arr);
+	}
+
+	free_tex(s->vinf.text.glid);
+	verbose_print("dropped (%"PRIxPTR")", (uintptr_t) s);
+	memset(s, '\0', sizeof(struct agp_vstore));
+}
+
+static void alloc_buffer(struct agp_vstore* s)
+{
+	if (s->vinf.text.s_raw != s->w * s->h * sizeof(av_pixel)){
+		arcan_mem_free(s->vinf.text.raw);
+		s->vinf.text.raw = NULL;
+	}
+
+	if (!s->vinf.text.raw){
+		verbose_print("(%"PRIxPTR") alloc buffer", (uintptr_t) s);
+		s->vinf.text.s_raw = s->w * s->h * sizeof(av_pixel);
+		s->vinf.text.raw = arcan_alloc_mem(s->vinf.text.s_raw,
+			ARCAN_MEM_VBUFFER, ARCAN_MEM_BZERO, ARCAN_MEMALIGN_PAGE);
+	}
+}
+
+void agp_resize_vstore(struct agp_vstore* s, size_t w, size_t h)
+{
+	s->w = w;
+	s->h = h;
+	s->bpp = sizeof(av_pixel);
+
+	verbose_print("(%"PRIxPTR") resize to %zu * %zu", (uintptr_t) s, w, h);
+	alloc_buffer(s);
+	agp_update_vstore(s, true);
+}
+
+void agp_activate_vstore(struct agp_vstore* s)
+{
+	if (s->txmapped == TXSTATE_OFF)
+		return;
+
+	verbose_print("(%"PRIxPTR") vstore", (uintptr_t) s);
+	soft.store = s;
+}
+
+void agp_deactivate_vstore()
+{
+	soft.store = NULL;
+}
+
+/* there is only one sampler, so the first store gets used */
+void agp_activate_vstore_multi(struct agp_vstore** backing, size_t n)
+{
+	if (n)
+		agp_activate_vstore(backing[0]);
+}
+
+static void stream_copy(struct agp_vstore* s,
+	av_pixel* buf, struct stream_meta* meta, bool synch)
+{
+	struct soft_tex* t = get_tex(s->vinf.text.glid);
+	if (!t){
+		agp_update_vstore(s, true);
+		if (!(t = get_tex(s->vinf.text.glid)))
+			return;
+	}
+	tex_storage(t, s->w, s->h);
+
+	size_t x1 = 0, y1 = 0, w = s->w, h = s->h;
+	if (meta->dirty){
+		x1 = meta->x1;
+		y1 = meta->y1;
+		w = meta->w;
+		h = meta->h;
+	}
+
+	tex_upload(t, buf, s->w, x1, y1, w, h);
+
+	if (synch && s->vinf.text.raw && s->vinf.text.raw != buf){
+		for (size_t y = y1; y < y1 + h && y < s->h; y++)
+			memcpy(&s->vinf.text.raw[y * s->w + x1],
+				&buf[y * s->w + x1], w * sizeof(av_pixel));
+		s->update_ts = arcan_timemillis();
+	}
+
+/* no global dirty here, the engine flags the objects using the store */
+}
+
+struct stream_meta agp_stream_prepare(struct agp_vstore* s,
+		struct stream_meta meta, enum stream_type type)
+{
+	struct stream_meta res = meta;
+	res.state = true;
+	res.type = type;
+
+	switch (type){
+	case STREAM_RAW:
+		verbose_print("(%"PRIxPTR") prepare upload (raw)", (uintptr_t) s);
+		alloc_buffer(s);
+		res.buf = s->vinf.text.raw;
+		res.state = res.buf != NULL;
+	break;
+
+	case STREAM_RAW_DIRECT_COPY:
+		alloc_buffer(s);
+	case STREAM_RAW_DIRECT:
+	case STREAM_RAW_DIRECT_SYNCHRONOUS:
+		verbose_print("(%"PRIxPTR") prepare upload (raw/direct)", (uintptr_t) s);
+		stream_copy(s, meta.buf, &meta, type == STREAM_RAW_DIRECT_COPY);
+	break;
+
+	case STREAM_EXT_RESYNCH:
+		verbose_print("(%"PRIxPTR") resynch stream", (uintptr_t) s);
+		agp_null_vstore(s);
+		agp_update_vstore(s, true);
+	break;
+
+/* the texture storage is the upload store, so just expose it */
+	case STREAM_RAW_DIRECT_MAPPED:{
+		verbose_print("(%"PRIxPTR") prepare upload (raw/mapped)", (uintptr_t) s);
+		struct soft_tex* t = get_tex(s->vinf.text.glid);
+		if (!t){
+			agp_update_vstore(s, true);
+			t = get_tex(s->vinf.text.glid);
+		}
+
+		res.buf = NULL;
+		res.dirty = false;
+		if (t){
+			tex_storage(t, s->w, s->h);
+			res.buf = t->buf;
+		}
+		res.state = res.buf != NULL;
+	}
+	break;
+
+	case STREAM_HANDLE:
+		res.state = platform_video_map_handle(s, meta.handle);
+	break;
+	}
+
+	return res;
+}
+
+void agp_stream_release(struct agp_vstore* s, struct stream_meta meta)
+{
+	verbose_print("(%"PRIxPTR") release", (uintptr_t) s);
+	stream_copy(s, s->vinf.text.raw, &meta, false);
+}
+
+void agp_stream_commit(struct agp_vstore* s, struct stream_meta meta)
+{
+	if (meta.type != STREAM_RAW_DIRECT_MAPPED || !meta.state)
+		return;
+
+	struct soft_tex* t = get_tex(s->vinf.text.glid);
+	if (!t || t->buf != meta.buf)
+		return;
+
+	if (t->noalpha){
+		size_t ntc = t->w * t->h;
+		for (size_t i = 0; i < ntc; i++)
+			t->buf[i] |= RGBA(0, 0, 0, 0xff);
+	}
+}
+
+void agp_readback_synchronous(struct agp_vstore* dst)
+{
+	if (!(dst->txmapped == TXSTATE_TEX2D) || !dst->vinf.text.raw)
+		return;
+
+	struct soft_tex* t = get_tex(agp_resolve_texid(dst));
+	if (!t || !t->buf)
+		return;
+
+	size_t sz = t->w * t->h * sizeof(av_pixel);
+	if (dst->vinf.text.s_raw && dst->vinf.text.s_raw < sz)
+		sz = dst->vinf.text.s_raw;
+
+	memcpy(dst->vinf.text.raw, t->buf, sz);
+	dst->update_ts = arcan_timemillis();
+}
+
+static void default_release(void* tag)
+{
+	struct soft_tex* t = get_tex((uintptr_t) tag);
+	if (t)
+		t->rb_pending = false;
+}
+
+void agp_request_readback(struct agp_vstore* store)
+{
+	if (!store || store->txmapped != TXSTATE_TEX2D)
+		return;
+
+	struct soft_tex* own = get_tex(store->vinf.text.glid);
+	struct soft_tex* src = get_tex(agp_resolve_texid(store));
+	if (!own || !src || !src->buf || own->rb_pending)
+		return;
+
+	size_t sz = src->w * src->h * sizeof(av_pixel);
+	if (own->rb_sz != sz){
+		arcan_mem_free(own->rb_buf);
+		own->rb_buf = arcan_alloc_mem(sz,
+			ARCAN_MEM_VBUFFER, ARCAN_MEM_NONFATAL, ARCAN_MEMALIGN_PAGE);
+		own->rb_sz = own->rb_buf ? sz : 0;
+	}
+
+	if (!own->rb_buf)
+		return;
+
+	memcpy(own->rb_buf, src->buf, sz);
+	own->rb_pending = true;
+}
+
+struct asynch_readback_meta agp_poll_readback(struct agp_vstore* store)
+{
+	struct asynch_readback_meta res = {
+		.release = default_release
+	};
+
+	if (!store || store->txmapped != TXSTATE_TEX2D)
+		return res;
+
+	struct soft_tex* t = get_tex(store->vinf.text.glid);
+	if (!t || !t->rb_pending)
+		return res;
+
+	res.w = store->w;
+	res.h = store->h;
+	res.stride = store->w * sizeof(av_pixel);
+	res.buf_sz = t->rb_sz;
+	res.ptr = t->rb_buf;
+	res.tag = (void*)(uintptr_t) store->vinf.text.glid;
+
+	return res;
+}
+
+/*
+ * Rendertarget management
+ */
+static void setup_stores(struct agp_rendertarget* dst)
+{
+	dst->store_ind = 0;
+	dst->n_stores = MAX_BUFFERS;
+
+	for (size_t i = 0; i < MAX_BUFFERS; i++){
+		dst->stores[i] = arcan_alloc_mem(sizeof(struct agp_vstore),
+			ARCAN_MEM_VSTRUCT, ARCAN_MEM_BZERO, ARCAN_MEMALIGN_NATURAL);
+		dst->stores[i]->vinf.text.s_fmt = dst->store->vinf.text.s_fmt;
+		dst->stores[i]->vinf.text.d_fmt = dst->store->vinf.text.d_fmt;
+		agp_empty_vstore(dst->stores[i], dst->store->w, dst->store->h);
+	}
+}
+
+static void drop_stores(struct agp_rendertarget* tgt)
+{
+	for (size_t i = 0; i < tgt->n_stores; i++){
+		agp_drop_vstore(tgt->stores[i]);
+		arcan_mem_free(tgt->stores[i]);
+		tgt->stores[i] = NULL;
+	}
+	tgt->n_stores = 0;
+	tgt->store->vinf.text.glid_proxy = NULL;
+}
+
+struct agp_rendertarget* agp_setup_rendertarget(
+	struct agp_vstore* vstore, enum rendertarget_mode m)
+{
+	if (vstore->txmapped == TXSTATE_TEX3D)
+		return NULL;
+
+	struct agp_rendertarget* r = arcan_alloc_mem(sizeof(struct agp_rendertarget),
+		ARCAN_MEM_VSTRUCT, ARCAN_MEM_BZERO, ARCAN_MEMALIGN_NATURAL);
+
+	r->store = vstore;
+	r->mode = m;
+	r->clearcol[0] = 0.05;
+	r->clearcol[1] = 0.05;
+	r->clearcol[2] = 0.05;
+	r->clearcol[3] = 1.0;
+
+	if (!get_tex(vstore->vinf.text.glid)){
+		if (vstore->txmapped == TXSTATE_OFF)
+			vstore->txmapped = TXSTATE_TEX2D;
+		agp_update_vstore(vstore, true);
+	}
+
+	verbose_print("vstore (%"PRIxPTR") bound to rendertarget "
+		"(%"PRIxPTR") in mode %d", (uintptr_t) vstore, (uintptr_t) r, (int) m);
+	return r;
+}
+
+static void drop_aux(struct agp_rendertarget* tgt)
+{
+	arcan_mem_free(tgt->stencil);
+	arcan_mem_free(tgt->depth);
+	tgt->stencil = NULL;
+	tgt->depth = NULL;
+	tgt->aux_w = tgt->aux_h = 0;
+}
+
+void agp_drop_rendertarget(struct agp_rendertarget* tgt)
+{
+	if (!tgt)
+		return;
+
+	if (tgt == soft.rtgt)
+		agp_activate_rendertarget(NULL);
+
+	if (tgt->n_stores)
+		drop_stores(tgt);
+
+	drop_aux(tgt);
+	verbose_print("(%"PRIxPTR") rendertarget gone", (uintptr_t) tgt);
+	arcan_mem_free(tgt);
+}
+
+void agp_rendertarget_proxy(struct agp_rendertarget* tgt,
+	bool (*proxy_state)(struct agp_rendertarget*, uintptr_t tag), uintptr_t tag)
+{
+	tgt->proxy_state = proxy_state;
+	tgt->proxy_tag = tag;
+}
+
+void agp_rendertarget_ids(struct agp_rendertarget* rtgt, uintptr_t* tgt,
+	uintptr_t* col, uintptr_t* depth)
+{
+	if (tgt)
+		*tgt = (uintptr_t) rtgt;
+	if (col)
+		*col = agp_resolve_texid(rtgt->store);
+	if (depth)
+		*depth = 0;
+}
+
+void agp_activate_rendertarget(struct agp_rendertarget* tgt)
+{
+	verbose_print("set rendertarget: %"PRIxPTR, (uintptr_t)(void*)tgt);
+	soft.retain_alpha = tgt && (tgt->mode & RENDERTARGET_RETAIN_ALPHA);
+	agp_blendstate(BLEND_NORMAL);
+	soft.rtgt = tgt;
+}
+
+/*
+ * Resolve the buffer that drawing commands should go to, when no rendertarget
+ * is active this is a display sized buffer that agp_save_output reads from.
+ */
+static struct agp_rendertarget* active_target(struct soft_tex** out)
+{
+	struct agp_rendertarget* tgt = soft.rtgt;
+
+	if (!tgt){
+		tgt = &soft.screen;
+		if (!tgt->store){
+			tgt->store = &soft.screen_store;
+			tgt->clearcol[0] = tgt->clearcol[1] = tgt->clearcol[2] = 0.05;
+			tgt->clearcol[3] = 1.0;
+		}
+
+		size_t w = 0, h = 0;
+#ifndef HEADLESS_NOARCAN
+		struct monitor_mode mode = platform_video_dimensions();
+		w = mode.width;
+		h = mode.height;
+#endif
+		if (!w || !h)
+			return NULL;
+
+		if (soft.screen_store.w != w || soft.screen_store.h != h ||
+			!get_tex(soft.screen_store.vinf.text.glid)){
+			soft.screen_store.w = w;
+			soft.screen_store.h = h;
+			soft.screen_store.txmapped = TXSTATE_TEX2D;
+			agp_update_vstore(&soft.screen_store, true);
+		}
+	}
+
+	struct soft_tex* t = get_tex(agp_resolve_texid(tgt->store));
+	if (!t || !t->buf)
+		return NULL;
+
+	*out = t;
+	return tgt;
+}
+
+static void ensure_aux(struct agp_rendertarget* tgt,
+	struct soft_tex* t, bool stencil, bool depth)
+{
+	if (tgt->aux_w != t->w || tgt->aux_h != t->h)
+		drop_aux(tgt);
+
+	tgt->aux_w = t->w;
+	tgt->aux_h = t->h;
+
+	if (stencil && !tgt->stencil)
+		tgt->stencil = arcan_alloc_mem(t->w * t->h,
+			ARCAN_MEM_VBUFFER, ARCAN_MEM_BZERO, ARCAN_MEMALIGN_PAGE);
+
+	if (depth && !tgt->depth){
+		tgt->depth = arcan_alloc_mem(t->w * t->h * sizeof(float),
+			ARCAN_MEM_VBUFFER, 0, ARCAN_MEMALIGN_PAGE);
+		for (size_t i = 0; i < t->w * t->h; i++)
+			tgt->depth[i] = 1.0;
+	}
+}
+
+static inline av_pixel pack_color(float r, float g, float b, float a)
+{
+	return RGBA(
+		(uint8_t)(r * 255.0f + 0.5f), (uint8_t)(g * 255.0f + 0.5f),
+		(uint8_t)(b * 255.0f + 0.5f), (uint8_t)(a * 255.0f + 0.5f)
+	);
+}
+
+size_t agp_rendertarget_dirty(
+	struct agp_rendertarget* dst, struct agp_region* dirty)
+{
+	if (!dst)
+		return 0;
+
+	if (dirty){
+/* missing, track / merge dirty rectangles */
+		dst->dirty_region++;
+	}
+
+	return dst->dirty_region;
+}
+
+void agp_rendertarget_dirty_reset(
+	struct agp_rendertarget* src, struct agp_region* dst)
+{
+	for (size_t i = 0; i < src->dirty_region && dst; i++){
+		dst[i] = (struct agp_region){
+			.x1 = 0, .y1 = 0,
+			.x2 = src->store->w, .y2 = src->store->h
+		};
+	}
+	src->dirty_region = 0;
+}
+
+/* the rasterizer doesn't clip to regions, always draw everything */
+bool agp_rendertarget_clip(struct agp_region* region)
+{
+	return false;
+}
+
+void agp_rendertarget_clear()
+{
+	struct soft_tex* t;
+	struct agp_rendertarget* tgt = active_target(&t);
+	if (!tgt)
+		return;
+
+	av_pixel col = pack_color(tgt->clearcol[0],
+		tgt->clearcol[1], tgt->clearcol[2], tgt->clearcol[3]);
+
+	size_t np = t->w * t->h;
+	for (size_t i = 0; i < np; i++)
+		t->buf[i] = col;
+
+	if (tgt->depth && tgt->aux_w == t->w && tgt->aux_h == t->h)
+		for (size_t i = 0; i < np; i++)
+			tgt->depth[i] = 1.0;
+
+	agp_rendertarget_dirty(soft.rtgt, &(struct agp_region){});
+}
+
+void agp_rendertarget_clearcolor(
+	struct agp_rendertarget* tgt, float r, float g, float b, float a)
+{
+	if (!tgt)
+		return;
+	tgt->clearcol[0] = r;
+	tgt->clearcol[1] = g;
+	tgt->clearcol[2] = b;
+	tgt->clearcol[3] = a;
+}
+
+void agp_resize_rendertarget(
+	struct agp_rendertarget* tgt, size_t neww, size_t newh)
+{
+	if (!tgt || !tgt->store){
+		arcan_warning("attempted resize on broken rendertarget\n");
+		return;
+	}
+
+	if (tgt->store->w == neww && tgt->store->h == newh)
+		return;
+
+	verbose_print(
+		"resize (%"PRIxPTR") to %zu*%zu", (uintptr_t) tgt, neww, newh);
+
+/* there is no external consumer of the swap buffers (no handle passing), so
+ * unlike the GL version we do not need to keep shadow stores around */
+	bool swapping = tgt->n_stores > 0;
+	if (swapping)
+		drop_stores(tgt);
+
+	arcan_mem_free(tgt->store->vinf.text.raw);
+	tgt->store->vinf.text.raw = NULL;
+	tgt->store->vinf.text.s_raw = 0;
+	agp_null_vstore(tgt->store);
+	agp_empty_vstore(tgt->store, neww, newh);
+
+	if (swapping){
+		setup_stores(tgt);
+		tgt->store->vinf.text.glid_proxy = &tgt->stores[0]->vinf.text.glid;
+	}
+
+	drop_aux(tgt);
+}
+
+uint64_t agp_rendertarget_swap(struct agp_rendertarget* dst, bool* swap)
+{
+	if (!dst || !dst->store){
+		*swap = false;
+		return 0;
+	}
+
+	bool first = false;
+	if (!dst->n_stores){
+		verbose_print("(%"PRIxPTR") first swap, alloc buffers", (uintptr_t) dst);
+		setup_stores(dst);
+		first = true;
+	}
+
+	size_t old_front = dst->store_ind;
+	size_t front = dst->store_ind = (dst->store_ind + 1) % MAX_BUFFERS;
+	dst->store->vinf.text.glid_proxy = &dst->stores[front]->vinf.text.glid;
+
+	*swap = !first;
+	FLAG_DIRTY(NULL);
+
+	return first ? 0 : dst->stores[old_front]->vinf.text.glid;
+}
+
+void agp_rendertarget_dropswap(struct agp_rendertarget* tgt)
+{
+	if (!tgt->n_stores)
+		return;
+
+	verbose_print("dropping swap stores");
+	drop_stores(tgt);
+}
+
+void agp_pipeline_hint(enum pipeline_mode mode)
+{
+	if (mode == soft.pipeline)
+		return;
+
+	soft.pipeline = mode;
+
+/* match the GL behavior of clearing depth on entering 3D */
+	if (mode == PIPELINE_3D){
+		struct soft_tex* t;
+		struct agp_rendertarget* tgt = active_target(&t);
+		if (!tgt)
+			return;
+
+		ensure_aux(tgt, t, false, true);
+		for (size_t i = 0; i < t->w * t->h; i++)
+			tgt->depth[i] = 1.0;
+	}
+}
+
+void agp_render_options(struct agp_render_options opts)
+{
+	soft.line_width = opts.line_width;
+}
+
+/*
+ * Stencil, WRITE marks covered pixels without touching the color buffer,
+ * TEST only lets marked pixels through.
+ */
+void agp_prepare_stencil()
+{
+	struct soft_tex* t;
+	struct agp_rendertarget* tgt = active_target(&t);
+	if (!tgt)
+		return;
+
+	ensure_aux(tgt, t, true, false);
+	memset(tgt->stencil, '\0', t->w * t->h);
+	soft.stencil = STENCIL_WRITE;
+}
+
+void agp_activate_stencil()
+{
+	soft.stencil = STENCIL_TEST;
+}
+
+void agp_disable_stencil()
+{
+	soft.stencil = STENCIL_OFF;
+}
+
+void agp_blendstate(enum arcan_blendfunc mode)
+{
+	soft.blend = mode;
+}
+
+/*
+ * Rasterization
+ */
+struct draw_ctx {
+	struct agp_rendertarget* tgt;
+	av_pixel* dst;
+	size_t dw, dh;
+	uint8_t* stencil;
+
+	struct soft_tex* tex;
+	bool bilinear;
+	bool repeat_s, repeat_t;
+
+	av_pixel color;
+	unsigned opa;
+};
+
+static inline unsigned div255(unsigned v)
+{
+	v += 128;
+	return (v + (v >> 8)) >> 8;
+}
+
+static inline av_pixel blend_px(av_pixel s, av_pixel d, unsigned opa, bool retain)
+{
+	unsigned sa = div255((s >> 24) * opa);
+	unsigned ia = 255 - sa;
+	unsigned c0 = div255(((s      ) & 0xff) * sa + ((d      ) & 0xff) * ia);
+	unsigned c1 = div255(((s >>  8) & 0xff) * sa + ((d >>  8) & 0xff) * ia);
+	unsigned c2 = div255(((s >> 16) & 0xff) * sa + ((d >> 16) & 0xff) * ia);
+	unsigned da = d >> 24;
+	unsigned ca = retain ? div255(sa * sa + da * ia) : (sa + da > 255 ? 255 : sa + da);
+	return c0 | (c1 << 8) | (c2 << 16) | (ca << 24);
+}
+
+/*
+ * blend [n] pixels from [src] onto [dst] with the source alpha scaled by [opa],
+ * color channels as (SRC_ALPHA, ONE_MINUS_SRC_ALPHA) and alpha as either
+ * (ONE, ONE) or (SRC_ALPHA, ONE_MINUS_SRC_ALPHA) when [retain] is set.
+ */
+static void blend_span(av_pixel* restrict dst,
+	const av_pixel* restrict src, size_t n, unsigned opa, bool retain)
+{
+	size_t i = 0;
+
+#ifdef __SSE2__
+	const __m128i zero = _mm_setzero_si128();
+	const __m128i c255 = _mm_set1_epi16(255);
+	const __m128i c128 = _mm_set1_epi16(128);
+	const __m128i vopa = _mm_set1_epi32(opa);
+	const __m128i amask = _mm_set1_epi32(0xff000000);
+
+	for (; i + 4 <= n; i += 4){
+		__m128i s = _mm_loadu_si128((const __m128i*) &src[i]);
+		__m128i d = _mm_loadu_si128((__m128i*) &dst[i]);
+
+/* per pixel source alpha scaled by opacity, one value per 32-bit lane */
+		__m128i sa = _mm_mullo_epi16(_mm_srli_epi32(s, 24), vopa);
+		sa = _mm_add_epi16(sa, c128);
+		sa = _mm_srli_epi16(_mm_add_epi16(sa, _mm_srli_epi16(sa, 8)), 8);
+
+/* broadcast into each 16-bit channel lane */
+		__m128i a_lo = _mm_unpacklo_epi32(sa, sa);
+		__m128i a_hi = _mm_unpackhi_epi32(sa, sa);
+		a_lo = _mm_or_si128(a_lo, _mm_slli_epi32(a_lo, 16));
+		a_hi = _mm_or_si128(a_hi, _mm_slli_epi32(a_hi, 16));
+
+		__m128i s_lo = _mm_unpacklo_epi8(s, zero);
+		__m128i s_hi = _mm_unpackhi_epi8(s, zero);
+		__m128i d_lo = _mm_unpacklo_epi8(d, zero);
+		__m128i d_hi = _mm_unpackhi_epi8(d, zero);
+
+		__m128i r_lo = _mm_add_epi16(_mm_mullo_epi16(s_lo, a_lo),
+			_mm_mullo_epi16(d_lo, _mm_sub_epi16(c255, a_lo)));
+		__m128i r_hi = _mm_add_epi16(_mm_mullo_epi16(s_hi, a_hi),
+			_mm_mullo_epi16(d_hi, _mm_sub_epi16(c255, a_hi)));
+
+		r_lo = _mm_add_epi16(r_lo, c128);
+		r_lo = _mm_srli_epi16(_mm_add_epi16(r_lo, _mm_srli_epi16(r_lo, 8)), 8);
+		r_hi = _mm_add_epi16(r_hi, c128);
+		r_hi = _mm_srli_epi16(_mm_add_epi16(r_hi, _mm_srli_epi16(r_hi, 8)), 8);
+
+		__m128i res = _mm_packus_epi16(r_lo, r_hi);
+
+/* alpha is either sa * sa + da * (255 - sa) or the saturated sum of the
+ * scaled source alpha and the destination, same as blend_px */
+		__m128i alpha;
+		if (retain){
+			__m128i da = _mm_srli_epi32(d, 24);
+			alpha = _mm_add_epi16(_mm_mullo_epi16(sa, sa),
+				_mm_mullo_epi16(da, _mm_sub_epi16(c255, sa)));
+			alpha = _mm_add_epi16(alpha, c128);
+			alpha = _mm_srli_epi16(_mm_add_epi16(alpha, _mm_srli_epi16(alpha, 8)), 8);
+			alpha = _mm_slli_epi32(alpha, 24);
+		}
+		else
+			alpha = _mm_adds_epu8(_mm_slli_epi32(sa, 24), _mm_and_si128(d, amask));
+
+		res = _mm_or_si128(
+			_mm_andnot_si128(amask, res), _mm_and_si128(alpha, amask));
+
+		_mm_storeu_si128((__m128i*) &dst[i], res);
+	}
+#endif
+
+	for (; i < n; i++)
+		dst[i] = blend_px(src[i], dst[i], opa, retain);
+}
+
+static void replace_span(av_pixel* restrict dst,
+	const av_pixel* restrict src, size_t n, unsigned opa)
+{
+	if (opa == 255){
+		memcpy(dst, src, n * sizeof(av_pixel));
+		return;
+	}
+
+	for (size_t i = 0; i < n; i++){
+		unsigned sa = div255((src[i] >> 24) * opa);
+		dst[i] = (src[i] & 0x00ffffff) | (sa << 24);
+	}
+}
+
+static void write_span(struct draw_ctx* c, av_pixel* dst, const av_pixel* src, size_t n)
+{
+	if (soft.blend == BLEND_NONE)
+		replace_span(dst, src, n, c->opa);
+	else
+		blend_span(dst, src, n, c->opa, soft.retain_alpha);
+}
+
+/*
+ * Commit [n] shaded pixels at [x, y] honoring the stencil state.
+ */
+static void emit_span(struct draw_ctx* c,
+	size_t x, size_t y, const av_pixel* src, size_t n)
+{
+	size_t ofs = y * c->dw + x;
+
+	switch (soft.stencil){
+	case STENCIL_OFF:
+		write_span(c, &c->dst[ofs], src, n);
+	break;
+
+	case STENCIL_WRITE:
+		if (c->stencil)
+			memset(&c->stencil[ofs], 1, n);
+	break;
+
+	case STENCIL_TEST:
+		if (!c->stencil)
+			return;
+
+		for (size_t i = 0; i < n;){
+			if (!c->stencil[ofs + i]){
+				i++;
+				continue;
+			}
+
+			size_t run = i;
+			while (run < n && c->stencil[ofs + run])
+				run++;
+
+			write_span(c, &c->dst[ofs + i], &src[i], run - i);
+			i = run;
+		}
+	break;
+	}
+}
+
+static inline int wrap_coord(int v, int lim, bool repeat)
+{
+	if (repeat){
+		v %= lim;
+		return v < 0 ? v + lim : v;
+	}
+	return v < 0 ? 0 : (v >= lim ? lim - 1 : v);
+}
+
+static inline av_pixel lerp_px(av_pixel a, av_pixel b, unsigned f)
+{
+	unsigned inv = 256 - f;
+	uint32_t rb = ((((a & 0x00ff00ff) * inv) + ((b & 0x00ff00ff) * f)) >> 8);
+	uint32_t ag = ((((a >> 8) & 0x00ff00ff) * inv) + (((b >> 8) & 0x00ff00ff) * f));
+	return (rb & 0x00ff00ff) | (ag & 0xff00ff00);
+}
+
+static inline av_pixel sample(struct draw_ctx* c, float s, float t)
+{
+	struct soft_tex* tex = c->tex;
+	int tw = tex->w;
+	int th = tex->h;
+
+	if (!c->bilinear){
+		int x = wrap_coord((int) floorf(s * tw), tw, c->repeat_s);
+		int y = wrap_coord((int) floorf(t * th), th, c->repeat_t);
+		return tex->buf[y * tw + x];
+	}
+
+	float fx = s * tw - 0.5f;
+	float fy = t * th - 0.5f;
+	float bx = floorf(fx);
+	float by = floorf(fy);
+	unsigned wx = (unsigned)((fx - bx) * 256.0f);
+	unsigned wy = (unsigned)((fy - by) * 256.0f);
+
+	int x0 = wrap_coord((int) bx, tw, c->repeat_s);
+	int x1 = wrap_coord((int) bx + 1, tw, c->repeat_s);
+	int y0 = wrap_coord((int) by, th, c->repeat_t);
+	int y1 = wrap_coord((int) by + 1, th, c->repeat_t);
+
+	av_pixel top = lerp_px(tex->buf[y0 * tw + x0], tex->buf[y0 * tw + x1], wx);
+	av_pixel bot = lerp_px(tex->buf[y1 * tw + x0], tex->buf[y1 * tw + x1], wx);
+	return lerp_px(top, bot, wy);
+}
+
+static struct shaderv* find_uniform(const char* label)
+{
+	if (!agp_shader_valid(soft.active_prg))
+		return NULL;
+
+	struct shader_cont* cur = &soft.slots[SHADER_INDEX(soft.active_prg)];
+	if (GROUP_INDEX(soft.active_prg) >= cur->ugroups.limit)
+		return NULL;
+
+	struct shaderv* sv = cur->ugroups.cdata[GROUP_INDEX(soft.active_prg)];
+	for (; sv; sv = sv->next)
+		if (strcmp(sv->label, label) == 0)
+			return sv;
+
+	return NULL;
+}
+
+static bool setup_draw(struct draw_ctx* c)
+{
+	struct soft_tex* t;
+	struct agp_rendertarget* tgt = active_target(&t);
+	if (!tgt)
+		return false;
+
+	*c = (struct draw_ctx){
+		.tgt = tgt,
+		.dst = t->buf,
+		.dw = t->w,
+		.dh = t->h
+	};
+
+	if (soft.stencil != STENCIL_OFF){
+		if (!tgt->stencil || tgt->aux_w != t->w || tgt->aux_h != t->h)
+			return soft.stencil == STENCIL_WRITE;
+		c->stencil = tgt->stencil;
+	}
+
+	float opa = soft.context.opacity;
+	opa = opa < 0.0 ? 0.0 : (opa > 1.0 ? 1.0 : opa);
+	c->opa = (unsigned)(opa * 255.0f + 0.5f);
+
+	enum shader_kind kind = agp_shader_valid(soft.active_prg) ?
+		soft.slots[SHADER_INDEX(soft.active_prg)].kind : SHADER_TEXTURED;
+
+	if (kind == SHADER_TEXTURED && soft.store &&
+		soft.store->txmapped == TXSTATE_TEX2D){
+		c->tex = get_tex(agp_resolve_texid(soft.store));
+		if (c->tex && !c->tex->buf)
+			c->tex = NULL;
+
+		int filter = soft.store->filtermode & (~ARCAN_VFILTER_MIPMAP);
+		c->bilinear = filter != ARCAN_VFILTER_NONE;
+		c->repeat_s = soft.store->txu == ARCAN_VTEX_REPEAT;
+		c->repeat_t = soft.store->txv == ARCAN_VTEX_REPEAT;
+	}
+
+/* untextured, or the texture is missing, fallback to the color uniform */
+	if (!c->tex){
+		float col[3] = {0};
+		struct shaderv* sv = find_uniform("obj_col");
+		if (sv && sv->type == shdrvec3)
+			memcpy(col, sv->data, sizeof(float) * 3);
+		c->color = pack_color(col[0], col[1], col[2], 1.0);
+	}
+
+	return true;
+}
+
+/*
+ * Fill [n] pixels of [out] with samples along a line in texture space
+ */
+static void gather_span(struct draw_ctx* c,
+	av_pixel* out, size_t n, float s, float t, float ds, float dt)
+{
+	if (!c->tex){
+		for (size_t i = 0; i < n; i++)
+			out[i] = c->color;
+		return;
+	}
+
+	for (size_t i = 0; i < n; i++, s += ds, t += dt)
+		out[i] = sample(c, s, t);
+}
+
+/*
+ * Fast path for quads that remain axis aligned after transformation, this
+ * covers everything that is not rotated. [win] are the four corners in
+ * window space (same order as agp_draw_vobj), [tc] the texture coordinates.
+ */
+static void draw_quad_aligned(struct draw_ctx* c, float win[4][2], const float* tc)
+{
+	float X0 = win[0][0], X1 = win[1][0];
+	float Y0 = win[0][1], Y3 = win[3][1];
+
+	if (fabsf(X1 - X0) < EPSILON || fabsf(Y3 - Y0) < EPSILON)
+		return;
+
+	float minx = X0 < X1 ? X0 : X1, maxx = X0 < X1 ? X1 : X0;
+	float miny = Y0 < Y3 ? Y0 : Y3, maxy = Y0 < Y3 ? Y3 : Y0;
+
+	ssize_t px1 = (ssize_t) ceilf(minx - 0.5f);
+	ssize_t px2 = (ssize_t) ceilf(maxx - 0.5f);
+	ssize_t py1 = (ssize_t) ceilf(miny - 0.5f);
+	ssize_t py2 = (ssize_t) ceilf(maxy - 0.5f);
+
+	if (px1 < 0) px1 = 0;
+	if (py1 < 0) py1 = 0;
+	if (px2 > (ssize_t) c->dw) px2 = c->dw;
+	if (py2 > (ssize_t) c->dh) py2 = c->dh;
+	if (px1 >= px2 || py1 >= py2)
+		return;
+
+	float dx = 1.0f / (X1 - X0);
+	float u0 = ((float) px1 + 0.5f - X0) * dx;
+	av_pixel buf[SPAN_CHUNK];
+
+	for (ssize_t y = py1; y < py2; y++){
+		float v = ((float) y + 0.5f - Y0) / (Y3 - Y0);
+
+/* left and right edges in texture space, tc is v0, v1, v2, v3 */
+		float ls = tc[0] + (tc[6] - tc[0]) * v;
+		float lt = tc[1] + (tc[7] - tc[1]) * v;
+		float rs = tc[2] + (tc[4] - tc[2]) * v;
+		float rt = tc[3] + (tc[5] - tc[3]) * v;
+
+		float ds = (rs - ls) * dx;
+		float dt = (rt - lt) * dx;
+		float s = ls + (rs - ls) * u0;
+		float t = lt + (rt - lt) * u0;
+		size_t n = px2 - px1;
+
+/* 1:1 mapping, blend directly from the texture row */
+		if (c->tex && fabsf(dt) < 1e-7f && fabsf(ds * c->tex->w - 1.0f) < 1e-4f){
+			float fx = s * c->tex->w - 0.5f;
+			float fy = t * c->tex->h - 0.5f;
+			ssize_t sx = (ssize_t) floorf(fx + 0.5f);
+			ssize_t sy = (ssize_t) floorf(fy + 0.5f);
+
+			if (fabsf(fx - sx) < 1e-3f && fabsf(fy - sy) < 1e-3f &&
+				sx >= 0 && sy >= 0 && sy < (ssize_t) c->tex->h &&
+				sx + n <= c->tex->w){
+				emit_span(c, px1, y, &c->tex->buf[sy * c->tex->w + sx], n);
+				continue;
+			}
+		}
+
+		for (size_t x = px1; x < px2;){
+			size_t step = px2 - x > SPAN_CHUNK ? SPAN_CHUNK : px2 - x;
+			gather_span(c, buf, step, s, t, ds, dt);
+			emit_span(c, x, y, buf, step);
+			s += ds * step;
+			t += dt * step;
+			x += step;
+		}
+	}
+}
+
+struct svert {
+	float x, y, z;
+	float w;
+	float s, t;
+};
+
+static inline float edge_fn(
+	const struct svert* a, const struct svert* b, float x, float y)
+{
+	return (b->x - a->x) * (y - a->y) - (b->y - a->y) * (x - a->x);
+}
+
+static inline bool depth_pass(enum agp_depth_func fn, float z, float ref)
+{
+	switch (fn){
+	case AGP_DEPTH_LESS: return z < ref;
+	case AGP_DEPTH_LESSEQUAL: return z <= ref;
+	case AGP_DEPTH_GREATER: return z > ref;
+	case AGP_DEPTH_GREATEREQUAL: return z >= ref;
+	case AGP_DEPTH_EQUAL: return z == ref;
+	case AGP_DEPTH_NOTEQUAL: return z != ref;
+	case AGP_DEPTH_ALWAYS: return true;
+	case AGP_DETPH_NEVER: return false;
+	default:
+		return z < ref;
+	}
+}
+
+/*
+ * Generic triangle rasterizer, vertices are in window space with [w] as 1/w
+ * and [s, t] premultiplied by it for perspective correct interpolation.
+ * [depth] is NULL if depth testing should be disabled.
+ */
+static void raster_tri(struct draw_ctx* c,
+	struct svert* v0, struct svert* v1, struct svert* v2,
+	float* depth, enum agp_depth_func fn)
+{
+	float area = edge_fn(v0, v1, v2->x, v2->y);
+	if (fabsf(area) < EPSILON)
+		return;
+
+/* normalize winding so that the edge functions are positive inside */
+	if (area < 0){
+		struct svert* tmp = v1;
+		v1 = v2;
+		v2 = tmp;
+		area = -area;
+	}
+
+	float minx = fminf(v0->x, fminf(v1->x, v2->x));
+	float maxx = fmaxf(v0->x, fmaxf(v1->x, v2->x));
+	float miny = fminf(v0->y, fminf(v1->y, v2->y));
+	float maxy = fmaxf(v0->y, fmaxf(v1->y, v2->y));
+
+	ssize_t px1 = (ssize_t) floorf(minx);
+	ssize_t px2 = (ssize_t) ceilf(maxx);
+	ssize_t py1 = (ssize_t) floorf(miny);
+	ssize_t py2 = (ssize_t) ceilf(maxy);
+
+	if (px1 < 0) px1 = 0;
+	if (py1 < 0) py1 = 0;
+	if (px2 > (ssize_t) c->dw) px2 = c->dw;
+	if (py2 > (ssize_t) c->dh) py2 = c->dh;
+
+	float inv_area = 1.0f / area;
+
+	for (ssize_t y = py1; y < py2; y++){
+		float cy = (float) y + 0.5f;
+
+		for (ssize_t x = px1; x < px2; x++){
+			float cx = (float) x + 0.5f;
+			float l0 = edge_fn(v1, v2, cx, cy);
+			float l1 = edge_fn(v2, v0, cx, cy);
+			float l2 = edge_fn(v0, v1, cx, cy);
+
+			if (l0 < 0 || l1 < 0 || l2 < 0)
+				continue;
+
+			l0 *= inv_area;
+			l1 *= inv_area;
+			l2 *= inv_area;
+
+			if (depth){
+				float z = l0 * v0->z + l1 * v1->z + l2 * v2->z;
+				size_t ofs = y * c->dw + x;
+				if (!depth_pass(fn, z, depth[ofs]))
+					continue;
+				if (soft.stencil != STENCIL_WRITE)
+					depth[ofs] = z;
+			}
+
+			av_pixel px = c->color;
+			if (c->tex){
+				float w = l0 * v0->w + l1 * v1->w + l2 * v2->w;
+				float s = (l0 * v0->s + l1 * v1->s + l2 * v2->s) / w;
+				float t = (l0 * v0->t + l1 * v1->t + l2 * v2->t) / w;
+				px = sample(c, s, t);
+			}
+
+			emit_span(c, x, y, &px, 1);
+		}
+	}
+}
+
+/*
+ * object space to window space, [out.w] is set to 1/w, false if the
+ * vertex is behind the projection plane.
+ */
+static bool project(const float* mv, const float* proj,
+	struct draw_ctx* c, float x, float y, float z, struct svert* out)
+{
+	float e[4], p[4];
+	for (size_t i = 0; i < 4; i++)
+		e[i] = mv[i] * x + mv[4+i] * y + mv[8+i] * z + mv[12+i];
+
+	for (size_t i = 0; i < 4; i++)
+		p[i] = proj[i] * e[0] + proj[4+i] * e[1] + proj[8+i] * e[2] + proj[12+i] * e[3];
+
+	if (p[3] <= EPSILON)
+		return false;
+
+	float iw = 1.0f / p[3];
+	out->x = (p[0] * iw + 1.0f) * 0.5f * (float) c->dw;
+	out->y = (p[1] * iw + 1.0f) * 0.5f * (float) c->dh;
+	out->z = (p[2] * iw + 1.0f) * 0.5f;
+	out->w = iw;
+
+	return true;
+}
+
+/* project and rasterize one quad, [ov] corners in agp_draw_vobj order */
+static void draw_quad(struct draw_ctx* c, float ov[4][2], const float* txcos)
+{
+	struct svert sv[4];
+
+	for (size_t i = 0; i < 4; i++){
+		if (!project(soft.context.modelview,
+			soft.context.projection, c, ov[i][0], ov[i][1], 0, &sv[i]))
+			return;
+		sv[i].s = txcos[i * 2 + 0] * sv[i].w;
+		sv[i].t = txcos[i * 2 + 1] * sv[i].w;
+	}
+
+	bool affine =
+		fabsf(sv[0].w - 1.0f) < EPSILON && fabsf(sv[1].w - 1.0f) < EPSILON &&
+		fabsf(sv[2].w - 1.0f) < EPSILON && fabsf(sv[3].w - 1.0f) < EPSILON;
+
+	if (affine &&
+		fabsf(sv[0].y - sv[1].y) < EPSILON && fabsf(sv[1].x - sv[2].x) < EPSILON &&
+		fabsf(sv[2].y - sv[3].y) < EPSILON && fabsf(sv[3].x - sv[0].x) < EPSILON){
+		float win[4][2];
+		for (size_t i = 0; i < 4; i++){
+			win[i][0] = sv[i].x;
+			win[i][1] = sv[i].y;
+		}
+		draw_quad_aligned(c, win, txcos);
+	}
+	else {
+		raster_tri(c, &sv[0], &sv[1], &sv[2], NULL, AGP_DEPTH_ALWAYS);
+		raster_tri(c, &sv[0], &sv[2], &sv[3], NULL, AGP_DEPTH_ALWAYS);
+	}
+}
+
+void agp_draw_vobj(
+	float x1, float y1, float x2, float y2,
+	const float* txcos, const float* model)
+{
+	static const float deftc[] = {0, 0, 1, 0, 1, 1, 0, 1};
+	struct draw_ctx c;
+
+	verbose_print("draw-vobj(%f,%f-%f,%f)", x1, y1, x2, y2);
+
+	agp_shader_envv(MODELVIEW_MATR,
+		model ? (void*) model : ident, sizeof(float) * 16);
+
+	if (!setup_draw(&c))
+		return;
+
+	if (!txcos)
+		txcos = deftc;
+
+	float ov[4][2] = {{x1, y1}, {x2, y1}, {x2, y2}, {x1, y2}};
+	draw_quad(&c, ov, txcos);
+
+	agp_rendertarget_dirty(soft.rtgt, &(struct agp_region){});
+}
+
+/*
+ * there is no per-call overhead worth amortizing here, so just unpack the
+ * triangle pairs back into quads to keep the axis-aligned fast path
+ */
+void agp_draw_vobj_batch(const float* verts, const float* txcos, size_t n)
+{
+	struct draw_ctx c;
+	verbose_print("draw-vobj-batch(%zu)", n);
+
+	agp_shader_envv(MODELVIEW_MATR, ident, sizeof(float) * 16);
+
+	if (!n || !setup_draw(&c))
+		return;
+
+	static const size_t corner[] = {0, 1, 2, 5};
+	for (size_t i = 0; i < n; i++, verts += 12, txcos += 12){
+		float ov[4][2];
+		float tc[8];
+		for (size_t j = 0; j < 4; j++){
+			ov[j][0] = verts[corner[j] * 2 + 0];
+			ov[j][1] = verts[corner[j] * 2 + 1];
+			tc[j * 2 + 0] = txcos[corner[j] * 2 + 0];
+			tc[j * 2 + 1] = txcos[corner[j] * 2 + 1];
+		}
+		draw_quad(&c, ov, tc);
+	}
+
+	agp_rendertarget_dirty(soft.rtgt, &(struct agp_region){});
+}
+
+static void mesh_vertex(struct agp_mesh_store* base,
+	struct draw_ctx* c, size_t ind, struct svert* out, bool* ok)
+{
+	if (ind >= base->n_vertices){
+		*ok = false;
+		return;
+	}
+
+	float* v = &base->verts[ind * base->vertex_size];
+	float z = base->vertex_size > 2 ? v[2] : 0.0;
+
+	if (!project(soft.context.modelview,
+		soft.context.projection, c, v[0], v[1], z, out)){
+		*ok = false;
+		return;
+	}
+
+	if (base->txcos){
+		out->s = base->txcos[ind * 2 + 0] * out->w;
+		out->t = base->txcos[ind * 2 + 1] * out->w;
+	}
+	else
+		out->s = out->t = 0;
+}
+
+static void raster_line(struct draw_ctx* c, struct svert* a, struct svert* b)
+{
+	float dx = b->x - a->x;
+	float dy = b->y - a->y;
+	size_t steps = (size_t) ceilf(fmaxf(fabsf(dx), fabsf(dy)));
+	if (!steps)
+		steps = 1;
+
+	for (size_t i = 0; i <= steps; i++){
+		float f = (float) i / (float) steps;
+		ssize_t x = (ssize_t) (a->x + dx * f);
+		ssize_t y = (ssize_t) (a->y + dy * f);
+		if (x < 0 || y < 0 || x >= (ssize_t) c->dw || y >= (ssize_t) c->dh)
+			continue;
+
+		av_pixel px = c->color;
+		if (c->tex){
+			float w = a->w + (b->w - a->w) * f;
+			px = sample(c,
+				(a->s + (b->s - a->s) * f) / w, (a->t + (b->t - a->t) * f) / w);
+		}
+		emit_span(c, x, y, &px, 1);
+	}
+}
+
+void agp_submit_mesh(struct agp_mesh_store* base, enum agp_mesh_flags fl)
+{
+	struct draw_ctx c;
+	if (base->dirty)
+		base->dirty = false;
+
+	if (!base->verts || !base->n_vertices || !setup_draw(&c))
+		return;
+
+	float* depth = NULL;
+	if (soft.pipeline == PIPELINE_3D &&
+		!(fl & MESH_FACING_NODEPTH) && !base->nodepth){
+		ensure_aux(c.tgt, &(struct soft_tex){.w = c.dw, .h = c.dh}, false, true);
+		depth = c.tgt->depth;
+	}
+
+	if (base->type == AGP_MESH_POINTCLOUD){
+		for (size_t i = 0; i < base->n_vertices; i++){
+			struct svert v;
+			bool ok = true;
+			mesh_vertex(base, &c, i, &v, &ok);
+			if (!ok || v.x < 0 || v.y < 0 || v.x >= c.dw || v.y >= c.dh)
+				continue;
+
+			av_pixel px = c.color;
+			if (c.tex)
+				px = sample(&c, v.s / v.w, v.t / v.w);
+			emit_span(&c, (size_t) v.x, (size_t) v.y, &px, 1);
+		}
+		agp_rendertarget_dirty(soft.rtgt, &(struct agp_region){});
+		return;
+	}
+
+	if (base->indices && !base->validated){
+		for (size_t i = 0; i < base->n_indices; i++){
+			if (base->indices[i] > base->n_vertices){
+				static bool warned;
+				if (!warned){
+					arcan_warning("agp_submit_mesh(), " "refusing mesh with OOB indices "
+						"(%zu=>%zu/%zu\n", i, base->indices[i], base->n_vertices);
+					warned = true;
+				}
+				return;
+			}
+		}
+		base->validated = true;
+	}
+
+	size_t n = base->indices ? base->n_indices : base->n_vertices;
+	bool cull_back = (fl & MESH_FACING_BOTH) && !(fl & MESH_FACING_BACK);
+	bool cull_front = (fl & MESH_FACING_BOTH) && !(fl & MESH_FACING_FRONT);
+
+	for (size_t i = 0; i + 2 < n; i += 3){
+		struct svert v[3];
+		bool ok = true;
+
+		for (size_t j = 0; j < 3; j++)
+			mesh_vertex(base, &c,
+				base->indices ? base->indices[i+j] : i+j, &v[j], &ok);
+
+/* no near plane clipping, just drop triangles that cross the camera */
+		if (!ok)
+			continue;
+
+/* front face is clockwise, matching agp_init in glshared */
+		float area = edge_fn(&v[0], &v[1], v[2].x, v[2].y);
+		if ((area < 0 && cull_front) || (area > 0 && cull_back))
+			continue;
+
+		if (fl & MESH_FILL_LINE){
+			raster_line(&c, &v[0], &v[1]);
+			raster_line(&c, &v[1], &v[2]);
+			raster_line(&c, &v[2], &v[0]);
+		}
+		else
+			raster_tri(&c, &v[0], &v[1], &v[2], depth, base->depth_func);
+	}
+
+	agp_rendertarget_dirty(soft.rtgt, &(struct agp_region){});
+}
+
+void agp_invalidate_mesh(struct agp_mesh_store* bs)
+{
+}
+
+void agp_drop_mesh(struct agp_mesh_store* s)
+{
+	if (!s)
+		return;
+
+	uintptr_t targets[] = {
+		(uintptr_t) s->verts, (uintptr_t) s->txcos,
+		(uintptr_t) s->txcos2, (uintptr_t) s->normals,
+		(uintptr_t) s->colors, (uintptr_t) s->tangents,
+		(uintptr_t) s->bitangents, (uintptr_t) s->weights,
+		(uintptr_t) s->joints, (uintptr_t) s->indices
+	};
+
+	if (s->shared_buffer != NULL){
+		arcan_mem_free(s->shared_buffer);
+		uintptr_t base = (uintptr_t) s->shared_buffer;
+		uintptr_t end = base + s->shared_buffer_sz;
+
+		for (size_t i = 0; i < COUNT_OF(targets); i++){
+			if (targets[i] != (uintptr_t) NULL &&
+				(targets[i] < base || targets[i] >= end)){
+				arcan_mem_free((void*)targets[i]);
+			}
+		}
+	}
+	else{
+		for (size_t i = 0; i < COUNT_OF(targets); i++){
+			if (targets[i] != (uintptr_t) NULL){
+				arcan_mem_free((void*)targets[i]);
+			}
+		}
+	}
+
+	memset(s, '\0', sizeof(struct agp_mesh_store));
+}
+
+void agp_save_output(size_t w, size_t h, av_pixel* dst, size_t dsz)
+{
+	assert(w * h * sizeof(av_pixel) == dsz);
+	memset(dst, '\0', dsz);
+
+	struct soft_tex* t = get_tex(soft.screen_store.vinf.text.glid);
+	if (!t || !t->buf)
+		return;
+
+	size_t rw = w < t->w ? w : t->w;
+	size_t rh = h < t->h ? h : t->h;
+	for (size_t y = 0; y < rh; y++)
+		memcpy(&dst[y * w], &t->buf[y * t->w], rw * sizeof(av_pixel));
+}
+
+/*
+ * Shader management, this mimics shdrmgmt.c closely minus the programs
+ */
+static void free_groups(struct shader_cont* cur)
+{
+	for (size_t i = 0; i < cur->ugroups.limit; i++){
+		struct shaderv* first = cur->ugroups.cdata[i];
+		while (first){
+			struct shaderv* last = first;
+			free(first->label);
+			first = first->next;
+			arcan_mem_free(last);
+		}
+	}
+
+	arcan_mem_free(cur->ugroups.data);
+	cur->ugroups = (struct arcan_strarr){};
+}
+
+static void destroy_shader(struct shader_cont* cur)
+{
+	if (!cur->label)
+		return;
+
+	free(cur->label);
+	free(cur->vertex);
+	free(cur->fragment);
+	free_groups(cur);
+	memset(cur, 0, sizeof(struct shader_cont));
+}
+
+bool agp_shader_valid(agp_shader_id id)
+{
+	return (id != BROKEN_SHADER && SHADER_INDEX(id) <
+		sizeof(soft.slots) / sizeof(soft.slots[0]) &&
+		soft.slots[SHADER_INDEX(id)].label != NULL
+	);
+}
+
+bool agp_shader_destroy(agp_shader_id shid)
+{
+	if (!agp_shader_valid(shid) ||
+		shid == agp_default_shader(BASIC_2D) ||
+		shid == agp_default_shader(BASIC_3D) ||
+		shid == agp_default_shader(COLOR_2D))
+		return false;
+
+	struct shader_cont* cur = &soft.slots[SHADER_INDEX(shid)];
+
+	if (GROUP_INDEX(shid) == 0){
+		destroy_shader(cur);
+		return true;
+	}
+
+	uint16_t ind = GROUP_INDEX(shid);
+	if (ind >= cur->ugroups.limit || !cur->ugroups.cdata[ind])
+		return false;
+
+	cur->ugroups.count--;
+	struct shaderv* sv = cur->ugroups.cdata[ind];
+	while(sv){
+		struct shaderv* last = sv;
+		free(sv->label);
+		sv = sv->next;
+		arcan_mem_free(last);
+	}
+	cur->ugroups.cdata[ind] = NULL;
+	return true;
+}
+
+int agp_shader_activate(agp_shader_id shid)
+{
+	if (!agp_shader_valid(shid))
+		return ARCAN_ERRC_NO_SUCH_OBJECT;
+
+	struct shader_cont* cur = &soft.slots[SHADER_INDEX(shid)];
+	if (cur->ugroups.limit < GROUP_INDEX(shid)){
+		arcan_warning("attempt to activate shader(%d)(%d) failed: "
+			"broken group\n", (int)SHADER_INDEX(shid),(int)GROUP_INDEX(shid));
+		return -1;
+	}
+
+	soft.active_prg = shid;
+	return ARCAN_OK;
+}
+
+agp_shader_id agp_shader_lookup(const char* tag)
+{
+	for (size_t i = 0; i < sizeof(soft.slots) / sizeof(soft.slots[0]); i++){
+		if (soft.slots[i].label && strcmp(tag, soft.slots[i].label) == 0)
+			return i;
+	}
+
+	return BROKEN_SHADER;
+}
+
+const char* agp_shader_lookuptag(agp_shader_id id)
+{
+	if (!agp_shader_valid(id))
+		return NULL;
+
+	return soft.slots[SHADER_INDEX(id)].label;
+}
+
+bool agp_shader_lookupprgs(agp_shader_id id,
+	const char** vert, const char** frag)
+{
+	if (!agp_shader_valid(id))
+		return false;
+
+	if (vert)
+		*vert = soft.slots[SHADER_INDEX(id)].vertex;
+
+	if (frag)
+		*frag = soft.slots[SHADER_INDEX(id)].fragment;
+
+	return true;
+}
+
+agp_shader_id agp_shader_build(const char* tag,
+	const char* geom, const char* vert, const char* frag)
+{
+	int slot_lim = sizeof(soft.slots) / sizeof(soft.slots[0]);
+	int dstind = -1;
+
+	if (!tag)
+		return BROKEN_SHADER;
+
+	if (!vert)
+		vert = defvprg;
+
+	if (!frag)
+		frag = deffprg;
+
+	for (size_t i = 0; i < slot_lim; i++)
+		if (soft.slots[i].label && strcmp(soft.slots[i].label, tag) == 0){
+			dstind = i;
+			destroy_shader(&soft.slots[i]);
+			break;
+		}
+
+	if (dstind == -1){
+		soft.ofs = (soft.ofs + 1) % slot_lim;
+		if (!soft.slots[soft.ofs].label)
+			dstind = soft.ofs;
+		else
+			for (size_t i = 0; i < slot_lim; i++)
+				if (!soft.slots[i].label){
+					dstind = i;
+					break;
+				}
+	}
+
+	if (dstind == -1)
+		return BROKEN_SHADER;
+
+	struct shader_cont* cur = &soft.slots[dstind];
+	cur->label = strdup(tag);
+	cur->vertex = strdup(vert);
+	cur->fragment = strdup(frag);
+
+/* programs that only output the color uniform are treated as COLOR_2D,
+ * everything else samples the active vstore */
+	cur->kind = (strstr(frag, "obj_col") && !strstr(frag, "texture")) ?
+		SHADER_COLOR : SHADER_TEXTURED;
+
+	agp_shader_addgroup(dstind);
+	return (uint32_t) dstind;
+}
+
+int agp_shader_envv(enum agp_shader_envts slot, void* value, size_t size)
+{
+	memcpy((char*) (&soft.context) + ofstbl[slot], value, size);
+
+/* nothing consumes the values through a program, so there is never any
+ * reason to consider changes here as a source of dirtiness */
+	return 0;
+}
+
+const char* agp_shader_symtype(enum agp_shader_envts env)
+{
+	return symtbl[env];
+}
+
+static int find_hole(struct shader_cont* shdr)
+{
+	for (size_t i = 0; i < shdr->ugroups.limit; i++)
+		if (!shdr->ugroups.cdata[i])
+			return i;
+	return -1;
+}
+
+agp_shader_id agp_shader_addgroup(agp_shader_id shid)
+{
+	if (!agp_shader_valid(shid))
+		return BROKEN_SHADER;
+
+	struct shader_cont* cur = &soft.slots[SHADER_INDEX(shid)];
+
+	if (cur->ugroups.count >= 65535)
+		return BROKEN_SHADER;
+
+	if (cur->ugroups.limit - cur->ugroups.count == 0)
+		arcan_mem_growarr(&cur->ugroups);
+
+	int dsti = -1;
+	if (!cur->ugroups.cdata[cur->ugroups.count])
+		dsti = cur->ugroups.count;
+	else
+		dsti = find_hole(cur);
+
+	if (-1 == dsti)
+		return BROKEN_SHADER;
+
+	cur->ugroups.count++;
+
+	struct shaderv** chain = (struct shaderv**) &cur->ugroups.cdata[dsti];
+	struct shaderv* mgroup = cur->ugroups.cdata[GROUP_INDEX(shid)];
+
+	while(mgroup && mgroup != *chain){
+		*chain = arcan_alloc_mem(sizeof(struct shaderv),
+			ARCAN_MEM_VSTRUCT, ARCAN_MEM_BZERO, ARCAN_MEMALIGN_NATURAL);
+		memcpy(*chain, mgroup, sizeof(struct shaderv));
+		(*chain)->label = strdup(mgroup->label);
+		(*chain)->next = NULL;
+		chain = &((*chain)->next);
+		mgroup = mgroup->next;
+	}
+
+	return SHADER_ID(SHADER_INDEX(shid), dsti);
+}
+
+int agp_shader_vattribute_loc(enum shader_vertex_attributes attr)
+{
+	return attr;
+}
+
+void agp_shader_forceunif(const char* label, enum shdrutype type, void* value)
+{
+	assert(soft.active_prg != BROKEN_SHADER);
+	struct shader_cont* slot = &soft.slots[SHADER_INDEX(soft.active_prg)];
+	FLAG_DIRTY(NULL);
+
+	struct shaderv** current = (struct shaderv**) &(
+		slot->ugroups.cdata[GROUP_INDEX(soft.active_prg)]);
+	for (; *current; current = &(*current)->next)
+		if (strcmp((*current)->label, label) == 0)
+			break;
+
+	if (*current){
+		if ((*current)->type != type){
+			arcan_warning("agp_shader_forceunif(), type mismatch for "
+				"persistant shader uniform (%s=>%i), ignored.\n", label, type);
+			return;
+		}
+	}
+	else {
+		*current = arcan_alloc_mem(sizeof(struct shaderv),
+			ARCAN_MEM_VSTRUCT, ARCAN_MEM_BZERO, ARCAN_MEMALIGN_NATURAL);
+		(*current)->label = strdup(label);
+		(*current)->type  = type;
+		(*current)->next  = NULL;
+	}
+	memcpy((*current)->data, value, sizetbl[type]);
+}
+
+void agp_shader_flush()
+{
+	for (size_t i = 0; i < sizeof(soft.slots) / sizeof(soft.slots[0]); i++)
+		destroy_shader(&soft.slots[i]);
+
+	soft.ofs = 0;
+	soft.active_prg = BROKEN_SHADER;
+}
+
+void agp_shader_unload_all()
+{
+}
+
+void agp_shader_rebuild_all()
+{
+}
@@ -120,6 +120,11 @@ void agp_rendertarget_clear()
 {
 }
 
+bool agp_rendertarget_clip(struct agp_region* region)
+{
+	return false;
+}
+
 void agp_pipeline_hint(enum pipeline_mode mode)
 {
 }
@@ -139,7 +144,7 @@ void agp_activate_vstore_multi(struct agp_vstore** backing, size_t n)
 
 void agp_update_vstore(struct agp_vstore* s, bool copy)
 {
-	FLAG_DIRTY();
+	FLAG_DIRTY(NULL);
 }
 
 void agp_prepare_stencil()
@@ -163,6 +168,10 @@ void agp_draw_vobj(float x1, float y1,
 {
 }
 
+void agp_draw_vobj_batch(const float* verts, const float* txcos, size_t n)
+{
+}
+
 void agp_submit_mesh(struct agp_mesh_store* base, enum agp_mesh_flags fl)
 {
 }
@@ -174,7 +174,8 @@ enum stream_type {
 	STREAM_RAW_DIRECT_COPY,
 	STREAM_RAW_DIRECT_SYNCHRONOUS,
 	STREAM_EXT_RESYNCH,
-	STREAM_HANDLE
+	STREAM_HANDLE,
+	STREAM_RAW_DIRECT_MAPPED
 };
 
 struct stream_meta {
@@ -211,6 +212,15 @@ struct stream_meta {
  *                pro: possibly the fastest, covers more formats
  *                con: .raw is not in synch, reliability/availability issues
  *
+ *  - RAW_DIRECT_MAPPED: meta.buf is set to a mapping of the upload store
+ *                (PBO or the like) that fits w*h av_pixels. It can be
+ *                populated from any thread, but agp_stream_commit has to be
+ *                called on the render thread before the store is used again.
+ *                pro: the copy can be moved off the render thread,
+ *                con: no subregion or .raw synch, state is false if the
+ *                platform can't map (fallback to RAW_DIRECT).
+ *                A commit with .state set to false only releases the mapping.
+ *
  * Typical use:
  *  create a [struct stream_meta] with possble subregion or handle.
  *
@@ -305,6 +315,14 @@ void agp_blendstate(enum arcan_blendfunc);
 void agp_draw_vobj(float x1, float y1, float x2, float y2,
 	const float* txcos, const float* modelview);
 
+/*
+ * Draw [n] quads with the currently active vstore, shader and blend state
+ * using the identity modelview. [verts] holds two triangles (12 floats) per
+ * quad, corners in the order of agp_draw_vobj expanded as (0, 1, 2), (0, 2, 3)
+ * and already transformed, [txcos] uses the same layout.
+ */
+void agp_draw_vobj_batch(const float* verts, const float* txcos, size_t n);
+
 /*
  * Destination format for rendertargets. Note that we do not currently suport
  * floating point targets and that for some platforms, COLOR_DEPTH will map to
@@ -387,9 +405,12 @@ void agp_rendertarget_dropswap(struct agp_rendertarget*);
 void agp_drop_rendertarget(struct agp_rendertarget*);
 
 /*
- * manually mark part of rendertarget as dirty, returns number of invalidations
+ * manually mark part of rendertarget as dirty, returns number of dirty regions
  * so far. if [dirty] is set to NULL, no changes will be marked, but counter
- * will still be returned.
+ * will still be returned. An empty region marks everything that could be
+ * drawn to, i.e. the clip region (see agp_rendertarget_clip) or the entire
+ * rendertarget. Regions are in rendertarget pixels with the origin in the
+ * lower left corner, same as the viewport.
  */
 struct agp_region {
 	size_t x1, y1, x2, y2;
@@ -405,6 +426,15 @@ size_t agp_rendertarget_dirty(
 void agp_rendertarget_dirty_reset(
 	struct agp_rendertarget* src, struct agp_region* dst);
 
+/*
+ * Restrict clearing and drawing on the active rendertarget to [region], or
+ * reset to the full rendertarget if NULL. Returns false if the contents of
+ * the rendertarget can't be assumed to be retained from the last reset
+ * (multi-buffered, proxied to the display, resized, ...), the caller should
+ * then draw everything instead.
+ */
+bool agp_rendertarget_clip(struct agp_region* region);
+
 /*
  * reset the currently bound rendertarget output buffer
  */
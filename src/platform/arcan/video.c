@@ -1158,6 +1158,13 @@ void platform_event_process(arcan_evctx* ctx)
 		event_process_disp(ctx, &disp[i]);
 }
 
+/* events arrive over the shmif connection to the parent which is already
+ * part of the synch logic here */
+ssize_t platform_event_pollset(int* dst, size_t lim)
+{
+	return -1;
+}
+
 void platform_event_rescan_idev(arcan_evctx* ctx)
 {
 }
@@ -3411,20 +3411,26 @@ static void page_flip_handler(int fd, unsigned int frame,
 
 	float deadline = 1000.0f / (float)(d->vrefresh ? d->vrefresh : 60.0);
 	arcan_conductor_deadline(deadline);
+	arcan_conductor_display_pending(d->device->card_id, d->id, false);
 }
 
-static bool get_pending(bool primary_only)
+static size_t count_pending(bool primary_only)
 {
 	int i = 0;
-	int pending = 0;
+	size_t pending = 0;
 	struct dispout* d;
 
 	while((d = get_display(i++))){
-		if (!primary_only || d->display.primary)
-			pending |= d->buffer.in_flip;
+		if ((!primary_only || d->display.primary) && d->buffer.in_flip)
+			pending++;
 	}
 
-	return pending > 0;
+	return pending;
+}
+
+static bool get_pending(bool primary_only)
+{
+	return count_pending(primary_only) > 0;
 }
 
 /*
@@ -3434,13 +3440,18 @@ static bool get_pending(bool primary_only)
  *
  * Timeout is typically used for shutdown / cleanup operations where
  * normal background processing need to be ignored anyhow.
+ *
+ * With [first] set, return as soon as any one of the pending displays has
+ * flipped rather than waiting for all of them, the conductor tracks the
+ * per-display state and the others will be picked up on the next pass.
  */
-static void flush_display_events(int timeout, bool yield)
+static void flush_display_events(int timeout, bool yield, bool first)
 {
 	struct dispout* d;
 	verbose_print("flush display events, timeout: %d", timeout);
 
 	unsigned long long start = arcan_timemillis();
+	size_t in_flight = count_pending(true);
 
 	int period = 4;
 	if (timeout > 0){
@@ -3490,7 +3501,10 @@ static void flush_display_events(int timeout, bool yield)
  * With VFR changes, we should start passing the responsibility for dealing with
  * synch period and timeout here before proceeding with the next pass / cycle.
  */
-			int yv = arcan_conductor_yield(NULL, 0);
+/* The conductor sleeps on the card descriptor together with clients and
+ * input, and returns as soon as there is something for us to check */
+			int yv = arcan_conductor_yield(&(struct conductor_display){
+				.fd = nodes[0].fd, .refresh = -1}, 1);
 			if (-1 == yv)
 				break;
 			else
@@ -3499,6 +3513,7 @@ static void flush_display_events(int timeout, bool yield)
 	}
 /* 3 possible timeouts: exit directly, wait indefinitely, wait for fixed period */
 	while (timeout != -1 && get_pending(true) &&
+		(!first || count_pending(true) >= in_flight) &&
 		(!timeout || (timeout && arcan_timemillis() - start < timeout)));
 }
 
@@ -3586,7 +3601,7 @@ void platform_video_synch(uint64_t tick_count, float fract,
 	int i = 0;
 	struct dispout* d;
 	while (egl_dri.destroy_pending){
-		flush_display_events(30, true);
+		flush_display_events(30, true, false);
 		int ind = ffsll(egl_dri.destroy_pending) - 1;
 		debug_print("synch, %d - destroy %d", ind);
 		disable_display(&displays[ind], true);
@@ -3597,7 +3612,7 @@ void platform_video_synch(uint64_t tick_count, float fract,
  * even though it has finished by now. If we don't flush those out, they will
  * skip updating one frame, so do a quick no-yield flush first */
 	if (get_pending(false))
-		flush_display_events(-1, false);
+		flush_display_events(-1, false, false);
 
 	size_t nd;
 	uint32_t cost_ms = arcan_vint_refresh(fract, &nd);
@@ -3633,7 +3648,7 @@ void platform_video_synch(uint64_t tick_count, float fract,
  * signal.
  */
 		if (get_pending(false) || updated)
-			flush_display_events(clocked ? 16 : 0, true);
+			flush_display_events(clocked ? 16 : 0, true, true);
 	}
 /*
  * If there are no updates, just 'fake' synch to the display with the lowest
@@ -3699,7 +3714,7 @@ void platform_video_shutdown()
 			disable_display(&displays[i], true);
 			debug_print("shutdown (%zu) took %d ms", i, (int)(arcan_timemillis() - start));
 		}
-		flush_display_events(30, false);
+		flush_display_events(30, false, false);
 	} while (egl_dri.destroy_pending && rc-- > 0);
 
 	for (size_t i = 0; i < sizeof(nodes)/sizeof(nodes[0]); i++)
@@ -4142,6 +4157,7 @@ static enum display_update_state draw_display(struct dispout* d)
 		if (!drmModePageFlip(d->device->fd, d->display.crtc,
 			next_fb, DRM_MODE_PAGE_FLIP_EVENT, d)){
 			d->buffer.in_flip = 1;
+			arcan_conductor_display_pending(d->device->card_id, d->id, true);
 			verbose_print("(%d) in flip", (int)d->id);
 		}
 		else {
@@ -4168,7 +4184,7 @@ void platform_video_prepare_external()
 		for(size_t i = 0; i < MAX_DISPLAYS; i++)
 			disable_display(&displays[i], false);
 		if (egl_dri.destroy_pending)
-			flush_display_events(30, false);
+			flush_display_events(30, false, false);
 	} while(egl_dri.destroy_pending && rc-- > 0);
 
 	if (nodes[0].master)
@@ -728,6 +728,25 @@ void platform_event_process(struct arcan_evctx* ctx)
 
 }
 
+ssize_t platform_event_pollset(int* dst, size_t lim)
+{
+/* devices that are waiting to be opened are retried on a timer */
+	if (gstate.pending)
+		return -1;
+
+	size_t count = 0;
+	if (-1 != gstate.notify && count < lim)
+		dst[count++] = gstate.notify;
+
+/* same layout as in process, input nodes followed by their led nodes */
+	for (size_t i = 0; i < iodev.sz_nodes * 2 && count < lim; i++){
+		if (iodev.pollset[i].fd != -1 && iodev.pollset[i].events)
+			dst[count++] = iodev.pollset[i].fd;
+	}
+
+	return count;
+}
+
 void platform_event_samplebase(int devid, float xyz[3])
 {
 	struct devnode* node = lookup_devnode(devid);
@@ -87,6 +87,14 @@ void platform_event_samplebase(int devid, float xyz[3]);
  */
 void platform_event_process(struct arcan_evctx* ctx);
 
+/*
+ * Write up to [lim] descriptors into [dst] that will be signalled when there
+ * is new input for platform_event_process to consume. This lets the conductor
+ * sleep until there is something to do. Returns the number of descriptors, or
+ * -1 if the platform can't be multiplexed and needs to be stepped regularly.
+ */
+ssize_t platform_event_pollset(int* dst, size_t lim);
+
 /*
  * Return a list of possible input device types
  */
@@ -592,6 +592,11 @@ void platform_event_process(arcan_evctx* ctx)
 	}
 }
 
+ssize_t platform_event_pollset(int* dst, size_t lim)
+{
+	return -1;
+}
+
 void platform_event_samplebase(int devid, float xyz[3])
 {
 /* for mouse dev, run ioctl on the console with struct mouse_info,
@@ -55,6 +55,14 @@ struct arcan_frameserver* platform_fsrv_spawn_server(
  */
 int platform_fsrv_resynch(struct arcan_frameserver* src);
 
+/*
+ * Mark the video (or audio) buffers as consumed and wake the client, using
+ * whichever primitive (futex or semaphore) that has been negotiated through
+ * the page, see shmif_synch_mask in shmif/arcan_shmif_control.h.
+ */
+void platform_fsrv_release_video(struct arcan_frameserver* src);
+void platform_fsrv_release_audio(struct arcan_frameserver* src);
+
 /*
  * Allocate a new frameserver segment, bind it to the same process
  * and communicate the necessary IPC arguments (key etc.) using
@@ -97,6 +105,13 @@ int platform_fsrv_socketauth(struct arcan_frameserver* src);
 void platform_fsrv_enter(struct arcan_frameserver*, jmp_buf ctx);
 void platform_fsrv_leave();
 
+/*
+ * Same as _enter, but for threads other than the render thread: a fault only
+ * jumps to [ctx] and the shared resources are left for the caller to drop
+ * (platform_fsrv_dropshared) from the render thread.
+ */
+void platform_fsrv_enter_deferred(struct arcan_frameserver*, jmp_buf ctx);
+
 /*
  * disconnect, clean up resources, free. The connection should be considered
  * alive (not just _alloc call) or it will return false. State of *src is
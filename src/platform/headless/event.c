@@ -49,6 +49,11 @@ void platform_event_process(arcan_evctx* ctx)
 	headless_flush_encode_events();
 }
 
+ssize_t platform_event_pollset(int* dst, size_t lim)
+{
+	return 0;
+}
+
 void platform_event_keyrepeat(arcan_evctx* ctx, int* rate, int* del)
 {
 }
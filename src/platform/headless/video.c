@@ -5,7 +5,8 @@
  * Description: The headless platform video implementation, uses egl in a
  * displayless configuration to allow local processing for testing,
  * verification and so on, with the option of exposing the default output via
- * the encode frameserver.
+ * the encode frameserver. When built with the software AGP (AGP_SOFT), no
+ * GPU, render node or EGL is needed at all.
  */
 
 /*
@@ -38,6 +39,7 @@
 
 #include "../platform.h"
 
+#ifndef AGP_SOFT
 #define EGL_EGLEXT_PROTOTYPES
 #define GL_GLEXT_PROTOTYPES
 #define MESA_EGL_NO_X11_HEADERS
@@ -48,6 +50,7 @@
 #include <drm_fourcc.h>
 #include <xf86drm.h>
 #include <gbm.h>
+#endif
 
 static struct {
 	size_t width;
@@ -61,6 +64,7 @@ static struct {
 		bool block;
 	} encode;
 
+#ifndef AGP_SOFT
 	struct {
 		EGLDisplay disp;
 		EGLContext ctx;
@@ -69,6 +73,7 @@ static struct {
 		EGLNativeWindowType wnd;
 		struct gbm_device* gbmdev;
 	} egl;
+#endif
 
 	struct agp_vstore* vstore;
 } global = {
@@ -537,6 +542,26 @@ bool platform_video_init(uint16_t width,
 	if (!global.height)
 		global.height = 480;
 
+	uintptr_t tag;
+	cfg_lookup_fun get_config = platform_config_lookup(&tag);
+
+/*
+ * Default is ~75Hz (no real need to be very precise, but % logic clock) Then
+ * let user override. This will only be effective if we don't tie the output to
+ * the encode/remoting stage.
+ */
+	char* node;
+	if (get_config("video_refresh", 0, &node, tag)){
+		float hz = strtoul("node", NULL, 10);
+		if (hz)
+			global.deadline = 1.0 / hz;
+		free(node);
+	}
+
+/* the software rasterizer has no context to setup */
+#ifdef AGP_SOFT
+	return true;
+#else
 	const EGLint attribs[] = {
 		EGL_SURFACE_TYPE, EGL_WINDOW_BIT,
 		EGL_RENDERABLE_TYPE, EGL_OPENGL_BIT,
@@ -572,9 +597,6 @@ bool platform_video_init(uint16_t width,
 		(PFNEGLGETPLATFORMDISPLAYEXTPROC)
 		eglGetProcAddress("eglGetPlatformDisplayEXT");
 
-	uintptr_t tag;
-	cfg_lookup_fun get_config = platform_config_lookup(&tag);
-
 /* this is not right for nvidia, and would possibly pick nouveau even in the
  * presence of the binary driver, we have the same issue with streams */
 	if (!get_config("video_disable_platform", 0, NULL, tag) && get_platform_display){
@@ -625,19 +647,6 @@ bool platform_video_init(uint16_t width,
 		return false;
 	}
 
-/*
- * Default is ~75Hz (no real need to be very precise, but % logic clock) Then
- * let user override. This will only be effective if we don't tie the output to
- * the encode/remoting stage.
- */
-	char* node;
-	if (get_config("video_refresh", 0, &node, tag)){
-		float hz = strtoul("node", NULL, 10);
-		if (hz)
-			global.deadline = 1.0 / hz;
-		free(node);
-	}
-
 	EGLint cas[] = {
 		EGL_CONTEXT_CLIENT_VERSION, 2,
 		EGL_NONE, EGL_NONE,
@@ -671,4 +680,5 @@ bool platform_video_init(uint16_t width,
 		global.egl.disp, EGL_NO_SURFACE, EGL_NO_SURFACE, global.egl.ctx);
 
 	return true;
+#endif
 }
@@ -278,6 +278,11 @@ void platform_event_process(arcan_evctx* ctx)
 	}
 }
 
+ssize_t platform_event_pollset(int* dst, size_t lim)
+{
+	return -1;
+}
+
 void platform_event_keyrepeat(arcan_evctx* ctx, int* period, int* delay)
 {
 	bool upd = false;
@@ -7,6 +7,11 @@
  */
 unsigned long long arcan_timemillis();
 
+/*
+ * Same clock as arcan_timemillis, but in microseconds. Used for tracing.
+ */
+unsigned long long arcan_timemicros();
+
 /*
  * Execute and wait- for completion for the specified target.  This will shut
  * down as much engine- locked resources as possible while still possible to
@@ -30,6 +35,14 @@ int arcan_sem_trywait(sem_handle sem);
 int arcan_sem_init(sem_handle*, unsigned value);
 int arcan_sem_destroy(sem_handle);
 
+/*
+ * Cross-process wait/wake on a 32-bit word, wait returns when [addr] no
+ * longer holds [val] or on wake. Both return -1 (ENOSYS) on platforms
+ * without futexes.
+ */
+int arcan_futex_wait(volatile _Atomic unsigned* addr, unsigned val);
+int arcan_futex_wake(volatile _Atomic unsigned* addr);
+
 /*
  * Launch the specified program and bind its resources and control to the
  * returned frameserver instance (NULL if spawn was not possible for some
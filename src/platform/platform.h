@@ -25,6 +25,11 @@
  */
 unsigned long long arcan_timemillis();
 
+/*
+ * Same clock as arcan_timemillis, but in microseconds. Used for tracing.
+ */
+unsigned long long arcan_timemicros();
+
 /*
  * Both these functions expect [argv / envv] to be modifiable and their
  * internal contents dynamically allocated (hence will possible replace / free
@@ -31,8 +31,9 @@ typedef int arcan_aobj_id;
 
 typedef VIDEO_PIXEL_TYPE av_pixel;
 
-/* GLES2/3 typically, doesn't support BGRA formats */
-#ifndef OPENGL
+/* GLES2/3 typically, doesn't support BGRA formats, the software rasterizer
+ * uses the same packing as shmif so that client buffers can be copied as-is */
+#if !defined(OPENGL) && !defined(AGP_SOFT)
 #ifndef RGBA
 #define RGBA(r, g, b, a)(\
 ((uint32_t) (a) << 24) |\
@@ -228,10 +228,8 @@ if (shmpage){
 			arcan_sem_post( src->esync );
 		}
 
-		shmpage->vready = false;
-		shmpage->aready = false;
-		arcan_sem_post( src->vsync );
-		arcan_sem_post( src->async );
+		platform_fsrv_release_video(src);
+		platform_fsrv_release_audio(src);
 	}
 
 /* if BUS happens during _enter, the handler will take
@@ -690,6 +688,9 @@ fail:
 		shmpage->cookie = arcan_shmif_cookie();
 		shmpage->vpending = 1;
 		shmpage->apending = 1;
+#ifdef __linux__
+		shmpage->cursor_state = SHMIF_SYNCH_FUTEX_PARENT;
+#endif
 		ctx->shm.ptr = shmpage;
 	platform_fsrv_leave(ctx);
 
@@ -1201,6 +1202,30 @@ size_t platform_fsrv_display_limit(size_t new_sz)
 	return res;
 }
 
+static void release_word(struct arcan_frameserver* src,
+	volatile atomic_uint* word, sem_handle sem)
+{
+/* clear before checking the negotiation bit, the client does the opposite */
+	atomic_store(word, 0);
+
+	if (atomic_load(&src->shm.ptr->cursor_state) & SHMIF_SYNCH_FUTEX_CHILD)
+		arcan_futex_wake(word);
+	else
+		arcan_sem_post(sem);
+}
+
+void platform_fsrv_release_video(struct arcan_frameserver* src)
+{
+	if (src->shm.ptr)
+		release_word(src, &src->shm.ptr->vready, src->vsync);
+}
+
+void platform_fsrv_release_audio(struct arcan_frameserver* src)
+{
+	if (src->shm.ptr)
+		release_word(src, &src->shm.ptr->aready, src->async);
+}
+
 int platform_fsrv_resynch(struct arcan_frameserver* s)
 {
 	int state = 0;
@@ -37,8 +37,11 @@
 #include <arcan_audio.h>
 #include <arcan_frameserver.h>
 
-static struct arcan_frameserver* tag;
-static sigjmp_buf recover;
+/* per thread as the conductor can copy from shared memory in workers,
+ * SIGBUS is delivered to the faulting thread */
+static _Thread_local struct arcan_frameserver* tag;
+static _Thread_local sigjmp_buf recover;
+static _Thread_local bool defer_drop;
 
 static void bus_handler(int signo)
 {
@@ -48,7 +51,7 @@ static void bus_handler(int signo)
 	siglongjmp(recover, 1);
 }
 
-void platform_fsrv_enter(struct arcan_frameserver* m, jmp_buf out)
+static void install_handler()
 {
 	static bool initialized;
 
@@ -57,18 +60,32 @@ void platform_fsrv_enter(struct arcan_frameserver* m, jmp_buf out)
 		if (signal(SIGBUS, bus_handler) == SIG_ERR)
 			arcan_warning("(posix/fsrv_guard) can't install sigbus handler.\n");
 		}
+}
+
+void platform_fsrv_enter(struct arcan_frameserver* m, jmp_buf out)
+{
+	install_handler();
 
 	if (sigsetjmp(recover, 1)){
 		arcan_warning("(posix/fsrv_guard) DoS attempt from client.\n");
-		platform_fsrv_dropshared(tag);
+		if (!defer_drop)
+			platform_fsrv_dropshared(tag);
 		tag = NULL;
 		longjmp(out, -1);
 	}
 
+	defer_drop = false;
 	tag = m;
 }
 
+void platform_fsrv_enter_deferred(struct arcan_frameserver* m, jmp_buf out)
+{
+	platform_fsrv_enter(m, out);
+	defer_drop = true;
+}
+
 void platform_fsrv_leave()
 {
 	tag = NULL;
+	defer_drop = false;
 }
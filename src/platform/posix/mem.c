@@ -5,9 +5,12 @@
  */
 
 /*
- * This is mostly a stub implementation still, serious attempts
- * at getting a strong and efficient implementation is slated for
- * 0.8-0.9.
+ * Only a few of the pool behaviors described below are implemented:
+ * small VSTRUCT blocks come from size-class slabs and large page-aligned
+ * VBUFFER blocks are recycled by size, everything else is still a thin
+ * wrapper around malloc/posix_memalign. Note that arcan_mem_free is also
+ * used on memory that never came from here (strdup etc.) so anything not
+ * found in the pools is passed on to free().
  */
 
 #include <stdlib.h>
@@ -15,8 +18,10 @@
 #include <string.h>
 #include <stdint.h>
 #include <stdbool.h>
+#include <stdatomic.h>
 #include <signal.h>
 #include <unistd.h>
+#include <pthread.h>
 
 #include <sys/mman.h>
 
@@ -38,15 +43,95 @@
 #define REALLOC_STEP 16
 #endif
 
+/* VSTRUCT allocations up to the largest class are carved out of slabs */
+#ifndef SLAB_SIZE
+#define SLAB_SIZE (64 * 1024)
+#endif
+
+/* page aligned VBUFFER allocations from this size and up are recycled */
+#ifndef VBUFFER_POOL_MIN
+#define VBUFFER_POOL_MIN (64 * 1024)
+#endif
+
+/* upper bound of freed VBUFFER bytes kept around for reuse */
+#ifndef VBUFFER_POOL_LIMIT
+#define VBUFFER_POOL_LIMIT (64 * 1024 * 1024)
+#endif
+
+/* number of arcan_mem_tick calls before an unused buffer is released */
+#ifndef VBUFFER_POOL_AGE
+#define VBUFFER_POOL_AGE 250
+#endif
+
 struct mempool_meta {
 /*	mempool_hook_t alloc;
 	  mempool_hook_t free; */
 
-	size_t alloc_cnt;
-	size_t dealloc_cnt;
-	size_t in_use;
+/* counters are updated outside of pool.lock, they are statistics only so
+ * relaxed ordering is enough */
+	atomic_size_t alloc_cnt;
+	atomic_size_t dealloc_cnt;
+	atomic_size_t in_use;
 	size_t monitor_sz;
-	size_t n_pages;
+	atomic_size_t n_pages;
+};
+
+#define STAT_ADD(F, V) atomic_fetch_add_explicit(&(F), (V), memory_order_relaxed)
+#define STAT_SUB(F, V) atomic_fetch_sub_explicit(&(F), (V), memory_order_relaxed)
+#define STAT_GET(F) atomic_load_explicit(&(F), memory_order_relaxed)
+
+static const size_t slab_classes[] = {
+	16, 32, 48, 64, 96, 128, 192, 256, 384, 512
+};
+#define SLAB_CLASSES (sizeof(slab_classes) / sizeof(slab_classes[0]))
+#define SLAB_BUCKETS 256
+
+struct slab {
+	uint8_t* base;
+	size_t cls;
+	size_t n_blocks, n_free;
+
+/* blocks that have been freed are chained through their first bytes,
+ * [bump] is the first block that has never been handed out */
+	void* freelist;
+	size_t bump;
+
+/* slabs with free blocks per class, and the address lookup chain */
+	struct slab* prev, (* next);
+	struct slab* hnext;
+};
+
+/* VBUFFER blocks, either live (in [live]) or waiting for reuse (in [idle]) */
+#define VBUFFER_BUCKETS 256
+
+struct vbuffer {
+	void* ptr;
+	size_t sz;
+	uint64_t stamp;
+	struct vbuffer* next;
+};
+
+static struct {
+	pthread_mutex_t lock;
+	struct mempool_meta meta[ARCAN_MEM_ENDMARKER];
+
+	struct slab* avail[SLAB_CLASSES];
+	size_t empty[SLAB_CLASSES];
+	struct slab* slabs[SLAB_BUCKETS];
+
+	struct vbuffer* live[VBUFFER_BUCKETS];
+	struct vbuffer* idle[VBUFFER_BUCKETS];
+
+/* entries in each slabs[] / live[] chain, modified with the lock held but
+ * read without it so that freeing memory that never came from a pool (the
+ * common case) can skip the lock and the chain walks altogether */
+	atomic_size_t n_slabs[SLAB_BUCKETS];
+	atomic_size_t n_live[VBUFFER_BUCKETS];
+
+	size_t idle_sz;
+	uint64_t tick;
+} pool = {
+	.lock = PTHREAD_MUTEX_INITIALIZER
 };
 
 /* pool behaviors:
@@ -122,8 +207,252 @@ void arcan_mem_init()
  * TEMPORARY or SENSITIVE (NON VIDEO/AUDIO) alive at this
  * point, use the tick point to check and trap as leaks.
  */
+static void vbuffer_sweep(bool all);
+
 void arcan_mem_tick()
 {
+	pthread_mutex_lock(&pool.lock);
+	pool.tick++;
+	if (pool.idle_sz && (pool.tick % 32) == 0)
+		vbuffer_sweep(false);
+	pthread_mutex_unlock(&pool.lock);
+}
+
+static size_t slab_bucket(const void* base)
+{
+	return ((uintptr_t) base / SLAB_SIZE) % SLAB_BUCKETS;
+}
+
+static void slab_unlink(struct slab* slab)
+{
+	if (slab->prev)
+		slab->prev->next = slab->next;
+	else
+		pool.avail[slab->cls] = slab->next;
+
+	if (slab->next)
+		slab->next->prev = slab->prev;
+
+	slab->prev = slab->next = NULL;
+}
+
+static void slab_link(struct slab* slab)
+{
+	slab->prev = NULL;
+	slab->next = pool.avail[slab->cls];
+	if (slab->next)
+		slab->next->prev = slab;
+	pool.avail[slab->cls] = slab;
+}
+
+/* needs pool.lock */
+static void* slab_alloc(size_t cls)
+{
+	struct slab* slab = pool.avail[cls];
+
+	if (!slab){
+		slab = malloc(sizeof(struct slab));
+		if (!slab)
+			return NULL;
+
+		void* base;
+		if (0 != posix_memalign(&base, SLAB_SIZE, SLAB_SIZE)){
+			free(slab);
+			return NULL;
+		}
+
+		*slab = (struct slab){
+			.base = base,
+			.cls = cls,
+			.n_blocks = SLAB_SIZE / slab_classes[cls],
+			.n_free = SLAB_SIZE / slab_classes[cls]
+		};
+
+		size_t ind = slab_bucket(base);
+		slab->hnext = pool.slabs[ind];
+		pool.slabs[ind] = slab;
+		STAT_ADD(pool.n_slabs[ind], 1);
+		slab_link(slab);
+		STAT_ADD(pool.meta[ARCAN_MEM_VSTRUCT].n_pages, SLAB_SIZE / system_page_size);
+	}
+	else if (slab->n_free == slab->n_blocks)
+		pool.empty[cls]--;
+
+	void* rv;
+	if (slab->freelist){
+		rv = slab->freelist;
+		slab->freelist = *(void**) rv;
+	}
+	else
+		rv = slab->base + slab_classes[cls] * slab->bump++;
+
+	if (0 == --slab->n_free)
+		slab_unlink(slab);
+
+	return rv;
+}
+
+/* needs pool.lock, returns the slab that owns [ptr] or NULL */
+static struct slab* slab_find(void* ptr)
+{
+	uint8_t* base = (uint8_t*)((uintptr_t) ptr & ~((uintptr_t) SLAB_SIZE - 1));
+	struct slab* slab = pool.slabs[slab_bucket(base)];
+	while (slab && slab->base != base)
+		slab = slab->hnext;
+	return slab;
+}
+
+/* needs pool.lock */
+static void slab_free(struct slab* slab, void* ptr)
+{
+	*(void**) ptr = slab->freelist;
+	slab->freelist = ptr;
+
+	if (0 == slab->n_free++)
+		slab_link(slab);
+
+	if (slab->n_free != slab->n_blocks)
+		return;
+
+/* keep one empty slab per class around to avoid thrashing at the edge */
+	if (!pool.empty[slab->cls]){
+		pool.empty[slab->cls]++;
+		return;
+	}
+
+	slab_unlink(slab);
+	size_t ind = slab_bucket(slab->base);
+	struct slab** cur = &pool.slabs[ind];
+	while (*cur != slab)
+		cur = &(*cur)->hnext;
+	*cur = slab->hnext;
+	STAT_SUB(pool.n_slabs[ind], 1);
+
+	STAT_SUB(pool.meta[ARCAN_MEM_VSTRUCT].n_pages, SLAB_SIZE / system_page_size);
+	free(slab->base);
+	free(slab);
+}
+
+static size_t vbuffer_bucket(uintptr_t key)
+{
+	return (key ^ (key >> 12) ^ (key >> 20)) % VBUFFER_BUCKETS;
+}
+
+/* needs pool.lock, detach an idle buffer of exactly [sz] bytes */
+static struct vbuffer* vbuffer_reuse(size_t sz)
+{
+	struct vbuffer** cur = &pool.idle[vbuffer_bucket(sz)];
+	while (*cur && (*cur)->sz != sz)
+		cur = &(*cur)->next;
+
+	struct vbuffer* vb = *cur;
+	if (vb){
+		*cur = vb->next;
+		pool.idle_sz -= sz;
+		STAT_SUB(pool.meta[ARCAN_MEM_VBUFFER].n_pages, sz / system_page_size);
+	}
+
+	return vb;
+}
+
+/* needs pool.lock, detach the live entry for [ptr] */
+static struct vbuffer* vbuffer_find(void* ptr)
+{
+	size_t ind = vbuffer_bucket((uintptr_t) ptr);
+	struct vbuffer** cur = &pool.live[ind];
+	while (*cur && (*cur)->ptr != ptr)
+		cur = &(*cur)->next;
+
+	struct vbuffer* vb = *cur;
+	if (vb){
+		*cur = vb->next;
+		STAT_SUB(pool.n_live[ind], 1);
+	}
+
+	return vb;
+}
+
+/* needs pool.lock, release idle buffers that have aged out (or all) */
+static void vbuffer_sweep(bool all)
+{
+	for (size_t i = 0; i < VBUFFER_BUCKETS; i++){
+		struct vbuffer** cur = &pool.idle[i];
+		while (*cur){
+			struct vbuffer* vb = *cur;
+			if (!all && pool.tick - vb->stamp < VBUFFER_POOL_AGE){
+				cur = &vb->next;
+				continue;
+			}
+
+			*cur = vb->next;
+			pool.idle_sz -= vb->sz;
+			STAT_SUB(pool.meta[ARCAN_MEM_VBUFFER].n_pages, vb->sz / system_page_size);
+			free(vb->ptr);
+			free(vb);
+		}
+	}
+}
+
+/* needs pool.lock */
+static void* vbuffer_alloc(size_t sz)
+{
+	struct vbuffer* vb = vbuffer_reuse(sz);
+
+	if (!vb){
+		vb = malloc(sizeof(struct vbuffer));
+		if (!vb)
+			return NULL;
+
+		if (0 != posix_memalign(&vb->ptr, system_page_size, sz)){
+			free(vb);
+			return NULL;
+		}
+		vb->sz = sz;
+	}
+
+	size_t ind = vbuffer_bucket((uintptr_t) vb->ptr);
+	vb->next = pool.live[ind];
+	pool.live[ind] = vb;
+	STAT_ADD(pool.n_live[ind], 1);
+	return vb->ptr;
+}
+
+/* needs pool.lock */
+static void vbuffer_free(struct vbuffer* vb)
+{
+	if (vb->sz > VBUFFER_POOL_LIMIT / 4){
+		free(vb->ptr);
+		free(vb);
+		return;
+	}
+
+/* make room by dropping the oldest idle buffers first */
+	if (pool.idle_sz + vb->sz > VBUFFER_POOL_LIMIT){
+		vbuffer_sweep(false);
+		if (pool.idle_sz + vb->sz > VBUFFER_POOL_LIMIT)
+			vbuffer_sweep(true);
+	}
+
+	vb->stamp = pool.tick;
+	size_t ind = vbuffer_bucket(vb->sz);
+	vb->next = pool.idle[ind];
+	pool.idle[ind] = vb;
+	pool.idle_sz += vb->sz;
+	STAT_ADD(pool.meta[ARCAN_MEM_VBUFFER].n_pages, vb->sz / system_page_size);
+}
+
+bool arcan_mem_stat(enum arcan_memtypes type, struct arcan_memstat* dst)
+{
+	if (type >= ARCAN_MEM_ENDMARKER || !dst)
+		return false;
+
+	*dst = (struct arcan_memstat){
+		.alloc_cnt = STAT_GET(pool.meta[type].alloc_cnt),
+		.dealloc_cnt = STAT_GET(pool.meta[type].dealloc_cnt),
+		.in_use = STAT_GET(pool.meta[type].in_use),
+		.pooled = STAT_GET(pool.meta[type].n_pages) * system_page_size
+	};
+	return true;
 }
 
 /*static void sigsegv_hand(int sig, siginfo_t* si, void* unused)
@@ -169,6 +498,41 @@ void* arcan_alloc_mem(size_t nb,
 
 		total = header_sz + footer_sz + padding_sz + nb;
 
+/* size-class slabs / buffer recycling, see the notes on top */
+		if (type == ARCAN_MEM_VSTRUCT &&
+			align != ARCAN_MEMALIGN_PAGE && total <= slab_classes[SLAB_CLASSES-1]){
+			size_t cls = 0;
+			while (slab_classes[cls] < total)
+				cls++;
+
+			pthread_mutex_lock(&pool.lock);
+			rptr = slab_alloc(cls);
+			pthread_mutex_unlock(&pool.lock);
+
+			if (rptr){
+				STAT_ADD(pool.meta[type].alloc_cnt, 1);
+				STAT_ADD(pool.meta[type].in_use, slab_classes[cls]);
+			}
+			break;
+		}
+
+		if (type == ARCAN_MEM_VBUFFER &&
+			align == ARCAN_MEMALIGN_PAGE && total >= VBUFFER_POOL_MIN){
+			total = (total + system_page_size - 1) & ~((size_t)system_page_size - 1);
+
+			pthread_mutex_lock(&pool.lock);
+			rptr = vbuffer_alloc(total);
+			pthread_mutex_unlock(&pool.lock);
+
+			if (rptr){
+				STAT_ADD(pool.meta[type].alloc_cnt, 1);
+				STAT_ADD(pool.meta[type].in_use, total);
+			}
+			break;
+		}
+
+		STAT_ADD(pool.meta[type].alloc_cnt, 1);
+
 		switch(align){
 		case ARCAN_MEMALIGN_NATURAL:
 			rptr = malloc(total);
@@ -288,8 +652,44 @@ void arcan_mem_free(void* inptr)
  * then cleanup. VBUFFER for instance doesn't
  * automatically shrink, but rather reset and flag
  * as unused */
+	if (!inptr)
+		return;
+
+/* a block from a pool keeps its chain non-empty until it is freed, and the
+ * caller owning it means that insertion is visible here, so an empty chain
+ * can be trusted without the lock */
+	uintptr_t sbase = (uintptr_t) inptr & ~((uintptr_t) SLAB_SIZE - 1);
+	bool in_slab = STAT_GET(pool.n_slabs[slab_bucket((void*) sbase)]) > 0;
+	bool in_live = STAT_GET(pool.n_live[vbuffer_bucket((uintptr_t) inptr)]) > 0;
+
+	if (!in_slab && !in_live){
+		free(inptr);
+		return;
+	}
+
+	pthread_mutex_lock(&pool.lock);
 
+	struct slab* slab = in_slab ? slab_find(inptr) : NULL;
+	if (slab){
+		size_t sz = slab_classes[slab->cls];
+		slab_free(slab, inptr);
+		pthread_mutex_unlock(&pool.lock);
+		STAT_ADD(pool.meta[ARCAN_MEM_VSTRUCT].dealloc_cnt, 1);
+		STAT_SUB(pool.meta[ARCAN_MEM_VSTRUCT].in_use, sz);
+		return;
+	}
+
+	struct vbuffer* vb = in_live ? vbuffer_find(inptr) : NULL;
+	if (vb){
+		size_t sz = vb->sz;
+		vbuffer_free(vb);
+		pthread_mutex_unlock(&pool.lock);
+		STAT_ADD(pool.meta[ARCAN_MEM_VBUFFER].dealloc_cnt, 1);
+		STAT_SUB(pool.meta[ARCAN_MEM_VBUFFER].in_use, sz);
+		return;
+	}
 
+	pthread_mutex_unlock(&pool.lock);
 	free(inptr);
 }
 
@@ -8,6 +8,12 @@
 #include <time.h>
 #include <sys/types.h>
 #include <unistd.h>
+#include <limits.h>
+
+#ifdef __linux__
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#endif
 
 #ifndef PLATFORM_HEADER
 #include "arcan_shmif.h"
@@ -47,3 +53,26 @@ int arcan_sem_destroy(sem_handle sem)
 {
 	return sem_destroy(sem);
 }
+
+/*
+ * The futex words are shared between processes, so no _PRIVATE variants.
+ */
+int arcan_futex_wait(volatile _Atomic unsigned* addr, unsigned val)
+{
+#ifdef __linux__
+	return syscall(SYS_futex, addr, FUTEX_WAIT, val, NULL, NULL, 0);
+#else
+	errno = ENOSYS;
+	return -1;
+#endif
+}
+
+int arcan_futex_wake(volatile _Atomic unsigned* addr)
+{
+#ifdef __linux__
+	return syscall(SYS_futex, addr, FUTEX_WAKE, INT_MAX, NULL, NULL, 0);
+#else
+	errno = ENOSYS;
+	return -1;
+#endif
+}
@@ -598,6 +598,12 @@ void platform_event_process(arcan_evctx* ctx)
 	}
 }
 
+/* SDL owns the event loop and its descriptors */
+ssize_t platform_event_pollset(int* dst, size_t lim)
+{
+	return -1;
+}
+
 /* just separate chain on hid until no collision */
 static unsigned gen_devid(unsigned hid)
 {
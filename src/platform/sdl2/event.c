@@ -693,6 +693,12 @@ SDL_SetModState(KMOD_NONE);
 	}
 }
 
+/* SDL owns the event loop and its descriptors */
+ssize_t platform_event_pollset(int* dst, size_t lim)
+{
+	return -1;
+}
+
 /* just separate chain on hid until no collision */
 static unsigned gen_devid(unsigned hid)
 {
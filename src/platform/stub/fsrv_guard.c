@@ -8,6 +8,11 @@ int platform_fsrv_enter(struct arcan_frameserver* m)
 	return 1;
 }
 
+int platform_fsrv_enter_deferred(struct arcan_frameserver* m)
+{
+	return 1;
+}
+
 void platform_fsrv_leave()
 {
 }
@@ -34,6 +34,11 @@ void arcan_mem_tick()
 {
 }
 
+bool arcan_mem_stat(enum arcan_memtypes type, struct arcan_memstat* dst)
+{
+	return false;
+}
+
 void arcan_mem_growarr(struct arcan_strarr* res)
 {
 /* _alloc functions lacks a grow at the moment,
@@ -1274,9 +1274,17 @@ static void* guard_thread(void* gs)
 		if (!parent_alive(gstr)){
 			volatile uint8_t* dms;
 			pthread_mutex_lock(&gstr->guard.synch);
-			if ((dms = atomic_load(&gstr->guard.dms)))
+			if ((dms = atomic_load(&gstr->guard.dms))){
 				*dms = false;
 
+/* dms always points into the page, and futex- waiters need a wakeup on the
+ * words themselves to notice */
+				struct arcan_shmif_page* page = (struct arcan_shmif_page*)
+					((uintptr_t) dms - offsetof(struct arcan_shmif_page, dms));
+				arcan_futex_wake(&page->vready);
+				arcan_futex_wake(&page->aready);
+			}
+
 			for (size_t i = 0; i < COUNT_OF(gstr->guard.semset); i++){
 				if (gstr->guard.semset[i])
 					arcan_sem_post(gstr->guard.semset[i]);
@@ -1381,6 +1389,49 @@ unsigned arcan_shmif_signalhandle(struct arcan_shmif_cont* ctx,
 	return arcan_shmif_signal(ctx, mask);
 }
 
+/*
+ * Check (and acknowledge) if the parent wakes us through the [vready, aready]
+ * words rather than through the semaphores, see shmif_synch_mask.
+ */
+static bool synch_futex(struct arcan_shmif_cont* ctx)
+{
+#ifdef __linux__
+	if (ctx->priv->output)
+		return false;
+
+	uint_least16_t state = atomic_load(&ctx->addr->cursor_state);
+	if (!(state & SHMIF_SYNCH_FUTEX_PARENT))
+		return false;
+
+/* the parent clears the word before checking this bit, so setting it before
+ * checking the word means that one of us will see the other */
+	if (!(state & SHMIF_SYNCH_FUTEX_CHILD))
+		atomic_fetch_or(&ctx->addr->cursor_state, SHMIF_SYNCH_FUTEX_CHILD);
+
+	return true;
+#else
+	return false;
+#endif
+}
+
+/*
+ * Block until the parent has released [word] or the dead man's switch has
+ * been pulled.
+ */
+static void synch_wait(struct arcan_shmif_cont* ctx,
+	volatile atomic_uint* word, sem_handle sem)
+{
+	if (synch_futex(ctx)){
+		unsigned cur;
+		while ((cur = atomic_load(word)) && ctx->addr->dms)
+			arcan_futex_wait(word, cur);
+		return;
+	}
+
+	while (atomic_load(word) && ctx->addr->dms)
+		arcan_sem_wait(sem);
+}
+
 static bool step_v(struct arcan_shmif_cont* ctx)
 {
 	struct shmif_hidden* priv = ctx->priv;
@@ -1481,8 +1532,8 @@ unsigned arcan_shmif_signal(struct arcan_shmif_cont* ctx,
 
 /* guard-thread will pull the sems for us on dms */
 		if (lock && !(mask & SHMIF_SIGBLK_NONE))
-			arcan_sem_wait(ctx->asem);
-		else
+			synch_wait(ctx, &ctx->addr->aready, ctx->asem);
+		else if (!synch_futex(ctx))
 			arcan_sem_trywait(ctx->asem);
 	}
 /* for sub-region multi-buffer synch, we currently need to
@@ -1497,16 +1548,14 @@ unsigned arcan_shmif_signal(struct arcan_shmif_cont* ctx,
 			);
 		}
 
-		while ((ctx->hints & SHMIF_RHINT_SUBREGION) && ctx->addr->vready)
-			arcan_sem_wait(ctx->vsem);
+		if (ctx->hints & SHMIF_RHINT_SUBREGION)
+			synch_wait(ctx, &ctx->addr->vready, ctx->vsem);
 
 		bool lock = step_v(ctx);
 
-		if (lock && !(mask & SHMIF_SIGBLK_NONE)){
-			while (ctx->addr->vready)
-				arcan_sem_wait(ctx->vsem);
-		}
-		else
+		if (lock && !(mask & SHMIF_SIGBLK_NONE))
+			synch_wait(ctx, &ctx->addr->vready, ctx->vsem);
+		else if (!synch_futex(ctx))
 			arcan_sem_trywait(ctx->vsem);
 	}
 
@@ -1614,14 +1663,8 @@ static bool shmif_resize(struct arcan_shmif_cont* arg,
 	}
 
 /* wait for any outstanding v/asynch */
-	if (atomic_load(&arg->addr->vready)){
-		while (atomic_load(&arg->addr->vready) && arg->addr->dms)
-			arcan_sem_wait(arg->vsem);
-	}
-	if (atomic_load(&arg->addr->aready)){
-		while (atomic_load(&arg->addr->aready) && arg->addr->dms)
-			arcan_sem_wait(arg->asem);
-	}
+	synch_wait(arg, &arg->addr->vready, arg->vsem);
+	synch_wait(arg, &arg->addr->aready, arg->asem);
 
 	width = width < 1 ? 1 : width;
 	height = height < 1 ? 1 : height;
@@ -2111,11 +2154,8 @@ enum shmif_migrate_status arcan_shmif_migrate(
 
 /* got a valid connection, first synch source segment so we don't have
  * anything pending */
-	while(atomic_load(&cont->addr->vready) && cont->addr->dms)
-		arcan_sem_wait(cont->vsem);
-
-	while(atomic_load(&cont->addr->aready) && cont->addr->dms)
-		arcan_sem_wait(cont->asem);
+	synch_wait(cont, &cont->addr->vready, cont->vsem);
+	synch_wait(cont, &cont->addr->aready, cont->asem);
 
 	size_t w = atomic_load(&cont->addr->w);
 	size_t h = atomic_load(&cont->addr->h);
@@ -821,6 +821,23 @@ enum rhint_mask {
 	SHMIF_RHINT_SUBREGION_CHAIN = 64
 };
 
+/*
+ * Negotiation of the primitive used to wait for [vready, aready] to be
+ * released, stored in the upper bits of [cursor_state] in the page so that
+ * the layout (and cookie) stays the same.
+ *
+ * The parent sets SHMIF_SYNCH_FUTEX_PARENT on segment creation if it can
+ * wake on the words directly. A client that can wait on them sets the
+ * SHMIF_SYNCH_FUTEX_CHILD bit, after which the parent stops posting the v/a
+ * semaphores on release. If either side lacks support, or for output
+ * segments, the semaphores are used. Resize acknowledgement and the event
+ * queue still use the semaphores.
+ */
+enum shmif_synch_mask {
+	SHMIF_SYNCH_FUTEX_PARENT = 0x8000,
+	SHMIF_SYNCH_FUTEX_CHILD = 0x4000
+};
+
 struct arcan_shmif_page;
 
 #ifndef ARCAN_SHMIF_HIDEPAGE
@@ -894,7 +911,8 @@ struct arcan_shmif_page {
  * event-driven and memory mapped model.
  *
  * The plan is to use cursor_state LSB to indicate mapped support,
- * and the rest of cursor_state as button bitmask.
+ * and the rest of cursor_state as button bitmask. The two MSBs are used
+ * for synchronization negotiation, see shmif_synch_mask.
  */
 	volatile _Atomic uint_least16_t cursor_state;
 	volatile _Atomic uint_least16_t cursor_x, cursor_y, cursor_rx, cursor_ry;
@@ -75,6 +75,8 @@ file_handle arcan_fetchhandle(int insock, bool block);
 bool arcan_pushhandle(int fd, int channel);
 int arcan_sem_wait(sem_handle sem);
 int arcan_sem_trywait(sem_handle sem);
+int arcan_futex_wait(volatile _Atomic unsigned* addr, unsigned val);
+int arcan_futex_wake(volatile _Atomic unsigned* addr);
 #endif
 
 struct arcan_shmif_cont;
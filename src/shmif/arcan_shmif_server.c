@@ -336,8 +336,7 @@ void shmifsrv_audio_step(struct shmifsrv_client* cl)
 void shmifsrv_video_step(struct shmifsrv_client* cl)
 {
 /* signal that we're done with the buffer */
-	atomic_store_explicit(&cl->con->shm.ptr->vready, 0, memory_order_release);
-	arcan_sem_post(cl->con->vsync);
+	platform_fsrv_release_video(cl->con);
 
 /* If the frameserver has indicated that it wants a frame callback every time
  * we consume. This is primarily for cases where a client needs to I/O mplex
@@ -466,8 +465,7 @@ void shmifsrv_audio(struct shmifsrv_client* cl,
 		~(1 << prev), memory_order_release);
 */
 
-	atomic_store_explicit(&cl->con->shm.ptr->aready, 0, memory_order_release);
-	arcan_sem_post(cl->con->async);
+	platform_fsrv_release_audio(cl->con);
 }
 
 bool shmifsrv_tick(struct shmifsrv_client* cl)
@@ -0,0 +1,145 @@
+/*
+ * Threaded stress test for the pooled allocator in platform/posix/mem.c,
+ * intended to be built with -fsanitize=address,undefined (the default in
+ * CMakeLists.txt here) or thread.
+ *
+ * Each worker keeps a set of live blocks and randomly allocates or frees
+ * them, mixing slab (small VSTRUCT), recycled (page aligned VBUFFER),
+ * plain (STRINGBUF) allocations and memory that never came from the pools
+ * (strdup) but is still released through arcan_mem_free. Blocks are filled
+ * with a per-slot pattern that is verified before being freed, so handing
+ * the same block out twice shows up as corruption even without sanitizers.
+ *
+ * usage: mempool [n_threads] [n_iterations]
+ */
+#include <stdlib.h>
+#include <stdio.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdarg.h>
+#include <string.h>
+#include <pthread.h>
+
+#include "arcan_math.h"
+#include "arcan_general.h"
+
+#define N_SLOTS 512
+
+void arcan_fatal(const char* msg, ...)
+{
+	va_list args;
+	va_start(args, msg);
+	vfprintf(stderr, msg, args);
+	va_end(args);
+	abort();
+}
+
+static void fail(const char* msg, size_t slot)
+{
+	fprintf(stderr, "slot %zu: %s\n", slot, msg);
+	abort();
+}
+
+static size_t n_iter = 50000;
+
+static void* worker(void* tag)
+{
+	unsigned seed = (uintptr_t) tag;
+	void* blocks[N_SLOTS] = {0};
+	size_t sizes[N_SLOTS] = {0};
+
+	for (size_t it = 0; it < n_iter; it++){
+		size_t i = rand_r(&seed) % N_SLOTS;
+
+		if (blocks[i]){
+			uint8_t* buf = blocks[i];
+			for (size_t j = 0; j < sizes[i]; j++)
+				if (buf[j] != (uint8_t) i)
+					fail("corrupted", i);
+
+			arcan_mem_free(blocks[i]);
+			blocks[i] = NULL;
+			continue;
+		}
+
+		switch (rand_r(&seed) % 4){
+		case 0:
+			sizes[i] = 1 + rand_r(&seed) % 600;
+			blocks[i] = arcan_alloc_mem(sizes[i],
+				ARCAN_MEM_VSTRUCT, ARCAN_MEM_BZERO, ARCAN_MEMALIGN_NATURAL);
+
+			for (size_t j = 0; j < sizes[i]; j++)
+				if (((uint8_t*)blocks[i])[j])
+					fail("not cleared", i);
+
+			if ((uintptr_t) blocks[i] % 16)
+				fail("misaligned (16)", i);
+		break;
+		case 1:
+			sizes[i] = 64 * 1024 * (1 + rand_r(&seed) % 4) + rand_r(&seed) % 300;
+			blocks[i] = arcan_alloc_mem(sizes[i],
+				ARCAN_MEM_VBUFFER, 0, ARCAN_MEMALIGN_PAGE);
+
+			if ((uintptr_t) blocks[i] % 4096)
+				fail("misaligned (page)", i);
+		break;
+		case 2:
+			blocks[i] = strdup("");
+			sizes[i] = 0;
+		break;
+		case 3:
+			sizes[i] = 1 + rand_r(&seed) % 2000;
+			blocks[i] = arcan_alloc_mem(sizes[i],
+				ARCAN_MEM_STRINGBUF, 0, ARCAN_MEMALIGN_NATURAL);
+		break;
+		}
+
+		memset(blocks[i], (uint8_t) i, sizes[i]);
+
+		if ((it % 1024) == 0)
+			arcan_mem_tick();
+	}
+
+	for (size_t i = 0; i < N_SLOTS; i++)
+		arcan_mem_free(blocks[i]);
+
+	return NULL;
+}
+
+int main(int argc, char** argv)
+{
+	size_t n_threads = argc > 1 ? strtoul(argv[1], NULL, 10) : 4;
+	if (argc > 2)
+		n_iter = strtoul(argv[2], NULL, 10);
+
+	if (!n_threads || n_threads > 64)
+		n_threads = 4;
+
+	pthread_t threads[64];
+	for (size_t i = 0; i < n_threads; i++)
+		pthread_create(&threads[i], NULL, worker, (void*)(uintptr_t)(i + 1));
+
+	for (size_t i = 0; i < n_threads; i++)
+		pthread_join(threads[i], NULL);
+
+/* every pooled block has been returned (dealloc_cnt only covers pooled
+ * blocks while alloc_cnt covers all, so only in_use has to balance) */
+	int rv = EXIT_SUCCESS;
+	enum arcan_memtypes types[] = {ARCAN_MEM_VSTRUCT, ARCAN_MEM_VBUFFER};
+
+	for (size_t i = 0; i < sizeof(types) / sizeof(types[0]); i++){
+		struct arcan_memstat st;
+		if (!arcan_mem_stat(types[i], &st))
+			continue;
+
+		printf("type %d: alloc %zu, dealloc %zu, in use %zu, pooled %zu\n",
+			(int) types[i], st.alloc_cnt, st.dealloc_cnt, st.in_use, st.pooled);
+
+		if (st.in_use != 0 || st.dealloc_cnt > st.alloc_cnt){
+			fprintf(stderr, "type %d: counters don't balance\n", (int) types[i]);
+			rv = EXIT_FAILURE;
+		}
+	}
+
+	return rv;
+}